@@ -1,4 +1,4 @@
-QT       += core xml gui
+QT       += core gui
 
 CONFIG += static
 Win32 {
@@ -87,6 +87,12 @@ SOURCES += \
     observer/GUI/settingswindow.cpp \
     visitor/graphtheoryvisitors/hamcyclevisitor.cpp \
     visitor/graphtheoryvisitors/hampathvisitor.cpp \
+    visitor/graphtheoryvisitors/hamiltoniansolver.cpp \
+    visitor/graphtheoryvisitors/tspsolver.cpp \
+    visitor/graphtheoryvisitors/tspheuristic.cpp \
+    visitor/graphtheoryvisitors/tspheuristicvisitor.cpp \
+    visitor/graphtheoryvisitors/stronglyconnectedcomponents.cpp \
+    visitor/graphtheoryvisitors/graphdistances.cpp \
     graph/graphComp/graphcomp.cpp \
     visitor/propertyvisitors/weightedvisitor.cpp \
     exception/invalidgraph.cpp \
@@ -94,7 +100,22 @@ SOURCES += \
     visitor/graphtheoryvisitors/tspvisitor.cpp \
     visitor/propertyvisitors/completevisitor.cpp \
     fileIO/formats/dotreader.cpp \
-    fileIO/formats/dotwriter.cpp
+    fileIO/formats/dotwriter.cpp \
+    graph/csrgraph.cpp \
+    graph/hybridGraphState/csrstate.cpp \
+    graph/hybridGraphState/hybridcostmodel.cpp \
+    graph/bitmatrix.cpp \
+    graph/graphbuilder.cpp \
+    graph/sparsematrix.cpp \
+    fileIO/mappedfile.cpp \
+    fileIO/sixbitstream.cpp \
+    fileIO/graphbatchreader.cpp \
+    visitor/visitorbatchhandler.cpp \
+    fileIO/formats/binarygraphreader.cpp \
+    fileIO/formats/binarygraphwriter.cpp \
+    fileIO/dottokenizer.cpp \
+    graph/distancematrix.cpp \
+    fileIO/batchconverter.cpp
 
 HEADERS += \
     graph/graph.h \
@@ -173,6 +194,12 @@ HEADERS += \
     observer/GUI/settingswindow.h \
     visitor/graphtheoryvisitors/hamcyclevisitor.h \
     visitor/graphtheoryvisitors/hampathvisitor.h \
+    visitor/graphtheoryvisitors/hamiltoniansolver.h \
+    visitor/graphtheoryvisitors/tspsolver.h \
+    visitor/graphtheoryvisitors/tspheuristic.h \
+    visitor/graphtheoryvisitors/tspheuristicvisitor.h \
+    visitor/graphtheoryvisitors/stronglyconnectedcomponents.h \
+    visitor/graphtheoryvisitors/graphdistances.h \
     graph/graphComp/graphcomp.h \
     visitor/propertyvisitors/weightedvisitor.h \
     exception/invalidgraph.h \
@@ -180,7 +207,25 @@ HEADERS += \
     visitor/graphtheoryvisitors/tspvisitor.h \
     visitor/propertyvisitors/completevisitor.h \
     fileIO/formats/dotreader.h \
-    fileIO/formats/dotwriter.h
+    fileIO/formats/dotwriter.h \
+    graph/csrgraph.h \
+    graph/hybridGraphState/csrstate.h \
+    graph/edgefunctor.h \
+    graph/objectpool.h \
+    graph/hybridGraphState/hybridcostmodel.h \
+    graph/bitmatrix.h \
+    graph/graphbuilder.h \
+    graph/sparsematrix.h \
+    fileIO/mappedfile.h \
+    fileIO/sixbitstream.h \
+    fileIO/graphbatchreader.h \
+    visitor/visitorbatchhandler.h \
+    fileIO/formats/binarygraphformat.h \
+    fileIO/formats/binarygraphreader.h \
+    fileIO/formats/binarygraphwriter.h \
+    fileIO/dottokenizer.h \
+    graph/distancematrix.h \
+    fileIO/batchconverter.h
 
 RESOURCES += \
     resources.qrc
@@ -23,6 +23,7 @@ public:
     void overridePriority(int priority);
     // extra information that may be usefull to guide the user
     void setExtraInfo(string extraInfo) {_extraInfo = extraInfo;}
+    string getExtraInfo() const {return _extraInfo;}
 protected:
     int _priority;
     string _extraInfo;
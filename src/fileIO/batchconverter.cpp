@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cctype>
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include "batchconverter.h"
+#include "mappedfile.h"
+#include "exception/fileioex.h"
+
+BatchConverter::BatchConverter(const FormatPrototypeManager& formats) : _formats(formats), _numberOfThreads(0), _milliseconds(0), _next(0)
+{
+
+}
+
+void BatchConverter::addConversion(const string& input, const string& output, const string& format)
+{
+    _conversions.push_back(Conversion(input, output, format));
+}
+
+void BatchConverter::addDirectory(const string& directory, const string& outputDirectory, const string& extension)
+{
+    QDir dir(QString::fromStdString(directory));
+    if (!dir.exists())
+        throw FileIOEx(directory, "the directory doesn't exist");
+    makeDirectory(outputDirectory);
+    // only the files that can be read are converted, the directory can contain other files
+    QStringList files = dir.entryList(QDir::Files, QDir::Name);
+    for (int i = 0; i < files.size(); ++i)
+    {
+        string fileName = dir.filePath(files.at(i)).toStdString();
+        // the format is kept so the worker doesn't have to read the start of the file again
+        string format = _formats.detectFormat(fileName);
+        if (_formats.hasReader(format))
+            addConversion(fileName, getOutputFileName(fileName, outputDirectory, extension), format);
+    }
+}
+
+void BatchConverter::addManifest(const string& manifest, const string& outputDirectory, const string& extension)
+{
+    MappedFile file(manifest);
+    makeDirectory(outputDirectory);
+    const char* line = file.begin();
+    while (line != file.end())
+    {
+        const char* lineEnd = find(line, file.end(), '\n');
+        // the spaces around the line (and the '\r' of a windows file) aren't part of the file names
+        const char* begin = line;
+        const char* end = lineEnd;
+        while (begin != end && isspace(static_cast<unsigned char>(*begin)))
+            ++begin;
+        while (end != begin && isspace(static_cast<unsigned char>(end[-1])))
+            --end;
+        line = lineEnd == file.end() ? lineEnd : lineEnd + 1;
+        if (begin == end || *begin == '#')
+            continue;
+
+        // the input file, optionally followed by spaces and the output file
+        const char* inputEnd = begin;
+        while (inputEnd != end && !isspace(static_cast<unsigned char>(*inputEnd)))
+            ++inputEnd;
+        const char* output = inputEnd;
+        while (output != end && isspace(static_cast<unsigned char>(*output)))
+            ++output;
+        string input(begin, inputEnd);
+        addConversion(input, output == end ? getOutputFileName(input, outputDirectory, extension) : string(output, end));
+    }
+}
+
+const vector<BatchConverter::Conversion>& BatchConverter::convert()
+{
+    QElapsedTimer timer;
+    timer.start();
+    _next = 0;
+
+    unsigned numberOfThreads = _numberOfThreads ? _numberOfThreads : max(QThread::idealThreadCount(), 1);
+    // there is no use in having more workers than files
+    numberOfThreads = max(min(numberOfThreads, unsigned(_conversions.size())), 1u);
+    vector<Worker*> workers;
+    for (unsigned i = 0; i < numberOfThreads; ++i)
+        workers.push_back(new Worker(*this));
+    // with one worker there is no need for a thread
+    if (numberOfThreads == 1)
+        workers[0]->process();
+    else
+    {
+        for (unsigned i = 0; i < workers.size(); ++i)
+            workers[i]->start();
+        for (unsigned i = 0; i < workers.size(); ++i)
+            workers[i]->wait();
+    }
+    for (unsigned i = 0; i < workers.size(); ++i)
+        delete workers[i];
+
+    _milliseconds = timer.nsecsElapsed() / 1000000.0;
+    return _conversions;
+}
+
+void BatchConverter::makeDirectory(const string& directory)
+{
+    // no directory is the current directory
+    if (!directory.empty() && !QDir().mkpath(QString::fromStdString(directory)))
+        throw FileIOEx(directory, "the output directory can't be created");
+}
+
+bool BatchConverter::nextConversion(unsigned& index)
+{
+    QMutexLocker locker(&_mutex);
+    if (_next == _conversions.size())
+        return false;
+    index = _next++;
+    return true;
+}
+
+string BatchConverter::getOutputFileName(const string& fileName, const string& outputDirectory, const string& extension)
+{
+    string name = QFileInfo(QString::fromStdString(fileName)).completeBaseName().toStdString();
+    return QDir(QString::fromStdString(outputDirectory)).filePath(QString::fromStdString(name + "." + extension)).toStdString();
+}
+
+BatchConverter::Worker::~Worker()
+{
+    for (map<string, FormatHandlerState*>::iterator it = _readers.begin(); it != _readers.end(); ++it)
+        delete it->second;
+    for (map<string, FormatHandlerState*>::iterator it = _writers.begin(); it != _writers.end(); ++it)
+        delete it->second;
+}
+
+void BatchConverter::Worker::process()
+{
+    unsigned index;
+    // each conversion is only changed by the worker that got it's index, so the vector doesn't have to be locked
+    while (_converter.nextConversion(index))
+        convert(_converter._conversions[index]);
+}
+
+void BatchConverter::Worker::convert(Conversion& conversion)
+{
+    QElapsedTimer timer;
+    timer.start();
+    try
+    {
+        string format = conversion.format.empty() ? _converter._formats.detectFormat(conversion.input) : conversion.format;
+        FormatHandlerState* reader = getHandler(_readers, format, true);
+        FormatHandlerState* writer = getHandler(_writers, FormatPrototypeManager::getExtension(conversion.output), false);
+        // the graph is reused, the csr arrays keep their memory
+        _graph.removeNodes();
+        reader->setFileName(conversion.input);
+        reader->setGraphPointer(&_graph);
+        reader->doIO();
+        writer->setFileName(conversion.output);
+        writer->setGraphPointer(&_graph);
+        writer->doIO();
+        conversion.succeeded = true;
+        conversion.numberOfNodes = _graph.getNumberOfNodes();
+        conversion.numberOfEdges = _graph.getNumberOfEdges();
+        conversion.inputBytes = QFileInfo(QString::fromStdString(conversion.input)).size();
+        conversion.outputBytes = QFileInfo(QString::fromStdString(conversion.output)).size();
+    }
+    catch (BaseEx& e)
+    {
+        // an exception can't leave the thread, the other files are still converted
+        conversion.error = e.getMessage();
+    }
+    conversion.milliseconds = timer.nsecsElapsed() / 1000000.0;
+}
+
+FormatHandlerState* BatchConverter::Worker::getHandler(map<string, FormatHandlerState*>& handlers, const string& extension, bool reader)
+{
+    map<string, FormatHandlerState*>::iterator it = handlers.find(extension);
+    if (it != handlers.end())
+        return it->second;
+    // the prototype manager throws InvalidFormatEx if there is no handler for the extension
+    FormatHandlerState* handler = reader ? _converter._formats.getReader(extension + "reader")->clone()
+                                         : _converter._formats.getWriter(extension + "writer")->clone();
+    handlers[extension] = handler;
+    return handler;
+}
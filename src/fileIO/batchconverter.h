@@ -0,0 +1,113 @@
+/*
+ Author: Balazs Nemeth
+ Description: BatchConverter converts many graph files from one format to another on a pool of worker threads. The
+              conversions are given one by one, as all the files in a directory (that have a reader) or as a manifest: a text
+              file with an input file on each line, optionally followed by the output file. The format of an input file is
+              recognized by it's content (see FormatPrototypeManager::detectFormat), the extension of the output file
+              determines it's format. Each worker has it's own clones of the readers and writers and one CSRGraph that is
+              reused for all it's files, the graph has no observers and doesn't switch between representations like the
+              HybridGraph that GraphToolKit::openGraph uses. A conversion that fails doesn't stop the others, the error is
+              kept in it's result. Usage:
+
+                BatchConverter converter(formatPrototypeManager);
+                converter.addDirectory("in", "out", "s6");
+                const vector<BatchConverter::Conversion>& conversions = converter.convert();
+     */
+
+#ifndef BATCHCONVERTER_H
+#define BATCHCONVERTER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <QThread>
+#include <QMutex>
+
+#include "graph/csrgraph.h"
+#include "fileIO/formatprototypemanager.h"
+
+using namespace std;
+
+class BatchConverter
+{
+public:
+    // the result of the conversion of one file
+    struct Conversion
+    {
+        Conversion(const string& input, const string& output, const string& format)
+            : input(input), output(output), format(format), succeeded(false), milliseconds(0), inputBytes(0), outputBytes(0), numberOfNodes(0), numberOfEdges(0) {}
+        string input;
+        string output;
+        // the format of the input (the extension of it's reader), empty if the worker has to detect it
+        string format;
+        bool succeeded;
+        // the message of the exception if the conversion failed
+        string error;
+        // the time that it took to read and write the file
+        double milliseconds;
+        long long inputBytes;
+        long long outputBytes;
+        unsigned numberOfNodes;
+        unsigned numberOfEdges;
+    };
+
+    // the readers and writers of formats are used as prototypes, they are only cloned
+    BatchConverter(const FormatPrototypeManager& formats);
+    // the number of worker threads, 0 uses one thread for each core (the default)
+    void setNumberOfThreads(unsigned numberOfThreads) {_numberOfThreads = numberOfThreads;}
+    /* the content of the input and the extension of the output determine the formats, the format of the input can be given
+       if it's known already */
+    void addConversion(const string& input, const string& output, const string& format = "");
+    /* adds all the files in the directory that have a reader for their content or extension, each is written to
+       outputDirectory with the same name and the given extension. outputDirectory is created if it doesn't exist.
+       throws FileIOEx if the directory can't be read or outputDirectory can't be created */
+    void addDirectory(const string& directory, const string& outputDirectory, const string& extension);
+    /* adds the files of the manifest, a line without an output file is written like the files of addDirectory. empty lines and
+       lines that start with '#' are skipped. throws FileIOEx if the manifest can't be read or outputDirectory can't be created */
+    void addManifest(const string& manifest, const string& outputDirectory, const string& extension);
+    // converts all the files that were added, the results are in the same order as the conversions were added
+    const vector<Conversion>& convert();
+    const vector<Conversion>& getConversions() const {return _conversions;}
+    // the time that convert() took, this is less than the sum of the conversions if there is more than one thread
+    double getMilliseconds() const {return _milliseconds;}
+
+    // returns outputDirectory/<name of the file without it's extension>.extension
+    static string getOutputFileName(const string& fileName, const string& outputDirectory, const string& extension);
+
+private:
+    // a worker converts the files that it gets from the converter until there are none left
+    class Worker : public QThread
+    {
+    public:
+        Worker(BatchConverter& converter) : _converter(converter) {}
+        ~Worker();
+        // the work of the thread, run() calls this but it can also be called directly to work in the current thread
+        void process();
+    protected:
+        void run() {process();}
+    private:
+        void convert(Conversion& conversion);
+        // returns the clone of the reader or writer of the extension, the clones are made the first time they are needed
+        FormatHandlerState* getHandler(map<string, FormatHandlerState*>& handlers, const string& extension, bool reader);
+
+        BatchConverter& _converter;
+        CSRGraph _graph;
+        map<string, FormatHandlerState*> _readers;
+        map<string, FormatHandlerState*> _writers;
+    };
+
+    // creates the directory (and it's parents) if it doesn't exist yet, throws FileIOEx if that fails
+    static void makeDirectory(const string& directory);
+    // hands out the index of the next conversion to a worker, returns false if there are none left
+    bool nextConversion(unsigned& index);
+
+    const FormatPrototypeManager& _formats;
+    unsigned _numberOfThreads;
+    vector<Conversion> _conversions;
+    double _milliseconds;
+    // the index of the next conversion that is handed out, guarded by _mutex
+    QMutex _mutex;
+    unsigned _next;
+};
+
+#endif // BATCHCONVERTER_H
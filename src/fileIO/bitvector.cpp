@@ -1,131 +1,129 @@
 #include "bitvector.h"
-#include <assert.h>
-#include <bitset>
-#include <iostream>
 #include <QDebug>
 
-BitVector::BitVector(unsigned number)
+BitVector::BitVector(unsigned number) : _size(0)
 {
     // we only take the last 3 bytes
-    unsigned mask = 1;
-    for(unsigned i = 0; i < 18; ++i)
-    {
-        _list.push_back(mask & number);
-        mask <<= 1;
-    }
+    appendBits(number, 18);
 }
 
-BitVector::BitVector()
+BitVector::BitVector() : _size(0)
 {
     // default constructor
 }
 
-void BitVector::appendByte(char value, unsigned size)
+void BitVector::appendBits(Word value, unsigned length)
 {
-    // use a temp list of bools which always gets the bits pushed at the front, at the end we push temp list behind what we already have
-    list<bool> temp;
-    unsigned mask = 1;
-    for(unsigned i = 0; i < size; ++i)
+    assert(length <= BITS_PER_WORD);
+    if (length == 0)
+        return ;
+    // only keep the lowest length bits
+    if (length < BITS_PER_WORD)
+        value &= (Word(1) << length) - 1;
+    unsigned used = _size % BITS_PER_WORD;
+    if (used == 0)
+        _words.push_back(0);
+    unsigned free = BITS_PER_WORD - used;
+    if (length <= free)
+        _words.back() |= value << (free - length);
+    else
     {
-        temp.push_front(mask & value);
-        mask <<= 1;
+        // the first bits fill up the last word, the rest start a new word
+        _words.back() |= value >> (length - free);
+        _words.push_back(value << (BITS_PER_WORD - (length - free)));
     }
-    for(list<bool>::iterator i = temp.begin(); i != temp.end(); ++i)
-        _list.push_back(*i);
+    _size += length;
 }
 
-void BitVector::appendBit(bool value)
+BitVector::Word BitVector::getBits(size_t index, unsigned length) const
 {
-    _list.push_back(value);
+    assert(length <= BITS_PER_WORD);
+    // index and length must be inbounds
+    assert(index + length <= _size);
+    if (length == 0)
+        return 0;
+    size_t k = index / BITS_PER_WORD;
+    unsigned offset = index % BITS_PER_WORD;
+    // move the first bit to the most significant position, take the rest from the next word if the bits cross a word
+    Word bits = _words[k] << offset;
+    if (offset + length > BITS_PER_WORD)
+        bits |= _words[k + 1] >> (BITS_PER_WORD - offset);
+    return bits >> (BITS_PER_WORD - length);
 }
 
-void BitVector::prependbit(bool value)
+size_t BitVector::nextSetBit(size_t from) const
 {
-    _list.push_front(value);
-}
-
-void BitVector::padR(unsigned multipleOf, bool padWith)
-{
-    while(_list.size() % multipleOf != 0)
-        _list.push_back(padWith);
+    if (from >= _size)
+        return _size;
+    size_t k = from / BITS_PER_WORD;
+    // ignore the bits before from in the first word
+    Word word = _words[k] & (~Word(0) >> (from % BITS_PER_WORD));
+    while (true)
+    {
+        if (word)
+            return k * BITS_PER_WORD + countLeadingZeros(word);
+        if (++k == _words.size())
+            return _size;
+        word = _words[k];
+    }
 }
 
-void BitVector::unPadR(unsigned multipleOf)
+void BitVector::appendSixBitGroups(const char* begin, const char* end)
 {
-    while(_list.size() % multipleOf != 0)
-        _list.pop_back();
+    reserve(_size + 6 * (end - begin));
+    // collect 10 groups (60 bits) before appending them, so the words are touched once for every 10 characters
+    while (end - begin >= 10)
+    {
+        Word bits = 0;
+        for (unsigned i = 0; i < 10; ++i)
+            bits = (bits << 6) | ((begin[i] - 63) & 63);
+        appendBits(bits, 60);
+        begin += 10;
+    }
+    for (; begin != end; ++begin)
+        appendBits((*begin - 63) & 63, 6);
 }
 
-void BitVector::padL(unsigned multipleOf)
+void BitVector::writeSixBitGroups(string& result) const
 {
-    while(_list.size() % multipleOf != 0)
-        _list.push_front(0);
-}
-char BitVector::getIntBit(unsigned index, unsigned length) const
-{
-    // index and length must be inbounds
-    assert(index + length <= _list.size());
-    // length can only be a maximum of 8 (1 byte)
-    assert(length < 8);
-    // this is the variable that will hold the bits selected by the user
-    char result = 0; // 00000000
-    // we will bitshift the mask so that we can add the right bits to the result
-    char mask = 1;
-    // iterator that points to the right place in the list
-    list<bool>::const_iterator it = _list.begin();
-    // put the iterator where index points to
-    while(index > 0)
-    {
-        ++it;
-        --index;
-    }
-    unsigned tempLength = length;
-    while(tempLength > 1)
+    assert(_size % 6 == 0);
+    result.reserve(result.size() + _size / 6);
+    size_t index = 0;
+    // read 60 bits at a time and split them in 10 characters
+    for (; index + 60 <= _size; index += 60)
     {
-        ++it;
-        tempLength--;
+        Word bits = getBits(index, 60);
+        for (int i = 9; i >= 0; --i)
+            result += (char)(((bits >> (6 * i)) & 63) + 63);
     }
-    while (length > 0)
-    {
-        if (*it)
-            result |= mask;
-        mask <<= 1;
-        // decrease the length
-        --length;
-        it--;
-    }
-    return result;
+    for (; index < _size; index += 6)
+        result += (char)(getBits(index, 6) + 63);
 }
 
-void BitVector::setReadMode()
+void BitVector::resize(size_t size)
 {
-    // clear any previous bits in the bitvector
-    _readVector.clear();
-    // reserve the size so we don't have to resize the vector after each push_back
-    _readVector.reserve(_list.size());
-    for (list<bool>::const_iterator it = _list.begin(); it != _list.end(); ++it)
-    {
-        _readVector.push_back(*it);
-    }
+    assert(size >= _size);
+    // the new words are 0 and the bits after _size in the last word are already 0
+    _words.resize((size + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+    _size = size;
 }
 
-bool BitVector::bitAt(unsigned index) const
+void BitVector::padR(unsigned multipleOf, bool padWith)
 {
-    // small assert that is not completly error proof but this condition NEEDS to be true otherwise setReadMode defenitly been called!
-    assert(_readVector.size() == _list.size());
-    return _readVector[index];
+    unsigned numberOfBits = (multipleOf - _size % multipleOf) % multipleOf;
+    for (; numberOfBits > BITS_PER_WORD; numberOfBits -= BITS_PER_WORD)
+        appendBits(padWith ? ~Word(0) : 0, BITS_PER_WORD);
+    appendBits(padWith ? ~Word(0) : 0, numberOfBits);
 }
 
 // friend
 QDebug operator<<(QDebug dbg, const BitVector& other)
 {
-    unsigned int counter = 0;
-    for(list<bool>::const_iterator i = other._list.begin(); i != other._list.end(); ++i)
+    for (size_t i = 0; i < other._size; ++i)
     {
-        if(counter % 6 == 0)
+        if(i % 6 == 0)
             dbg.nospace() << " ";
-        dbg.nospace() <<  (*i ? 1 : 0);
-        counter ++;
+        dbg.nospace() <<  (other.bitAt(i) ? 1 : 0);
     }
     return dbg.space();
 }
@@ -1,13 +1,18 @@
 /*
  Author: Balazs Nemeth
- Description: bitvector represents a vector bits, it's basicly a wrapper around std::vector but extends it's capabilities
+ Description: bitvector represents a vector of bits that are read and written in groups, like the 6 bit groups of graph6 and sparse6.
+              The bits are packed in 64 bit words, the first bit of the vector is the most significant bit of the first word.
+              This way a group of bits that is read or appended is a shift and a mask of one or two words, the bits
+              of a group are in the same order as in the file: the first bit is the most significant bit of the group.
      */
 
 #ifndef BITVECTOR_H
 #define BITVECTOR_H
 
-// use stdlib, a better way would be to use bitfields
-#include <list>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <assert.h>
 #include <QDebug>
 
 using namespace std;
@@ -15,41 +20,78 @@ using namespace std;
 class BitVector
 {
 public:
+    typedef unsigned long long Word;
+    enum { BITS_PER_WORD = 64 };
 
-    // constructs the bitvector from an unsigned integer
+    // constructs the bitvector from the lowest 18 bits of an unsigned integer, the most significant bit first
     BitVector(unsigned number);
     BitVector();
 
-    /* converts the list into a vector for random acces, this function is called onces before reading is done.
-       Normally the bitvector won't be used to read 1 bit, instead one will read more bits, by implementing this function
-       we can take the advantage of the vector only when we read*/
-    void setReadMode();
     // returns true if the bit at the index is true, else return false
-    bool bitAt(unsigned index) const;
+    bool bitAt(size_t index) const
+    {
+        assert(index < _size);
+        return (_words[index / BITS_PER_WORD] >> (BITS_PER_WORD - 1 - index % BITS_PER_WORD)) & 1;
+    }
+    // sets the bit at the index to 1
+    void setBit(size_t index)
+    {
+        assert(index < _size);
+        _words[index / BITS_PER_WORD] |= Word(1) << (BITS_PER_WORD - 1 - index % BITS_PER_WORD);
+    }
     // adds a bit at the and of the bitvector
-    void appendBit(bool value);
-    // adds a bit at the beginning of the bitvector
-    void prependbit(bool value);
+    void appendBit(bool value) {appendBits(value, 1);}
+    // appends the length lowest bits of value (length can be up to 64), the most significant of these bits first
+    void appendBits(Word value, unsigned length);
+    /* returns length bits (up to 64) starting at the index as an integer, the bit at the index is the most significant bit
+       of the result, if length is ie 2 then the 2 bits are in the lowest order bits of the integer*/
+    Word getBits(size_t index, unsigned length) const;
+    // the same for at most 8 bits
+    char getIntBit(size_t index, unsigned length) const {assert(length <= 8); return (char)getBits(index, length);}
+    // returns the index of the first bit at or after from that is 1, size() if there is none
+    size_t nextSetBit(size_t from) const;
+
+    // appends the 6 bit groups that are encoded in the characters [begin, end), each character is 63 + the value of the group (graph6 and sparse6)
+    void appendSixBitGroups(const char* begin, const char* end);
+    // appends the bits as characters (63 + each group of 6 bits) to result, the size has to be a multiple of 6 (see padR)
+    void writeSixBitGroups(string& result) const;
+
+    // adds zero's at the end until the bitvector has size bits, the size can't shrink
+    void resize(size_t size);
+    // makes room for size bits
+    void reserve(size_t size) {_words.reserve((size + BITS_PER_WORD - 1) / BITS_PER_WORD);}
     // pads the bitvector by adding zero's or one's at the end so that the length of the bitvector is a multiple of unsigned multipleOf
     void padR(unsigned multipleOf = 6, bool padWith = false);
-    // unpads (removes) bits from the end of the bitvector so that the length of the bitvector is a multiple of unsigned multipleOf
-    void unPadR(unsigned multipleOf = 6);
-    // pads the bitvector by adding zeros at the beginning so that the length of the bitvector is a multiple of unsigned multipleOf
-    void padL(unsigned multipleOf = 6);
     // returns the size of the bitvector
-    unsigned size() const {return _list.size();}
-    /* returns and unsigned integer containing all the bits, if length is bigger
-        than 8, an assertion is made, if length is ie 2 then the 2 bits are in the lowest order bits of the integer*/
-    char getIntBit(unsigned index, unsigned length) const;
-    // appends size number of bits of the byte "value"
-    void appendByte(char value, unsigned size);
+    size_t size() const {return _size;}
+    void clear() {_words.clear(); _size = 0;}
+
+    // returns the number of bits needed to write number in binary, at least 1 (k in sparse6 is bitsFor(n - 1))
+    static unsigned bitsFor(unsigned number) {return number ? BITS_PER_WORD - countLeadingZeros(number) : 1;}
+    // word must not be 0
+    static unsigned countLeadingZeros(Word word);
     // for debugging
     friend QDebug operator<<(QDebug dbg, const BitVector& other);
 private:
-    // use a list so we can pop_front, no random access is needed, alot of bits will be added so a list is the obvious choice here
-    list<bool> _list;
-    // is used when reading with bitAt;
-    vector<bool> _readVector;
+    // the bits after _size in the last word are always 0, so the words can be or'ed when appending
+    vector<Word> _words;
+    size_t _size;
 };
 
+inline unsigned BitVector::countLeadingZeros(Word word)
+{
+    assert(word);
+#ifdef __GNUC__
+    return __builtin_clzll(word);
+#else
+    unsigned count = 0;
+    while (!(word >> (BITS_PER_WORD - 1)))
+    {
+        word <<= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
 #endif // BITVECTOR_H
@@ -0,0 +1,196 @@
+#include "dottokenizer.h"
+#include <cctype>
+
+// the characters that can be in a name, the bytes of utf-8 characters are allowed as well
+static bool isNameCharacter(char c)
+{
+    return isalnum((unsigned char)c) || c == '_' || (unsigned char)c >= 128;
+}
+
+DotTokenizer::TokenType DotTokenizer::next()
+{
+    skipSpace();
+    _quoted = false;
+    if (_position == _end)
+        return _type = END;
+    char c = *_position;
+    switch (c)
+    {
+    case '{': ++_position; return _type = LEFTBRACE;
+    case '}': ++_position; return _type = RIGHTBRACE;
+    case '[': ++_position; return _type = LEFTBRACKET;
+    case ']': ++_position; return _type = RIGHTBRACKET;
+    case '=': ++_position; return _type = EQUAL;
+    case ';': ++_position; return _type = SEMICOLON;
+    case ',': ++_position; return _type = COMMA;
+    case ':': ++_position; return _type = COLON;
+    case '"': return _type = readQuoted() ? ID : INVALID;
+    case '<': return _type = readHTML() ? ID : INVALID;
+    }
+    if (c == '-' && _end - _position >= 2 && (_position[1] == '>' || _position[1] == '-'))
+    {
+        _type = _position[1] == '>' ? DIRECTEDEDGE : UNDIRECTEDEDGE;
+        _position += 2;
+        return _type;
+    }
+    if (c == '-' || c == '.' || isdigit((unsigned char)c))
+    {
+        readNumeral();
+        return _type = _text.empty() ? INVALID : ID;
+    }
+    if (isNameCharacter(c))
+    {
+        readName();
+        return _type = ID;
+    }
+    return _type = INVALID;
+}
+
+bool DotTokenizer::isKeyword(const char* keyword) const
+{
+    if (_type != ID || _quoted)
+        return false;
+    unsigned i = 0;
+    for (; keyword[i]; ++i)
+        if (i >= _text.size() || tolower((unsigned char)_text[i]) != keyword[i])
+            return false;
+    return i == _text.size();
+}
+
+void DotTokenizer::skipSpace()
+{
+    while (_position != _end)
+    {
+        char c = *_position;
+        if (c == '\n')
+            ++_line;
+        if (isspace((unsigned char)c))
+            ++_position;
+        // a line starting with '#' is output of the c preprocessor and is skipped, as is a line comment
+        else if (c == '#' || (c == '/' && _end - _position >= 2 && _position[1] == '/'))
+        {
+            while (_position != _end && *_position != '\n')
+                ++_position;
+        }
+        else if (c == '/' && _end - _position >= 2 && _position[1] == '*')
+        {
+            _position += 2;
+            while (_position != _end && !(*_position == '*' && _end - _position >= 2 && _position[1] == '/'))
+            {
+                if (*_position == '\n')
+                    ++_line;
+                ++_position;
+            }
+            _position = _position == _end ? _end : _position + 2;
+        }
+        else
+            return ;
+    }
+}
+
+bool DotTokenizer::readQuoted()
+{
+    _text.clear();
+    _quoted = true;
+    while (true)
+    {
+        // skip the opening quote
+        ++_position;
+        const char* start = _position;
+        while (_position != _end && *_position != '"')
+        {
+            if (*_position == '\n')
+                ++_line;
+            // \" is the only escape, other backslashes are part of the string (like \N in a label)
+            if (*_position == '\\' && _end - _position >= 2 && (_position[1] == '"' || _position[1] == '\n'))
+            {
+                _text.append(start, _position);
+                if (_position[1] == '\n')
+                    ++_line;
+                else
+                    _text += '"';
+                _position += 2;
+                start = _position;
+            }
+            else
+                ++_position;
+        }
+        if (_position == _end)
+            return false;
+        _text.append(start, _position);
+        ++_position;
+        // "a" + "b" is the same string as "ab"
+        const char* afterString = _position;
+        unsigned line = _line;
+        skipSpace();
+        if (_position != _end && *_position == '+')
+        {
+            ++_position;
+            skipSpace();
+            if (_position != _end && *_position == '"')
+                continue;
+        }
+        _position = afterString;
+        _line = line;
+        return true;
+    }
+}
+
+bool DotTokenizer::readHTML()
+{
+    // the text is everything between the outer < and >, the brackets inside have to match
+    const char* start = ++_position;
+    unsigned depth = 1;
+    while (_position != _end)
+    {
+        if (*_position == '\n')
+            ++_line;
+        else if (*_position == '<')
+            ++depth;
+        else if (*_position == '>' && --depth == 0)
+        {
+            _text.assign(start, _position);
+            ++_position;
+            _quoted = true;
+            return true;
+        }
+        ++_position;
+    }
+    return false;
+}
+
+void DotTokenizer::readName()
+{
+    const char* start = _position;
+    while (_position != _end && isNameCharacter(*_position))
+        ++_position;
+    _text.assign(start, _position);
+}
+
+void DotTokenizer::readNumeral()
+{
+    // [-]?(.[0-9]+ | [0-9]+(.[0-9]*)?)
+    const char* start = _position;
+    if (*_position == '-')
+        ++_position;
+    bool digits = false;
+    while (_position != _end && isdigit((unsigned char)*_position))
+    {
+        ++_position;
+        digits = true;
+    }
+    if (_position != _end && *_position == '.')
+    {
+        ++_position;
+        while (_position != _end && isdigit((unsigned char)*_position))
+        {
+            ++_position;
+            digits = true;
+        }
+    }
+    // a '-' or '.' without digits isn't a numeral, next() returns INVALID
+    if (digits)
+        _text.assign(start, _position);
+    else
+        _text.clear();
+}
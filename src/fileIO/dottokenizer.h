@@ -0,0 +1,50 @@
+/*
+ Author: Balazs Nemeth
+ Description: DotTokenizer splits the characters of a DOT file (the Graphviz language) in tokens while it walks over the (mapped)
+              file once. IDs can be names, numerals, double quoted strings (joined with '+') and HTML strings, comments
+              (line comments, block comments and lines starting with '#') are skipped. The text of an ID is kept in one string that is reused,
+              so reading a token doesn't allocate once the string is large enough.
+     */
+
+#ifndef DOTTOKENIZER_H
+#define DOTTOKENIZER_H
+
+#include <string>
+
+using namespace std;
+
+class DotTokenizer
+{
+public:
+    enum TokenType { ID, LEFTBRACE, RIGHTBRACE, LEFTBRACKET, RIGHTBRACKET, EQUAL, SEMICOLON, COMMA, COLON,
+                     DIRECTEDEDGE, UNDIRECTEDEDGE, END, INVALID };
+
+    // the tokenizer reads the characters [begin, end), call next() to read the first token
+    DotTokenizer(const char* begin, const char* end) : _position(begin), _end(end), _type(END), _quoted(false), _line(1) {}
+
+    // reads the next token and returns it's type, INVALID if the characters aren't a token (like an unterminated string)
+    TokenType next();
+    TokenType getType() const {return _type;}
+    // the text of an ID token, without the quotes
+    const string& getText() const {return _text;}
+    // true if the current token is an ID that is the keyword (keywords are case independent and never quoted)
+    bool isKeyword(const char* keyword) const;
+    // the line of the current token, starting at 1
+    unsigned getLine() const {return _line;}
+private:
+    // skips whitespace and comments, counting the lines
+    void skipSpace();
+    bool readQuoted();
+    bool readHTML();
+    void readName();
+    void readNumeral();
+
+    const char* _position;
+    const char* _end;
+    TokenType _type;
+    string _text;
+    bool _quoted;
+    unsigned _line;
+};
+
+#endif // DOTTOKENIZER_H
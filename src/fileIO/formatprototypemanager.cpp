@@ -1,3 +1,6 @@
+#include <QFile>
+#include <QFileInfo>
+
 #include "formatprototypemanager.h"
 #include "assert.h"
 #include "exception/invalidformatex.h"
@@ -49,6 +52,38 @@ FormatHandlerState* FormatPrototypeManager::getWriter(string hash) const
         return _writers.at(hash);
 }
 
+FormatHandlerState* FormatPrototypeManager::createReader(const string& fileName) const
+{
+    return getReader(detectFormat(fileName) + "reader")->clone();
+}
+
+FormatHandlerState* FormatPrototypeManager::createWriter(const string& fileName) const
+{
+    return getWriter(getExtension(fileName) + "writer")->clone();
+}
+
+string FormatPrototypeManager::detectFormat(const string& fileName) const
+{
+    QFile file(QString::fromStdString(fileName));
+    if (!file.open(QIODevice::ReadOnly))
+        return getExtension(fileName);
+    // the readers get the first bytes of the file to recognize their format
+    char start[FormatHandlerState::DETECTSIZE];
+    long long size = file.read(start, FormatHandlerState::DETECTSIZE);
+    file.close();
+    if (size <= 0)
+        return getExtension(fileName);
+    for (map<string, FormatHandlerState*>::const_iterator it = _readers.begin(); it != _readers.end(); ++it)
+        if (it->second->canRead(start, start + size))
+            return convertHashToExtention(it->first);
+    return getExtension(fileName);
+}
+
+string FormatPrototypeManager::getExtension(const string& fileName)
+{
+    return QFileInfo(QString::fromStdString(fileName)).suffix().toStdString();
+}
+
 string FormatPrototypeManager::convertHashToExtention(string hash)
 {
     return hash.substr(0, hash.size() - 6);
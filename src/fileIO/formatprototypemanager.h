@@ -1,10 +1,15 @@
-/* Author: Jeroen Vaelen */
+/* Author: Jeroen Vaelen
+   Description: keeps a prototype of each reader and writer. getReader and getWriter return the prototypes themselves, these
+   are shared by everyone that uses them. createReader and createWriter return a new handler, so files can be read and
+   written at the same time. createReader recognizes the format of a file by it's first bytes (see
+   FormatHandlerState::canRead) and only falls back to the extension when no reader recognizes it. */
 
 #ifndef FORMATPROTOTYPEMANAGER_H
 #define FORMATPROTOTYPEMANAGER_H
 
 #include <map>
 #include <string>
+#include <vector>
 using namespace std;
 
 #include "fileIO/formats/formathandlerstate.h"
@@ -21,6 +26,18 @@ public:
     FormatHandlerState* getReader(string hash) const;
     FormatHandlerState* getWriter(string hash) const;
 
+    /* returns a new reader for the file, the caller deletes it. the reader is found by detectFormat, throws InvalidFormatEx if
+       there is no reader for the format */
+    FormatHandlerState* createReader(const string& fileName) const;
+    // returns a new writer for the extension of the file, the caller deletes it. throws InvalidFormatEx if there is none
+    FormatHandlerState* createWriter(const string& fileName) const;
+    /* returns the extension of the reader that recognizes the first bytes of the file, or the extension of the file name if no
+       reader recognizes it (or the file can't be read, the reader will report that) */
+    string detectFormat(const string& fileName) const;
+    bool hasReader(const string& extension) const {return _readers.count(extension + "reader") != 0;}
+    // returns the extension of the file name, without the dot
+    static string getExtension(const string& fileName);
+
     // added by Balazs, returns for each instance in the prototypemanager what the function suggests
     vector<string> getWriterExtensions() const;
     vector<string> getReaderExtensions() const;
@@ -0,0 +1,62 @@
+/*
+ Author: Balazs Nemeth
+ Description: the layout of the native binary format (.gtb) that is shared by BinaryGraphReader and BinaryGraphWriter. The file
+              is a copy of the structures below, one after another, so it can be used straight from a mapped file:
+
+                Header
+                NodeEntry[numberOfNodes]
+                quint32[numberOfNodes + 1]      the offsets of the edges of each node (csr), the last one is numberOfEdges
+                EdgeEntry[numberOfEdges]        the outgoing edges of node i are at offsets[i] to offsets[i + 1]
+                char[stringPoolSize]            the labels and the name of the graph, not terminated by '\0'
+
+              every structure is a multiple of 4 bytes, so all the fields are aligned if the file is. The numbers are written
+              in the byte order of the machine, a file with the other byte order is refused because the magic number differs.
+              The version is increased when the layout changes.
+     */
+
+#ifndef BINARYGRAPHFORMAT_H
+#define BINARYGRAPHFORMAT_H
+
+#include <QtGlobal>
+
+namespace BinaryGraphFormat
+{
+    // "GTKB" read as a number on a little endian machine
+    const quint32 MAGIC = 0x424b5447;
+    const quint32 VERSION = 1;
+
+    // a string in the string pool
+    struct StringEntry
+    {
+        quint32 offset;
+        quint32 length;
+    };
+
+    struct Header
+    {
+        quint32 magic;
+        quint32 version;
+        quint32 numberOfNodes;
+        quint32 numberOfEdges;
+        quint32 stringPoolSize;
+        StringEntry name;
+    };
+
+    struct NodeEntry
+    {
+        qint32 x;
+        qint32 y;
+        // r, g, b and one byte of padding
+        quint8 color[4];
+        StringEntry label;
+    };
+
+    struct EdgeEntry
+    {
+        quint32 target;
+        quint8 color[4];
+        StringEntry label;
+    };
+}
+
+#endif // BINARYGRAPHFORMAT_H
@@ -0,0 +1,102 @@
+#include <assert.h>
+#include <cstring>
+
+#include "binarygraphreader.h"
+#include "fileIO/mappedfile.h"
+#include "graph/graphComp/node.h"
+#include "exception/fileioex.h"
+
+using namespace BinaryGraphFormat;
+
+BinaryGraphReader::BinaryGraphReader()
+{
+
+}
+
+void BinaryGraphReader::doIO()
+{
+    assert(!_fileName.empty());
+    assert(_graphPointer);
+    MappedFile file(_fileName);
+    if (file.size() < sizeof(Header))
+        throw FileIOEx(_fileName, "the file is too small to be a binary graph");
+    // the tables follow each other, every entry is a multiple of 4 bytes so the casts are aligned
+    const Header& header = *reinterpret_cast<const Header*>(file.begin());
+    if (header.magic != MAGIC)
+        throw FileIOEx(_fileName, "the file isn't a binary graph (or was written on a machine with another byte order)");
+    if (header.version != VERSION)
+        throw FileIOEx(_fileName, "the version of the binary graph isn't supported");
+    const NodeEntry* nodeTable = reinterpret_cast<const NodeEntry*>(file.begin() + sizeof(Header));
+    const quint32* offsets = reinterpret_cast<const quint32*>(nodeTable + header.numberOfNodes);
+    const EdgeEntry* edgeTable = reinterpret_cast<const EdgeEntry*>(offsets + header.numberOfNodes + 1);
+    const char* stringPool = reinterpret_cast<const char*>(edgeTable + header.numberOfEdges);
+    checkTables(header, file.size(), nodeTable, offsets, edgeTable);
+
+    GraphBuilder builder;
+    builder.reserveNodes(header.numberOfNodes);
+    builder.reserveEdges(header.numberOfEdges);
+    for (quint32 i = 0; i < header.numberOfNodes; ++i)
+    {
+        const NodeEntry& entry = nodeTable[i];
+        builder.addNode(Node(getString(stringPool, entry.label), Point(entry.x, entry.y), RGB(entry.color[0], entry.color[1], entry.color[2])));
+    }
+    for (quint32 i = 0; i < header.numberOfNodes; ++i)
+        for (quint32 k = offsets[i]; k < offsets[i + 1]; ++k)
+        {
+            const EdgeEntry& entry = edgeTable[k];
+            // the file has an edge as often as the graph had it, a graph from a matrix can have the same edge more than once
+            builder.addCountedEdge(i, entry.target, getString(stringPool, entry.label), RGB(entry.color[0], entry.color[1], entry.color[2]));
+        }
+    // the graph is changed (and it's observers notified) once, an edge that the graph refuses is an error in the file
+    _graphPointer->removeNodes();
+    try
+    {
+        builder.commit(*_graphPointer);
+    }
+    catch (BaseEx& e)
+    {
+        throw FileIOEx(_fileName, e.getMessage());
+    }
+    _graphPointer->setName(getString(stringPool, header.name));
+}
+
+bool BinaryGraphReader::canRead(const char* begin, const char* end) const
+{
+    // the file starts with the magic number of the header
+    quint32 magic;
+    if (size_t(end - begin) < sizeof(magic))
+        return false;
+    memcpy(&magic, begin, sizeof(magic));
+    return magic == MAGIC;
+}
+
+void BinaryGraphReader::checkTables(const Header& header, size_t fileSize, const NodeEntry* nodeTable, const quint32* offsets, const EdgeEntry* edgeTable) const
+{
+    // the sizes are computed in 64 bits, the counts in a damaged header could make them wrap around
+    unsigned long long expectedSize = sizeof(Header) + (unsigned long long)header.numberOfNodes * sizeof(NodeEntry)
+            + ((unsigned long long)header.numberOfNodes + 1) * sizeof(quint32)
+            + (unsigned long long)header.numberOfEdges * sizeof(EdgeEntry) + header.stringPoolSize;
+    if (expectedSize != fileSize)
+        throw FileIOEx(_fileName, "the size of the file doesn't match it's header");
+    checkString(header.name, header.stringPoolSize);
+    for (quint32 i = 0; i < header.numberOfNodes; ++i)
+    {
+        checkString(nodeTable[i].label, header.stringPoolSize);
+        if (offsets[i] > offsets[i + 1])
+            throw FileIOEx(_fileName, "the edge offsets aren't increasing");
+    }
+    if (offsets[0] != 0 || offsets[header.numberOfNodes] != header.numberOfEdges)
+        throw FileIOEx(_fileName, "the edge offsets don't match the number of edges");
+    for (quint32 k = 0; k < header.numberOfEdges; ++k)
+    {
+        if (edgeTable[k].target >= header.numberOfNodes)
+            throw FileIOEx(_fileName, "an edge refers to a node that doesn't exist");
+        checkString(edgeTable[k].label, header.stringPoolSize);
+    }
+}
+
+void BinaryGraphReader::checkString(const StringEntry& entry, quint32 stringPoolSize) const
+{
+    if (entry.offset > stringPoolSize || entry.length > stringPoolSize - entry.offset)
+        throw FileIOEx(_fileName, "a label lies outside of the string pool");
+}
@@ -0,0 +1,35 @@
+/*
+ Author: Balazs Nemeth
+ Description: reads a graph in the native binary format (see binarygraphformat.h). The file is mapped and the tables are used
+              where they are, the only work per node or edge is creating it. The sizes and indexes in the file are checked
+              before anything is created, so a damaged file gives a FileIOEx instead of a crash.
+     */
+
+#ifndef BINARYGRAPHREADER_H
+#define BINARYGRAPHREADER_H
+
+#include "formathandlerstate.h"
+#include "binarygraphformat.h"
+#include "graph/graphbuilder.h"
+
+class BinaryGraphReader : public FormatHandlerState
+{
+public:
+    BinaryGraphReader();
+    // maps the file and replaces the nodes of the graph with the nodes in the file, throws FileIOEx if the file isn't valid
+    void doIO();
+    string getDescription() const {return description();}
+    string getExtension() const {return extention();}
+    static string extention() {return "gtb";}
+    FormatHandlerState* clone() const {return new BinaryGraphReader();}
+    bool canRead(const char* begin, const char* end) const;
+    static string description() { return "Binary GraphToolKit fileformat, loads quickly";}
+private:
+    // checks that the header matches the size of the file and that the offsets, targets and strings are within their tables
+    void checkTables(const BinaryGraphFormat::Header& header, size_t fileSize, const BinaryGraphFormat::NodeEntry* nodeTable,
+                     const quint32* offsets, const BinaryGraphFormat::EdgeEntry* edgeTable) const;
+    void checkString(const BinaryGraphFormat::StringEntry& entry, quint32 stringPoolSize) const;
+    static string getString(const char* stringPool, const BinaryGraphFormat::StringEntry& entry) {return string(stringPool + entry.offset, entry.length);}
+};
+
+#endif // BINARYGRAPHREADER_H
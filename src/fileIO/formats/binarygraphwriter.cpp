@@ -0,0 +1,95 @@
+#include <assert.h>
+#include <QFile>
+
+#include "binarygraphwriter.h"
+#include "graph/graphComp/node.h"
+#include "graph/graphComp/edge.h"
+#include "exception/fileioex.h"
+
+using namespace BinaryGraphFormat;
+
+BinaryGraphWriter::BinaryGraphWriter()
+{
+
+}
+
+void BinaryGraphWriter::doIO()
+{
+    assert(_graphPointer);
+    assert(!_fileName.empty());
+    _nodeTable.clear();
+    _offsets.clear();
+    _edgeTable.clear();
+    _stringPool.clear();
+
+    const vector<Node*>& nodes = _graphPointer->getNodes();
+    unsigned numberOfNodes = _graphPointer->getNumberOfNodes();
+    _nodeTable.reserve(numberOfNodes);
+    _offsets.reserve(numberOfNodes + 1);
+    _edgeTable.reserve(_graphPointer->getNumberOfEdges());
+    for (unsigned i = 0; i < numberOfNodes; ++i)
+    {
+        NodeEntry entry;
+        entry.x = nodes[i]->getCoords().getX();
+        entry.y = nodes[i]->getCoords().getY();
+        entry.color[0] = nodes[i]->getColor().getRed();
+        entry.color[1] = nodes[i]->getColor().getGreen();
+        entry.color[2] = nodes[i]->getColor().getBlue();
+        entry.color[3] = 0;
+        entry.label = addString(nodes[i]->getLabel().getLabelString());
+        _nodeTable.push_back(entry);
+        // the outgoing edges of each node are one row of the csr adjacency
+        _offsets.push_back(_edgeTable.size());
+        AddEdgeEntry addEdgeEntry(*_graphPointer, *this);
+        _graphPointer->forEachOutgoingEdge(nodes[i], addEdgeEntry);
+    }
+    _offsets.push_back(_edgeTable.size());
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.numberOfNodes = _nodeTable.size();
+    header.numberOfEdges = _edgeTable.size();
+    header.name = addString(_graphPointer->getName());
+    header.stringPoolSize = _stringPool.size();
+
+    QFile file(QString::fromStdString(_fileName));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        throw FileIOEx(_fileName, "the file can't be opened for writing");
+    if (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != qint64(sizeof(header)))
+        throw FileIOEx(_fileName, "the file couldn't be written completely");
+    writeTable(file, _nodeTable);
+    writeTable(file, _offsets);
+    writeTable(file, _edgeTable);
+    writeTable(file, _stringPool);
+}
+
+bool BinaryGraphWriter::AddEdgeEntry::operator()(Edge* edge)
+{
+    EdgeEntry entry;
+    entry.target = _graph.nodeToIndex(edge->getTarget());
+    entry.color[0] = edge->getColor().getRed();
+    entry.color[1] = edge->getColor().getGreen();
+    entry.color[2] = edge->getColor().getBlue();
+    entry.color[3] = 0;
+    entry.label = _writer.addString(edge->getLabel().getLabelString());
+    _writer._edgeTable.push_back(entry);
+    return true;
+}
+
+StringEntry BinaryGraphWriter::addString(const string& text)
+{
+    StringEntry entry;
+    entry.offset = _stringPool.size();
+    entry.length = text.size();
+    _stringPool.insert(_stringPool.end(), text.begin(), text.end());
+    return entry;
+}
+
+template <class T>
+void BinaryGraphWriter::writeTable(QFile& file, const vector<T>& table)
+{
+    qint64 size = qint64(table.size() * sizeof(T));
+    if (size && file.write(reinterpret_cast<const char*>(&table[0]), size) != size)
+        throw FileIOEx(_fileName, "the file couldn't be written completely");
+}
@@ -0,0 +1,52 @@
+/*
+ Author: Balazs Nemeth
+ Description: writes a graph in the native binary format (see binarygraphformat.h), the tables are built in memory and
+              written with a few large writes. Use this format to save a large graph that has to be loaded again quickly.
+     */
+
+#ifndef BINARYGRAPHWRITER_H
+#define BINARYGRAPHWRITER_H
+
+#include <vector>
+#include "formathandlerstate.h"
+#include "binarygraphformat.h"
+#include "graph/edgefunctor.h"
+
+class QFile;
+
+class BinaryGraphWriter : public FormatHandlerState
+{
+public:
+    BinaryGraphWriter();
+    // writes the graph, throws FileIOEx if the file can't be written
+    void doIO();
+    string getDescription() const {return description();}
+    string getExtension() const {return extention();}
+    static string extention() {return "gtb";}
+    FormatHandlerState* clone() const {return new BinaryGraphWriter();}
+    static string description() { return "Binary GraphToolKit fileformat, loads quickly";}
+private:
+    // adds the edges that the graph walks over to the edge table
+    class AddEdgeEntry : public EdgeFunctor
+    {
+    public:
+        AddEdgeEntry(const Graph& graph, BinaryGraphWriter& writer) : _graph(graph), _writer(writer) {}
+        bool operator()(Edge* edge);
+    private:
+        const Graph& _graph;
+        BinaryGraphWriter& _writer;
+    };
+
+    // adds the string to the string pool and returns where it is
+    BinaryGraphFormat::StringEntry addString(const string& text);
+    // writes the bytes of the vector, throws FileIOEx if they can't all be written
+    template <class T>
+    void writeTable(QFile& file, const vector<T>& table);
+
+    vector<BinaryGraphFormat::NodeEntry> _nodeTable;
+    vector<quint32> _offsets;
+    vector<BinaryGraphFormat::EdgeEntry> _edgeTable;
+    vector<char> _stringPool;
+};
+
+#endif // BINARYGRAPHWRITER_H
@@ -1,163 +1,324 @@
-#include <fstream>
+#include <algorithm>
+#include <assert.h>
 
 #include "dotreader.h"
+#include "fileIO/mappedfile.h"
 #include "exception/fileioex.h"
 
-DotReader::DotReader()
+DotReader::DotReader() : _directed(true), _strict(false), _depth(0)
 {
 
 }
 
 void DotReader::doIO()
 {
-    // reset the map that might have been filled in a previous doIO()
+    assert(!_fileName.empty());
+    assert(_graphPointer);
+    // reset everything that might have been filled in a previous doIO()
     _nodeIDMap.clear();
-    // readFile will fill _fileLines
-    readFile();
+    _nodeLabels.clear();
+    _usedNodes.clear();
+    _operands.clear();
+    _edges.clear();
+    _edgeIndex.clear();
+    _nextEdge.clear();
+    _builder.clear();
+    _defaults.nodeLabel = "\\N";
+    _defaults.edgeLabel = "";
+    _depth = 0;
 
-    list<string>::iterator i = _fileLines.begin();
+    // map the file, if the file can't be opened an exception will be thrown
+    MappedFile file(_fileName);
+    DotTokenizer tokenizer(file.begin(), file.end());
+    string name = parseGraph(tokenizer);
 
-    // first line should countain the name of the graph
-    if (!parseName(*i))
-        throw FileIOEx(_fileName, "can't read the graph name or this dot file isn't supported");
-    ++i;
-    while (i != _fileLines.end())
+    // the edges refer to the nodes by position
+    _builder.reserveNodes(_nodeLabels.size());
+    for (unsigned i = 0; i < _nodeLabels.size(); ++i)
+        _builder.addNode(Node(_nodeLabels[i]));
+    _builder.reserveEdges(_edges.size());
+    for (unsigned i = 0; i < _edges.size(); ++i)
+        _builder.addEdge(_edges[i].source, _edges[i].target, _edges[i].label);
+    // the graph is changed (and it's observers notified) once
+    _builder.commit(*_graphPointer);
+    _graphPointer->setName(name);
+    // the builder and the maps can be large, they aren't needed anymore
+    _builder.clear();
+    _nodeIDMap.clear();
+    _nodeLabels.clear();
+    _edges.clear();
+    _edgeIndex.clear();
+    _nextEdge.clear();
+}
+
+bool DotReader::canRead(const char* begin, const char* end) const
+{
+    // the tokenizer skips the comments, a dot file starts with [strict] (graph | digraph)
+    DotTokenizer tokenizer(begin, end);
+    tokenizer.next();
+    if (tokenizer.isKeyword("strict"))
+        tokenizer.next();
+    return tokenizer.isKeyword("graph") || tokenizer.isKeyword("digraph");
+}
+
+string DotReader::parseGraph(DotTokenizer& tokenizer)
+{
+    tokenizer.next();
+    _strict = tokenizer.isKeyword("strict");
+    if (_strict)
+        tokenizer.next();
+    if (tokenizer.isKeyword("digraph"))
+        _directed = true;
+    else if (tokenizer.isKeyword("graph"))
+        _directed = false;
+    else
+        throwError(tokenizer, "expected graph or digraph");
+    string name;
+    if (tokenizer.next() == DotTokenizer::ID)
     {
-        if (!(((*i).size() >= 1 &&((*i).at(0) == '}' || (*i).at(0) == '{'))  || (*i).size() <= 2))
-        {
-            if (isEdgeLine(*i))
-                processLineEdge(*i);
-            else
-                processLineNode(*i);
-        }
-        ++i;
+        name = tokenizer.getText();
+        tokenizer.next();
     }
+    expect(tokenizer, DotTokenizer::LEFTBRACE, "'{'");
+    tokenizer.next();
+    parseStatementList(tokenizer);
+    // only the first graph in the file is read
+    return name;
 }
 
-bool DotReader::isEdgeLine(string line)
+void DotReader::parseStatementList(DotTokenizer& tokenizer)
 {
-    for (unsigned i = 0; i < line.size(); ++i)
+    while (tokenizer.getType() != DotTokenizer::RIGHTBRACE)
     {
-        if (line.at(i) == '-' && i + 1 < line.size() && line.at(i+1) == '>')
-            return true;
+        if (tokenizer.getType() == DotTokenizer::END)
+            throwError(tokenizer, "missing '}'");
+        if (tokenizer.getType() == DotTokenizer::SEMICOLON)
+            tokenizer.next();
+        else
+            parseStatement(tokenizer);
+        // outside of a subgraph the used nodes aren't needed after the statement
+        if (_depth == 0)
+            _usedNodes.clear();
     }
-    return false;
 }
 
-void DotReader::processLineEdge(string line)
+void DotReader::parseStatement(DotTokenizer& tokenizer)
 {
-    string nodeID = "";
-    string nodeID2 = "";
-    string edgeLabel = "";
-//        q_0 [label ="Q0"];
-    unsigned i = 0;
-    // skip untill the first space
-    while (i < line.size() && line.at(i) != ';' && line.at(i) == ' ')
-        ++i;
-
-    if (i >= line.size())
-        return;
-    // read the id of the node
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != ' ' && line.at(i) != '-')
+    // attr_stmt : (graph | node | edge) attr_list
+    bool isNode = tokenizer.isKeyword("node");
+    bool isEdge = tokenizer.isKeyword("edge");
+    if (isNode || isEdge || tokenizer.isKeyword("graph"))
     {
-        nodeID += line.at(i);
-        ++i;
+        tokenizer.next();
+        expect(tokenizer, DotTokenizer::LEFTBRACKET, "'['");
+        string label;
+        if (parseAttributeList(tokenizer, label))
+        {
+            if (isNode)
+                _defaults.nodeLabel = label;
+            else if (isEdge)
+                _defaults.edgeLabel = label;
+        }
+        return ;
     }
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != '>')
-        ++i;
-    ++i;
-    // skip spaces
-    while (i < line.size() && line.at(i) != ';' && line.at(i) == ' ')
-        ++i;
-
-    // read the id of the node
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != ' ')
+    unsigned first = _operands.size();
+    if (tokenizer.isKeyword("subgraph") || tokenizer.getType() == DotTokenizer::LEFTBRACE)
+        parseSubgraph(tokenizer);
+    else
     {
-        nodeID2 += line.at(i);
-        ++i;
+        expect(tokenizer, DotTokenizer::ID, "a statement");
+        _id = tokenizer.getText();
+        // ID '=' ID is an attribute of the graph
+        if (tokenizer.next() == DotTokenizer::EQUAL)
+        {
+            tokenizer.next();
+            expect(tokenizer, DotTokenizer::ID, "a value");
+            tokenizer.next();
+            return ;
+        }
+        unsigned node = getNode(_id);
+        skipPort(tokenizer);
+        if (tokenizer.getType() != DotTokenizer::DIRECTEDEDGE && tokenizer.getType() != DotTokenizer::UNDIRECTEDEDGE)
+        {
+            // node_stmt : node_id [attr_list], the node is part of the subgraph that is being read
+            _usedNodes.push_back(node);
+            string label;
+            if (parseAttributeList(tokenizer, label))
+                _nodeLabels[node] = nodeLabel(label, _id);
+            return ;
+        }
+        pushNode(node);
     }
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != '"')
-        ++i;
-    ++i;
+    if (tokenizer.getType() == DotTokenizer::DIRECTEDEDGE || tokenizer.getType() == DotTokenizer::UNDIRECTEDEDGE)
+        parseEdgeStatement(tokenizer, first);
+    _operands.resize(first);
+}
 
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != '"')
+void DotReader::parseEdgeStatement(DotTokenizer& tokenizer, unsigned first)
+{
+    // edgeRHS : edgeop (node_id | subgraph) [edgeRHS]
+    while (tokenizer.getType() == DotTokenizer::DIRECTEDEDGE || tokenizer.getType() == DotTokenizer::UNDIRECTEDEDGE)
     {
-        edgeLabel += line.at(i);
-        ++i;
+        if ((tokenizer.getType() == DotTokenizer::DIRECTEDEDGE) != _directed)
+            throwError(tokenizer, _directed ? "'--' can't be used in a digraph" : "'->' can't be used in a graph");
+        tokenizer.next();
+        if (tokenizer.isKeyword("subgraph") || tokenizer.getType() == DotTokenizer::LEFTBRACE)
+            parseSubgraph(tokenizer);
+        else
+        {
+            expect(tokenizer, DotTokenizer::ID, "a node or subgraph");
+            _id = tokenizer.getText();
+            tokenizer.next();
+            skipPort(tokenizer);
+            pushNode(getNode(_id));
+        }
     }
-    _graphPointer->addEdge(Edge(_nodeIDMap.at(nodeID), _nodeIDMap.at(nodeID2), edgeLabel));
+    string label = _defaults.edgeLabel;
+    parseAttributeList(tokenizer, label);
+
+    // every node of an operand gets an edge to every node of the next operand
+    for (unsigned k = first; k + 1 < _operands.size(); ++k)
+        for (unsigned i = _operands[k].first; i < _operands[k].second; ++i)
+            for (unsigned j = _operands[k + 1].first; j < _operands[k + 1].second; ++j)
+            {
+                unsigned source = _usedNodes[i];
+                unsigned target = _usedNodes[j];
+                addEdge(tokenizer, source, target, label);
+                // our graphs are directed, an undirected edge is an edge in both directions
+                if (!_directed && source != target)
+                    addEdge(tokenizer, target, source, label);
+            }
 }
 
-void DotReader::processLineNode(string line)
+void DotReader::addEdge(const DotTokenizer& tokenizer, unsigned source, unsigned target, const string& label)
 {
-    string nodeID = "";
-    string nodeLabel = "";
-    unsigned i = 0;
-    // skip untill the first space
-    while (i < line.size() && line.at(i) != ';' && line.at(i) == ' ')
-        ++i;
-
-    if (i >= line.size())
-        return;
-    // read the id of the node
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != ' ')
+    const unsigned NOEDGE = unsigned(-1);
+    unsigned long long key = (static_cast<unsigned long long>(source) << 32) | target;
+    QHash<unsigned long long, unsigned>::const_iterator first = _edgeIndex.constFind(key);
+    if (first != _edgeIndex.constEnd())
     {
-        nodeID += line.at(i);
-        ++i;
+        // a strict graph has at most one edge from source to target, like Graphviz the last label counts
+        if (_strict)
+        {
+            _edges[first.value()].label = label;
+            return ;
+        }
+        for (unsigned i = first.value(); i != NOEDGE; i = _nextEdge[i])
+            if (_edges[i].label.getLabelString() == label)
+                throwError(tokenizer, "the same edge is given twice (a strict graph merges them)");
     }
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != '"')
-        ++i;
-    ++i;
-    // read the node label
-    while (i < line.size() && line.at(i) != ';' && line.at(i) != '"')
+    // the new edge is put in front of the edges with the same source and target
+    _nextEdge.push_back(first != _edgeIndex.constEnd() ? first.value() : NOEDGE);
+    _edgeIndex.insert(key, _edges.size());
+    _edges.push_back(GraphBuilder::EdgeEntry(source, target, label, RGB()));
+}
+
+void DotReader::parseSubgraph(DotTokenizer& tokenizer)
+{
+    if (tokenizer.isKeyword("subgraph") && tokenizer.next() == DotTokenizer::ID)
+        tokenizer.next();
+    expect(tokenizer, DotTokenizer::LEFTBRACE, "'{'");
+    tokenizer.next();
+    unsigned begin = _usedNodes.size();
+    // the defaults that are set inside the subgraph only hold inside it
+    Defaults defaults = _defaults;
+    ++_depth;
+    parseStatementList(tokenizer);
+    --_depth;
+    _defaults = defaults;
+    tokenizer.next();
+    // a node that is used more than once in the subgraph is still one node of the operand
+    sort(_usedNodes.begin() + begin, _usedNodes.end());
+    _usedNodes.erase(unique(_usedNodes.begin() + begin, _usedNodes.end()), _usedNodes.end());
+    _operands.push_back(make_pair(begin, unsigned(_usedNodes.size())));
+}
+
+bool DotReader::parseAttributeList(DotTokenizer& tokenizer, string& label)
+{
+    bool found = false;
+    while (tokenizer.getType() == DotTokenizer::LEFTBRACKET)
     {
-        nodeLabel += line.at(i);
-        ++i;
+        tokenizer.next();
+        // a_list : ID '=' ID [(';' | ',')] [a_list]
+        while (tokenizer.getType() != DotTokenizer::RIGHTBRACKET)
+        {
+            expect(tokenizer, DotTokenizer::ID, "an attribute");
+            bool isLabel = tokenizer.getText() == "label";
+            if (tokenizer.next() == DotTokenizer::EQUAL)
+            {
+                tokenizer.next();
+                expect(tokenizer, DotTokenizer::ID, "a value");
+                if (isLabel)
+                {
+                    label = tokenizer.getText();
+                    found = true;
+                }
+                tokenizer.next();
+            }
+            if (tokenizer.getType() == DotTokenizer::SEMICOLON || tokenizer.getType() == DotTokenizer::COMMA)
+                tokenizer.next();
+        }
+        tokenizer.next();
     }
-    pair<string,Node*> newNodeMap;
-    _graphPointer->addNode(Node(nodeLabel));
-    newNodeMap.first = nodeID;
-    newNodeMap.second = _graphPointer->getNodes().back();
-    _nodeIDMap.insert(newNodeMap);
+    return found;
 }
 
-bool DotReader::parseName(string line)
+void DotReader::skipPort(DotTokenizer& tokenizer)
 {
-    string graphName = "";
-    unsigned i = 0;
-    // skip untill the first space
-    while (i < line.size() && line.at(i) != ' ')
-            ++i;
-    if (i >= line.size())
-        return false;
-    ++i; // skip of the space
-    while (i < line.size() && line.at(i) != ' ')
+    // the port only says where the edge is drawn, port : ':' ID [':' ID]
+    while (tokenizer.getType() == DotTokenizer::COLON)
     {
-        graphName += line.at(i);
-        ++i;
+        tokenizer.next();
+        expect(tokenizer, DotTokenizer::ID, "a port");
+        tokenizer.next();
     }
-    _graphPointer->setName(graphName);
-    return true;
 }
 
-
-void DotReader::readFile()
+void DotReader::pushNode(unsigned node)
 {
-    ifstream fileStream(_fileName.c_str());
-
-    // if fileStream isn't set, the reading of the file failed
-    if(!fileStream)
-        throw FileIOEx(_fileName, "Can't read file");
+    _usedNodes.push_back(node);
+    _operands.push_back(make_pair(unsigned(_usedNodes.size() - 1), unsigned(_usedNodes.size())));
+}
 
-    // buffer for the read line
-    char str[255];
+unsigned DotReader::getNode(const string& id)
+{
+    // the lookup doesn't copy the id, only a new node copies it into the map
+    QHash<QByteArray, unsigned>::const_iterator i = _nodeIDMap.constFind(QByteArray::fromRawData(id.data(), id.size()));
+    if (i != _nodeIDMap.constEnd())
+        return i.value();
+    unsigned node = _nodeLabels.size();
+    _nodeIDMap.insert(QByteArray(id.data(), id.size()), node);
+    _nodeLabels.push_back(nodeLabel(_defaults.nodeLabel, id));
+    return node;
+}
 
-    // while the file isn't at EOF
-    while(fileStream)
+string DotReader::nodeLabel(const string& label, const string& id)
+{
+    if (label == "\\N")
+        return id;
+    string result;
+    for (unsigned i = 0; i < label.size(); ++i)
     {
-       fileStream.getline(str, 255);
-       _fileLines.push_back(str);
+        if (label[i] == '\\' && i + 1 < label.size() && label[i + 1] == 'N')
+        {
+            result += id;
+            ++i;
+        }
+        else
+            result += label[i];
     }
-    // close the file
-    fileStream.close();
+    return result;
+}
+
+void DotReader::expect(const DotTokenizer& tokenizer, DotTokenizer::TokenType type, const char* what) const
+{
+    if (tokenizer.getType() != type)
+        throwError(tokenizer, string("expected ") + what);
+}
+
+void DotReader::throwError(const DotTokenizer& tokenizer, const string& message) const
+{
+    if (tokenizer.getType() == DotTokenizer::INVALID)
+        throw FileIOEx(_fileName, "line " + Label(int(tokenizer.getLine())).getLabelString() + ": invalid characters");
+    throw FileIOEx(_fileName, "line " + Label(int(tokenizer.getLine())).getLabelString() + ": " + message);
 }
@@ -1,11 +1,22 @@
 /*
  Author: Balazs Nemeth
- Description: Dot Reader that reads a graph from a dot, note that reading a dot file is very limited and should be very precicly constructed
+ Description: Dot Reader that reads a graph from a dot file (the Graphviz language). The file is mapped and read once with a
+              DotTokenizer, the statements are parsed as they come: node and edge statements, edge chains (a -> b -> c),
+              undirected edges (--, added in both directions), attribute lists and (nested) subgraphs, an edge to a
+              subgraph is an edge to every node in it. Of the attributes only the labels are used. A node that is used
+              before it's declared is created with it's id as label, like Graphviz does. In a strict graph an edge that is
+              given again is merged with the first one (the last label counts), otherwise the same edge with the same label
+              twice is an error because our graphs can't hold it.
      */
 #ifndef DOTREADER_H
 #define DOTREADER_H
 #include "formathandlerstate.h"
+#include "graph/graphbuilder.h"
+#include "fileIO/dottokenizer.h"
 #include <string>
+#include <vector>
+#include <QHash>
+#include <QByteArray>
 
 using namespace std;
 
@@ -13,25 +24,70 @@ class DotReader : public FormatHandlerState
 {
 public:
     DotReader();
+    // throws FileIOEx (with the line) if the file can't be read or isn't valid dot
     void doIO();
     string getDescription() const {return description();}
     string getExtension() const {return extention();}
     static string extention() {return "dot";}
+    FormatHandlerState* clone() const {return new DotReader();}
+    bool canRead(const char* begin, const char* end) const;
     static string description() { return "Graphviz (DOT Language File)";}
 private:
-    // process a line for a node
-    void processLineNode(string line);
-    // process line for an edge
-    void processLineEdge(string line);
-    // returns true if string contains '->'
-    bool isEdgeLine(string line);
-    // parses the name of the graph form the file
-    bool parseName(string line);
-    void readFile();
-    // temp storage for the file lines
-    list<string> _fileLines;
-    // map between
-    map<string, Node*> _nodeIDMap;
+    // the labels given by the "node [label=...]" and "edge [label=...]" statements, a subgraph restores them at it's end
+    struct Defaults
+    {
+        string nodeLabel;
+        string edgeLabel;
+    };
+
+    // graph : [strict] (graph | digraph) [ID] '{' stmt_list '}', returns the name of the graph
+    string parseGraph(DotTokenizer& tokenizer);
+    // reads the statements up to the '}' that closes the list, the '}' is the current token after this
+    void parseStatementList(DotTokenizer& tokenizer);
+    void parseStatement(DotTokenizer& tokenizer);
+    // the edges of the chain that starts with the operand that has just been read, the first operand is at _operands[first]
+    void parseEdgeStatement(DotTokenizer& tokenizer, unsigned first);
+    // [subgraph [ID]] '{' stmt_list '}', pushes the bounds of the nodes in the subgraph on _operands
+    void parseSubgraph(DotTokenizer& tokenizer);
+    // reads a node id (with an optional port) and pushes it as an operand on _operands
+    void parseNodeOperand(DotTokenizer& tokenizer);
+    // ('[' a_list ']')+ if the current token is '[', returns true and sets label if there is a label attribute
+    bool parseAttributeList(DotTokenizer& tokenizer, string& label);
+    // skips the port (':' ID [':' ID]) after a node id
+    void skipPort(DotTokenizer& tokenizer);
+    // adds the edge, in a strict graph the same edge is merged, otherwise throws FileIOEx if it's already there with the same label
+    void addEdge(const DotTokenizer& tokenizer, unsigned source, unsigned target, const string& label);
+    // adds the node as an operand of one node
+    void pushNode(unsigned node);
+    // returns the position of the node with the id in the builder, the node is created if it doesn't exist yet
+    unsigned getNode(const string& id);
+    // the label that Graphviz would show, \N is replaced by the id of the node
+    static string nodeLabel(const string& label, const string& id);
+    // throws FileIOEx if the current token isn't of the type
+    void expect(const DotTokenizer& tokenizer, DotTokenizer::TokenType type, const char* what) const;
+    void throwError(const DotTokenizer& tokenizer, const string& message) const;
+
+    // map between the id of a node in the file and it's position in the builder
+    QHash<QByteArray, unsigned> _nodeIDMap;
+    // the labels of the nodes, the nodes are added to the builder at the end because a label can be set later
+    vector<string> _nodeLabels;
+    // the nodes that are used in the current statements, a subgraph is the range of nodes that were used inside it
+    vector<unsigned> _usedNodes;
+    // the operands of the edge chains that are being read, each operand is a range [begin, end) of _usedNodes
+    vector<pair<unsigned, unsigned> > _operands;
+    Defaults _defaults;
+    bool _directed;
+    bool _strict;
+    // the edges, they are added to the builder at the end because a strict graph can change the label of an edge later
+    vector<GraphBuilder::EdgeEntry> _edges;
+    // the first edge for each source and target (source << 32 | target) and for each edge the next one with the same source and target
+    QHash<unsigned long long, unsigned> _edgeIndex;
+    vector<unsigned> _nextEdge;
+    // the depth of the subgraphs, _usedNodes is only needed inside a statement or subgraph
+    unsigned _depth;
+    // the id of the node that is being read
+    string _id;
+    GraphBuilder _builder;
 };
 
 #endif // DOTREADER_H
@@ -19,6 +19,7 @@ public:
     string getDescription() const {return description();}
     string getExtension() const {return extention();}
     static string extention() {return "dot";}
+    FormatHandlerState* clone() const {return new DotWriter();}
     static string description() { return "Graphviz (DOT Language File)";}
 private:
     // converts nodes to the dot language
@@ -12,12 +12,20 @@ class FormatHandlerState
 {
 public:
     FormatHandlerState() { _graphPointer = NULL; }
+    virtual ~FormatHandlerState() {}
     void setFileName(const string& fileName) { _fileName = fileName; }
     void setGraphPointer(Graph* graphPointer) { _graphPointer = graphPointer; }
     virtual void doIO() = 0;
     // added by Balazs Nemeth
     virtual string getDescription() const = 0;
     virtual string getExtension() const = 0;
+    // returns a new handler of the same format, handlers keep the state of one doIO() so each thread needs it's own handler
+    virtual FormatHandlerState* clone() const = 0;
+    /* returns true if [begin, end) looks like the start of a file of this format, used to find the reader of a file by it's
+       content. [begin, end) is the whole file or it's first DETECTSIZE bytes. writers and readers that can't tell don't
+       recognize anything */
+    virtual bool canRead(const char* /* begin */, const char* /* end */) const {return false;}
+    static const unsigned DETECTSIZE = 4096;
 protected:
     // returns the filename
     string getFileName(const string& fileName);
@@ -2,132 +2,97 @@
 #include <assert.h>
 #include "graph/graphComp/node.h"
 #include "exception/fileioex.h"
+#include "fileIO/mappedfile.h"
+#include "fileIO/sixbitstream.h"
 
 Graph6Reader::Graph6Reader()
 {
-    resetMembers();
+    _header = ">>graph6<<";
 }
 
 void Graph6Reader::doIO()
 {
-    // reset the members, cleaning any leftovers from the last read
-    resetMembers();
-    unsigned numberOfNodes;
     // filename must be set
     assert(!_fileName.empty());
     // the graph in which the reading will happen has to be set, in other words, it can't be zero
     assert(_graphPointer);
-    // prepare the characterstring, preparing the string will read the file, if the file can't be opened, an exception will be thrown in this function
-    prepareCharStream();
-    // if the header was invalid, we throw an exception
-    if(!validateHeader())
-        throw FileIOEx(_fileName, "the header in the file was invalid");
-    numberOfNodes = readNumberOfNodes();
-    // create the bitvector that can be easely interpreted by constructIntegerMatrix
-    BitVector bitVector = prepareBitVector();
-    // next we construct the integerMatrix
-    IntegerMatrix integerMatrix = constructIntegerMatrix(numberOfNodes, bitVector);
-    _graphPointer->recreateFrom(integerMatrix);
+    // map the file, if the file can't be opened an exception will be thrown
+    MappedFile file(_fileName);
+    const char* begin = skipHeader(file.begin(), file.end());
+    // only the first graph in the file is read
+    GraphBuilder builder;
+    decodeGraph(begin, SixBitStream::lineEnd(begin, file.end()), builder);
+    // the graph is changed (and it's observers notified) once
+    _graphPointer->removeNodes();
+    builder.commit(*_graphPointer);
     _graphPointer->setName(getFileName(_fileName));
 }
 
-void Graph6Reader::resetMembers()
+bool Graph6Reader::canRead(const char* begin, const char* end) const
 {
-    _charStream.clear();
-    _header = ">>graph6<<";
-    _index = 0;
-}
-
-IntegerMatrix Graph6Reader::constructIntegerMatrix(unsigned NumberOfNodes, BitVector bitVector)
-{
-    // tell the bitVector we will now start reading (this will switch from the linked list to a vector)
-    bitVector.setReadMode();
-    IntegerMatrix result;
-    for (unsigned i = 0; i < NumberOfNodes; ++i)
-        result.addNode(Node(i));
-    // used to keep track where we are in the bitvector
-    unsigned bitCounter = 0;
-    for (unsigned i = 0; i < NumberOfNodes; ++i)
-        for(unsigned j = 0 ; j < i; ++j)
-        {
-            if(bitVector.bitAt(bitCounter))
-            {
-                result.addEdge(Node(i), Node(j));
-                result.addEdge(Node(j), Node(i));
-            }
-            ++bitCounter;
-        }
-
-    return result;
-}
-
-bool Graph6Reader::validateHeader()
-{
-    // if the first charachter isn't a '>', then there is no header included, which is also valid
-    if (_charStream.front() != '>')
+    if (size_t(end - begin) >= _header.size() && _header.compare(0, _header.size(), begin, _header.size()) == 0)
         return true;
-    // if the size of the file that has been read, is smaller than the minimum headersize, there can't be a valid header
-    if(_charStream.size() < _header.size())
-        return false;
-    // we will check if the first string of characters in the _charStream equals to the header
-    for (unsigned i = 0; i < _header.size(); ++i)
-    {
-        // if there is a charactermismatch, cancel and return false
-        if(_charStream[i] != _header.at(i))
+    // without a header the first line has to be a graph6 record: only characters 63 to 126 and as many as the nodes need
+    const char* lineEnd = SixBitStream::lineEnd(begin, end);
+    for (const char* position = begin; position != lineEnd; ++position)
+        if (*position < 63 || *position > 126)
             return false;
-    }
-    vector<char> newCharStream;
-    // at this point the header was valid
-    // now we remove the header from the _charStream to reduce complication
-    for(unsigned i = _header.size() ; i < _charStream.size(); ++i)
-            newCharStream.push_back(_charStream[i]);
-    _charStream = newCharStream;
-    return true;
+    SixBitStream stream(begin, lineEnd);
+    unsigned numberOfNodes;
+    if (!stream.readNumberOfNodes(numberOfNodes))
+        return false;
+    size_t numberOfCharacters = ((numberOfNodes ? size_t(numberOfNodes) * (numberOfNodes - 1) / 2 : 0) + 5) / 6;
+    size_t charactersLeft = lineEnd - stream.position();
+    // the line of a large graph can continue after the part of the file that is given
+    return charactersLeft == numberOfCharacters || (lineEnd == end && size_t(end - begin) == DETECTSIZE && charactersLeft < numberOfCharacters);
 }
 
-void Graph6Reader::prepareCharStream()
+void Graph6Reader::decodeGraph(const char* begin, const char* end, GraphBuilder& builder) const
 {
-    char rc;
-    FILE *fp = fopen(_fileName.c_str(), "rb");
-    if (fp == NULL)
-       throw FileIOEx(_fileName, "disk IO error, can't open file to read"); // TOOD: replace with exception
-    while ((rc = getc(fp)) != EOF)
-        _charStream.push_back(rc);
-    fclose(fp);
-}
+    SixBitStream stream(begin, end);
+    unsigned numberOfNodes;
+    if (!stream.readNumberOfNodes(numberOfNodes))
+        throw FileIOEx(_fileName, "the number of nodes is missing");
+    // the bits are the columns of the top triangle one after another, column i has i bits (j = 0 to i - 1)
+    size_t numberOfBits = numberOfNodes ? size_t(numberOfNodes) * (numberOfNodes - 1) / 2 : 0;
+    if (stream.bitsLeft() < numberOfBits)
+        throw FileIOEx(_fileName, "the file ends before all the edges have been read");
 
-unsigned Graph6Reader::readNumberOfNodes()
-{
-    // if the first character is 126, we know that the numberOfnodes is stored in the following 3 bytes
-    if (_charStream[0] == 126)
+    unsigned first = builder.getNumberOfNodes();
+    builder.reserveNodes(first + numberOfNodes);
+    for (unsigned i = 0; i < numberOfNodes; ++i)
+        builder.addNode(Node("Node " + Label(i).getLabelString()));
+
+    // i is the column of the current bit and columnStart the index of the first bit of column i
+    unsigned i = 1;
+    size_t columnStart = 0;
+    for (size_t bit = 0; bit < numberOfBits; bit += 6)
     {
-        unsigned temp[3];
-        // the next 3 bytes are encoded in big endian form
-        for (unsigned i = 0; i < 3; ++i)
+        // most groups are 0 in a sparse graph, only the bits that are 1 are turned into edges
+        unsigned group = stream.readBits(6);
+        for (unsigned k = 0; group && k < 6 && bit + k < numberOfBits; ++k)
         {
-            temp[i] += _charStream[i];
-            // shift the integer
-            temp[i] <<= 6*i;
+            if (!(group & (32 >> k)))
+                continue;
+            while (bit + k >= columnStart + i)
+            {
+                columnStart += i;
+                ++i;
+            }
+            unsigned j = bit + k - columnStart;
+            builder.addEdge(first + i, first + j);
+            builder.addEdge(first + j, first + i);
         }
-        // update the index after reading the number of nodes
-        _index += 3;
-        return (temp[0] + temp[1] + temp[2]);
-    }
-    else
-    {
-        // update the index after reading the number of nodes
-        _index++;
-        return _charStream[0] - 63;
     }
 }
 
-BitVector Graph6Reader::prepareBitVector()
+const char* Graph6Reader::skipHeader(const char* begin, const char* end) const
 {
-    BitVector bitVector;
-    while(_index < _charStream.size() && _charStream[_index] != '\n')
-    {
-        bitVector.appendByte(_charStream[_index] - 63, 6);
-        ++_index;
-    }
-    return bitVector;
+    // if the first charachter isn't a '>', then there is no header included, which is also valid
+    if (begin == end || *begin != '>')
+        return begin;
+    // the header is compared without copying the file, the characters after it are the graph
+    if (size_t(end - begin) < _header.size() || _header.compare(0, _header.size(), begin, _header.size()) != 0)
+        throw FileIOEx(_fileName, "the header in the file was invalid");
+    return begin + _header.size();
 }
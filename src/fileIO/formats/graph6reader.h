@@ -1,14 +1,14 @@
 /*
  Author: Balazs Nemeth
- Description: graph6 reader that reads a graph from a g6 file format defined by Brendan McKay
+ Description: graph6 reader that reads a graph from a g6 file format defined by Brendan McKay. The file is mapped into memory
+              and the edges are decoded straight from the mapped characters into a GraphBuilder.
      */
 #ifndef GRAPH6READER_H
 #define GRAPH6READER_H
 
 #include "formathandlerstate.h"
-#include <vector>
-#include "graph/integermatrix.h"
-#include "fileIO/bitvector.h"
+#include <string>
+#include "graph/graphbuilder.h"
 
 class Graph6Reader : public FormatHandlerState
 {
@@ -16,28 +16,20 @@ public:
     Graph6Reader();
     // does the action IO, it uses graph6 format defined by Brendan McKay.
     void doIO();
-    IntegerMatrix constructIntegerMatrix(unsigned numberOfNodes, BitVector bitVector);
+    /* decodes one graph (the characters of one line, without the header and the '\n') and adds it's nodes and edges
+       to the builder, throws FileIOEx if the characters end before the graph does */
+    void decodeGraph(const char* begin, const char* end, GraphBuilder& builder) const;
     string getDescription() const {return description();}
     string getExtension() const {return extention();}
     static string extention() {return "g6";}
+    FormatHandlerState* clone() const {return new Graph6Reader();}
+    bool canRead(const char* begin, const char* end) const;
     static string description() { return "Graph 6 fileformat as defined by Brendan McKay";}
 private:
-    // returns true if the _charStream has a valid header
-    bool validateHeader();
-    // reads the file and puts the characters(bytes) into _charStream
-    void prepareCharStream();
-    // read the number of nodes
-    unsigned readNumberOfNodes();
-    // reads from _index to EOF or until '\n' is found and returns the bitvector read (taking only 6 bits of each byte)
-    BitVector prepareBitVector();
-    // reset membervariables so that when we want to reuse the class for loading another file, there will be no problems
-    void resetMembers();
+    // returns the position after the header, the header is optional. throws FileIOEx if the header is invalid
+    const char* skipHeader(const char* begin, const char* end) const;
     // header, this is tested for when reading a graph6 file format
     string _header;
-    // the string of characters(bytes) in the file is first read to the _charStream for later processing, note that the EOF character is not saved in the list
-    vector<char> _charStream;
-    // integer to keep track to where we have processed the _charStream
-    unsigned _index;
 };
 
 #endif // GRAPH6READER_H
@@ -13,15 +13,14 @@ void Graph6Writer::doIO()
     assert(_graphPointer);
     // filename can't be empty
     assert(!_fileName.empty());
-    // the graph
-    IntegerMatrix integerMatrix = _graphPointer->getIntegerMatrix();
-    vector<vector<unsigned> > matrix = integerMatrix.getMatrix();
-    integerMatrix.toUndirected();
+    // the graph, graph6 only knows undirected graphs
+    SparseMatrix sparseMatrix = _graphPointer->getSparseMatrix();
+    sparseMatrix.toUndirected();
     // from this point we can work with the toptriangular part of matrix to construct the bitvector that will eventually be written out
-    BitVector bitVector = constructBitvector(matrix);
+    BitVector bitVector = constructBitvector(sparseMatrix);
     // pad up to multiples of 6
     bitVector.padR();
-    string graph = prepareString(bitVector, integerMatrix.getNumberOfNodes());
+    string graph = prepareString(bitVector, sparseMatrix.getNumberOfNodes());
     // open a filestream
     fstream fileStream(_fileName.c_str(), ios::out);
     // the format is defined so that after the header there is no linebreak
@@ -30,7 +29,7 @@ void Graph6Writer::doIO()
     fileStream.close();
 }
 
-string Graph6Writer::prepareString(BitVector bitVector, unsigned numberOfnodes)
+string Graph6Writer::prepareString(const BitVector& bitVector, unsigned numberOfnodes)
 {
     // the graph is saved as a string starting with the number of nodes
     string result;
@@ -39,18 +38,27 @@ string Graph6Writer::prepareString(BitVector bitVector, unsigned numberOfnodes)
     for (unsigned i = 0; i < encodeN.size(); ++i)
         result += encodeN[i];
     // add the edges
-    for (unsigned i = 0; i < bitVector.size(); i += 6)
-       result += (char)(bitVector.getIntBit(i, 6) + 63);
+    bitVector.writeSixBitGroups(result);
     return result;
 }
 
-BitVector Graph6Writer::constructBitvector(vector<vector<unsigned> >& matrix)
+BitVector Graph6Writer::constructBitvector(const SparseMatrix& sparseMatrix)
 {
     BitVector bitVector;
-    for (unsigned i = 0; i < matrix.size(); ++i)
-        for (unsigned j = 0; j < matrix[0].size() && j < i; ++j)
-            // we can just use the integers  as booleans, this is so because graph6 doesn't support multiple edges
-             bitVector.appendBit(matrix[j][i]);
+    const vector<unsigned>& offsets = sparseMatrix.getOffsets();
+    const vector<SparseMatrix::Cell>& cells = sparseMatrix.getCells();
+    unsigned numberOfNodes = sparseMatrix.getNumberOfNodes();
+    // all the bits are 0 except for the edges, the zeros are added a word at a time
+    bitVector.resize(size_t(numberOfNodes) * (numberOfNodes - (numberOfNodes ? 1 : 0)) / 2);
+    // the matrix is symmetric, so column i of the top triangle is the part of row i before the diagonal
+    size_t columnStart = 0;
+    for (unsigned i = 0; i < numberOfNodes; ++i)
+    {
+        // graph6 doesn't support multiple edges, each cell is a 1 bit
+        for (unsigned k = offsets[i]; k < offsets[i + 1] && cells[k].column < i; ++k)
+            bitVector.setBit(columnStart + cells[k].column);
+        columnStart += i;
+    }
     return bitVector;
 }
 
@@ -64,11 +72,11 @@ vector<char> Graph6Writer::encodeNumberOfNodes(unsigned number)
     {
         // the first characer is 126
         result.push_back(126);
+        // followed by the 18 bits of the number in 3 groups of 6 bits, the most significant group first
         BitVector tempVector(number);
-        tempVector.padL(18);
-        result.push_back(tempVector.getIntBit(0, 6));
-        result.push_back(tempVector.getIntBit(6, 6));
-        result.push_back(tempVector.getIntBit(12, 6));
+        result.push_back(tempVector.getIntBit(0, 6) + 63);
+        result.push_back(tempVector.getIntBit(6, 6) + 63);
+        result.push_back(tempVector.getIntBit(12, 6) + 63);
     }
     return result;
 }
@@ -7,7 +7,7 @@
 
 #include "formathandlerstate.h"
 #include "fileIO/bitvector.h"
-#include "fileIO/bitvector.h"
+#include "graph/sparsematrix.h"
 
 class Graph6Writer : public FormatHandlerState
 {
@@ -18,12 +18,13 @@ public:
     string getDescription() const {return description();}
     string getExtension() const {return extention();}
     static string extention() {return "g6";}
+    FormatHandlerState* clone() const {return new Graph6Writer();}
     static string description() { return "Graph 6 fileformat as defined by Brendan McKay";}
 private:
     // helpfunction
-    BitVector constructBitvector(vector<vector<unsigned> >& matrix);
+    BitVector constructBitvector(const SparseMatrix& sparseMatrix);
     vector<char> encodeNumberOfNodes(unsigned number);
-    string prepareString(BitVector bitVector, unsigned numberOfnodes);
+    string prepareString(const BitVector& bitVector, unsigned numberOfnodes);
     string _header;
 };
 
@@ -1,141 +1,165 @@
+#include <cctype>
+#include <cstring>
+
 #include "graphmlreader.h"
-#include <iostream>
-#include <QDebug>
 #include <QFile>
-#include "graph/hybridgraph.h"
+#include <QXmlStreamReader>
 #include "graph/graphComp/node.h"
-#include "graph/graphComp/rgb.h"
+#include "exception/fileioex.h"
 
 GraphMLReader::GraphMLReader()
 {
     _graphPointer = NULL;
 }
 
-void GraphMLReader::initFile()
+void GraphMLReader::readNode(QXmlStreamReader& xml, GraphBuilder& builder)
 {
-    // open and read file - document init
-    QFile file(QString::fromStdString(_fileName));
-    if (!file.open(QIODevice::ReadOnly))
-        return;
-    if (!_doc.setContent(&file)) {
-        file.close();
-        return;
-    }
-    // rename graph correctly
-    _graphPointer->setName(_doc.documentElement().firstChildElement("graph").attribute("id").toStdString());
-}
-
-void GraphMLReader::addNodes()
-{
-    // id used for map
-    int id = 0;
-
-    // fetch all "node" elements
-    QDomNodeList nodeList = _doc.elementsByTagName("node");
-    for (int i = 0; i < nodeList.size(); ++i)
+    QString id = xml.attributes().value("id").toString();
+    QString label = "";
+    int x=0, y=0, r=0 ,g=0, b=0;
+    // run through all children (key nodes) and fill in the correct key variables
+    while (xml.readNextStartElement())
     {
-        QString label = "";
-        int x=0, y=0, r=0 ,g=0, b=0;
-        // run through all children (key nodes) and fill in the correct key variables
-        QDomNode n = nodeList.item(i).firstChild();
-        while (!n.isNull())
+        if (xml.name() != QLatin1String("data"))
         {
-            if (n.isElement())
-            {
-                QDomElement e = n.toElement();
-
-                if (e.attribute("key") == "x")
-                    x = e.text().toInt();
-
-                else if (e.attribute("key") == "y")
-                    y = e.text().toInt();
+            xml.skipCurrentElement();
+            continue;
+        }
+        QString key = xml.attributes().value("key").toString();
+        // reads up to the end of the data element
+        QString text = xml.readElementText();
 
-                else if (e.attribute("key") == "r")
-                    r = e.text().toInt();
+        if (key == QLatin1String("x"))
+            x = text.toInt();
 
-                else if (e.attribute("key") == "g")
-                    g = e.text().toInt();
+        else if (key == QLatin1String("y"))
+            y = text.toInt();
 
-                else if (e.attribute("key") == "b")
-                    b = e.text().toInt();
+        else if (key == QLatin1String("r"))
+            r = text.toInt();
 
-                else if (e.attribute("key") == "label")
-                    label = e.text();
+        else if (key == QLatin1String("g"))
+            g = text.toInt();
 
-            }
-            n = n.nextSibling();
-        }
-
-        // add the node
-        _graphPointer->addNode(Node(label.toStdString(), Point(x, y), RGB(r,g,b)));
-        _map.insert(nodeList.item(i).toElement().attribute("id"), id);
-        id++;
+        else if (key == QLatin1String("b"))
+            b = text.toInt();
 
+        else if (key == QLatin1String("label"))
+            label = text;
     }
+
+    // add the node, the map keeps it's position in the builder
+    unsigned index = builder.addNode(Node(label.toStdString(), Point(x, y), RGB(r,g,b)));
+    _map.insert(id, index);
 }
 
-void GraphMLReader::addEdges()
+void GraphMLReader::readEdge(QXmlStreamReader& xml, GraphBuilder& builder)
 {
-    // target, source and label used for adding edges
-    QString tar, source, label;
-    // current edge
-    QDomNode current;
-
-    // fetch all edge elements
-    QDomNodeList edgeList = _doc.elementsByTagName("edge");
-
+    // fetch target and source for current edge element
+    QString source = xml.attributes().value("source").toString();
+    QString target = xml.attributes().value("target").toString();
+    QString label;
     // rgb values
     int r=0 ,g=0, b=0;
 
-    // add edges one by one using the id map
-    for (int i = 0; i < edgeList.size(); ++i)
+    // run through all children (key nodes) and fill in the correct key variables
+    while (xml.readNextStartElement())
     {
-        current = edgeList.item(i);
-
-        // run through all children (key nodes) and fill in the correct key variables
-        QDomNode n = current.firstChild();
-        while (!n.isNull())
+        if (xml.name() != QLatin1String("data"))
         {
+            xml.skipCurrentElement();
+            continue;
+        }
+        QString key = xml.attributes().value("key").toString();
+        QString text = xml.readElementText();
 
-            if (n.isElement())
-            {
-                QDomElement e = n.toElement();
-                if (e.attribute("key") == "label")
-                    label = e.text();
-
-                else if (e.attribute("key") == "r")
-                    r = e.text().toInt();
-
-                else if (e.attribute("key") == "g")
-                    g = e.text().toInt();
+        if (key == QLatin1String("label"))
+            label = text;
 
-                else if (e.attribute("key") == "b")
-                    b = e.text().toInt();
-            }
+        else if (key == QLatin1String("r"))
+            r = text.toInt();
 
-            n = n.nextSibling();
+        else if (key == QLatin1String("g"))
+            g = text.toInt();
 
-        }
-
-        // fetch target and source for current edge element
-        tar = current.toElement().attribute("target");
-        source = current.toElement().attribute("source");
-        // add edge
-        const vector<Node*>& nodes = _graphPointer->getNodes();
-        _graphPointer->addEdge(Edge(nodes[(unsigned int)_map.value(source)], nodes[(unsigned int)_map.value(tar)], label.toStdString(), RGB(r,g,b)));
+        else if (key == QLatin1String("b"))
+            b = text.toInt();
+    }
 
+    // add edge, if one of the nodes comes later in the file the edge is added at the end
+    if (_map.contains(source) && _map.contains(target))
+        builder.addEdge(_map.value(source), _map.value(target), label.toStdString(), RGB(r,g,b));
+    else
+    {
+        PendingEdge edge;
+        edge.source = source;
+        edge.target = target;
+        edge.label = label.toStdString();
+        edge.rgb = RGB(r,g,b);
+        _pendingEdges.push_back(edge);
     }
+}
+
+void GraphMLReader::addPendingEdges(GraphBuilder& builder)
+{
+    for (unsigned i = 0; i < _pendingEdges.size(); ++i)
+        builder.addEdge(getNodeIndex(_pendingEdges[i].source), getNodeIndex(_pendingEdges[i].target), _pendingEdges[i].label, _pendingEdges[i].rgb);
+    _pendingEdges.clear();
+}
 
+unsigned GraphMLReader::getNodeIndex(const QString& id) const
+{
+    QHash<QString, unsigned>::const_iterator it = _map.constFind(id);
+    if (it == _map.constEnd())
+        throw FileIOEx(_fileName, "an edge refers to the node " + id.toStdString() + " which doesn't exist");
+    return it.value();
 }
 
 void GraphMLReader::doIO()
 {
-    // STEP 1: load the file and initialize the dom document
-    initFile();
+    // STEP 1: open the file, the file is streamed so it's never loaded completely
+    QFile file(QString::fromStdString(_fileName));
+    if (!file.open(QIODevice::ReadOnly))
+        throw FileIOEx(_fileName, "the file can't be opened");
+    QXmlStreamReader xml(&file);
+    _map.clear();
+    _pendingEdges.clear();
+    GraphBuilder builder;
+    string name;
+
+    // STEP 2: add the nodes and edges in the order in which they are in the file, the map gives the proper id's
+    while (!xml.atEnd())
+    {
+        if (xml.readNext() != QXmlStreamReader::StartElement)
+            continue;
+        if (xml.name() == QLatin1String("node"))
+            readNode(xml, builder);
+        else if (xml.name() == QLatin1String("edge"))
+            readEdge(xml, builder);
+        // rename graph correctly, only the first graph in the file gives the name
+        else if (xml.name() == QLatin1String("graph") && name.empty())
+            name = xml.attributes().value("id").toString().toStdString();
+    }
+    if (xml.hasError())
+        throw FileIOEx(_fileName, "line " + Label(int(xml.lineNumber())).getLabelString() + ": " + xml.errorString().toStdString());
+
+    // STEP 3: add the edges that came before their nodes
+    addPendingEdges(builder);
 
-    // STEP 2: add all nodes, initialize the map so we can properly add the edges
-    addNodes();
+    // STEP 4: the graph is changed (and it's observers notified) once
+    builder.commit(*_graphPointer);
+    _graphPointer->setName(name);
+}
 
-    // STEP 3: add all the edges using the map for the proper id's
-    addEdges();
+bool GraphMLReader::canRead(const char* begin, const char* end) const
+{
+    // skip the byte order mark of utf-8 and the spaces in front of the xml declaration or the graphml element
+    if (end - begin >= 3 && memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+        begin += 3;
+    while (begin != end && isspace(static_cast<unsigned char>(*begin)))
+        ++begin;
+    static const char declaration[] = "<?xml";
+    static const char element[] = "<graphml";
+    return (size_t(end - begin) >= sizeof(declaration) - 1 && memcmp(begin, declaration, sizeof(declaration) - 1) == 0)
+            || (size_t(end - begin) >= sizeof(element) - 1 && memcmp(begin, element, sizeof(element) - 1) == 0);
 }
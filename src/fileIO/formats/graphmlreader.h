@@ -4,30 +4,49 @@
 #define GRAPHMLREADER_H
 
 #include "formathandlerstate.h"
+#include "graph/graphbuilder.h"
+#include "graph/graphComp/rgb.h"
+#include <vector>
 #include <QHash>
-#include <QtXml>
+#include <QString>
 
+class QXmlStreamReader;
 
 class GraphMLReader : public FormatHandlerState
 {
 public:
     GraphMLReader();
+    // reads the file in one pass with a QXmlStreamReader, throws FileIOEx if the file can't be read or isn't valid
     void doIO();
     string getDescription() const { return description(); }
     string getExtension() const { return extention(); }
     static string extention() {return "xml";}
+    FormatHandlerState* clone() const {return new GraphMLReader();}
+    bool canRead(const char* begin, const char* end) const;
     static string description() { return "XML-based file format";}
 
 
 private:
-    // xml doc we will load in
-    QDomDocument _doc;
-    // maps node id to label name
-    QHash<QString, int> _map;
-
-    void initFile();
-    void addNodes();
-    void addEdges();
+    // an edge of which the source or target node hasn't been read yet, graphml allows the nodes after the edges
+    struct PendingEdge
+    {
+        QString source;
+        QString target;
+        Label label;
+        RGB rgb;
+    };
+
+    // maps node id to the position of the node in the builder
+    QHash<QString, unsigned> _map;
+    vector<PendingEdge> _pendingEdges;
+
+    // the nodes and edges are read while the file is streamed and collected in the builder, the graph gets them all at once
+    void readNode(QXmlStreamReader& xml, GraphBuilder& builder);
+    void readEdge(QXmlStreamReader& xml, GraphBuilder& builder);
+    // adds the edges of which a node was missing while they were read
+    void addPendingEdges(GraphBuilder& builder);
+    // returns the position of the node in the builder, throws FileIOEx if there is no node with the id
+    unsigned getNodeIndex(const QString& id) const;
 
 };
 
@@ -1,215 +1,106 @@
 #include "graphmlwriter.h"
-#include <QTextStream>
-#include <iostream>
+#include <QFile>
+#include <QXmlStreamWriter>
 #include <vector>
 #include <assert.h>
 #include "graph/graphComp/node.h"
 #include "graph/graphComp/edge.h"
 #include "graph/graphComp/point.h"
+#include "exception/fileioex.h"
 
 GraphMLWriter::GraphMLWriter()
 {
     _graphPointer = NULL;
 }
 
-int GraphMLWriter::getNodeID(Node *node) const
+void GraphMLWriter::writeKey(QXmlStreamWriter& xml, const char* id, const char* forType, const char* type)
 {
-    vector<Node*> nodes = _graphPointer->getNodes();
-    for (unsigned i = 0; i < nodes.size(); ++i)
-    {
-        if (nodes[i] == node)
-            return i;
-    }
-    return -1;
+    xml.writeStartElement("key");
+    xml.writeAttribute("id", id);
+    xml.writeAttribute("for", forType);
+    xml.writeAttribute("attr.name", id);
+    xml.writeAttribute("attr.type", type);
+    xml.writeEndElement();
 }
 
-void GraphMLWriter::initDomDocument()
+void GraphMLWriter::writeData(QXmlStreamWriter& xml, const char* key, const QString& value)
+{
+    xml.writeStartElement("data");
+    xml.writeAttribute("key", key);
+    xml.writeCharacters(value);
+    xml.writeEndElement();
+}
+
+void GraphMLWriter::writeHeader(QXmlStreamWriter& xml)
 {
-    // clear the _doc, needed when we save two times (or more) in one run
-    _doc.clear();
-    // create dom document and create the key values
     // root element
-    QDomElement root = _doc.createElement("graphml");
+    xml.writeStartElement("graphml");
     // set namespace
-    root.setAttribute("xmlns", "http://graphml.graphdrawing.org/xmlns");
-    _doc.appendChild(root);
+    xml.writeAttribute("xmlns", "http://graphml.graphdrawing.org/xmlns");
 
     // key elements: defining special properties for our graphs
     // node and edge labels
-    QDomElement keyLabel = _doc.createElement("key");
-    keyLabel.setAttribute("id", "label");
-    keyLabel.setAttribute("for", "all");
-    keyLabel.setAttribute("attr.name", "label");
-    keyLabel.setAttribute("attr.type", "string");
-    root.appendChild(keyLabel);
-    // node x coord
-    QDomElement keyX = _doc.createElement("key");
-    keyX.setAttribute("id", "x");
-    keyX.setAttribute("for", "node");
-    keyX.setAttribute("attr.name", "x");
-    keyX.setAttribute("attr.type", "float");
-    root.appendChild(keyX);
-    // node y coord
-    QDomElement keyY = _doc.createElement("key");
-    keyY.setAttribute("id", "y");
-    keyY.setAttribute("for", "node");
-    keyY.setAttribute("attr.name", "y");
-    keyY.setAttribute("attr.type", "float");
-    root.appendChild(keyY);
+    writeKey(xml, "label", "all", "string");
+    // node coords
+    writeKey(xml, "x", "node", "float");
+    writeKey(xml, "y", "node", "float");
     // node color
-    // r
-    QDomElement keyR = _doc.createElement("key");
-    keyR.setAttribute("id", "r");
-    keyR.setAttribute("for", "node");
-    keyR.setAttribute("attr.name", "r");
-    keyR.setAttribute("attr.type", "int");
-    root.appendChild(keyR);
-    // g
-    QDomElement keyG = _doc.createElement("key");
-    keyG.setAttribute("id", "g");
-    keyG.setAttribute("for", "node");
-    keyG.setAttribute("attr.name", "g");
-    keyG.setAttribute("attr.type", "int");
-    root.appendChild(keyG);
-    // b
-    QDomElement keyB = _doc.createElement("key");
-    keyB.setAttribute("id", "b");
-    keyB.setAttribute("for", "node");
-    keyB.setAttribute("attr.name", "b");
-    keyB.setAttribute("attr.type", "int");
-    root.appendChild(keyB);
+    writeKey(xml, "r", "node", "int");
+    writeKey(xml, "g", "node", "int");
+    writeKey(xml, "b", "node", "int");
 
-    // graph element
-    QDomElement graph = _doc.createElement("graph");
+    // graph element, closed after the edges
+    xml.writeStartElement("graph");
     // root attribute edgedefault: our graphs are always directed
-    graph.setAttribute("edgedefault", "directed");
+    xml.writeAttribute("edgedefault", "directed");
     // root attribute id: name of graph
-    graph.setAttribute("id", QString::fromStdString(_graphPointer->getName()));
-    root.appendChild(graph);
-
-
+    xml.writeAttribute("id", QString::fromStdString(_graphPointer->getName()));
 }
 
-void GraphMLWriter::addNodes()
+void GraphMLWriter::writeNodes(QXmlStreamWriter& xml)
 {
-    // fetch graph element
-    QDomElement graph = _doc.documentElement().firstChildElement("graph");
-
-    vector<Node*> nodes = _graphPointer->getNodes();
+    const vector<Node*>& nodes = _graphPointer->getNodes();
     unsigned bound = _graphPointer->getNumberOfNodes();
-    // add all nodes
+    // the id of a node is it's index
     for (unsigned i = 0; i < bound; ++i)
     {
-        QDomElement n = _doc.createElement("node");
-        n.setAttribute("id", getNodeID(nodes[i]));
-
-        // add key data: node label
-        QDomElement nodeLabel = _doc.createElement("data");
-        nodeLabel.setAttribute("key", "label");
-        QDomText labelt = _doc.createTextNode(QString::fromStdString(nodes[i]->getLabel().getLabelString()));
-        nodeLabel.appendChild(labelt);
-        n.appendChild(nodeLabel);
-
-        // add key data: node position - x
-        QDomElement nodeX = _doc.createElement("data");
-        nodeX.setAttribute("key", "x");
-        QDomText xt = _doc.createTextNode(QString::number(nodes[i]->getCoords().getX()));
-        nodeX.appendChild(xt);
-        n.appendChild(nodeX);
-        // add key data: node position - y
-        QDomElement nodeY = _doc.createElement("data");
-        nodeY.setAttribute("key", "y");
-        QDomText yt = _doc.createTextNode(QString::number(nodes[i]->getCoords().getY()));
-        nodeY.appendChild(yt);
-        n.appendChild(nodeY);
-
-        // add key data: node color
-        // r
-        QDomElement nodeR = _doc.createElement("data");
-        nodeR.setAttribute("key", "r");
-        QDomText rt = _doc.createTextNode(QString::number(nodes[i]->getColor().getRed()));
-        nodeR.appendChild(rt);
-        n.appendChild(nodeR);
-        // g
-        QDomElement nodeG = _doc.createElement("data");
-        nodeG.setAttribute("key", "g");
-        QDomText gt = _doc.createTextNode(QString::number(nodes[i]->getColor().getGreen()));
-        nodeG.appendChild(gt);
-        n.appendChild(nodeG);
-        // b
-        QDomElement nodeB = _doc.createElement("data");
-        nodeB.setAttribute("key", "b");
-        QDomText bt = _doc.createTextNode(QString::number(nodes[i]->getColor().getBlue()));
-        nodeB.appendChild(bt);
-        n.appendChild(nodeB);
-
-        // add final node to xml
-        graph.appendChild(n);
+        xml.writeStartElement("node");
+        xml.writeAttribute("id", QString::number(i));
+        // add key data: node label, position and color
+        writeData(xml, "label", QString::fromStdString(nodes[i]->getLabel().getLabelString()));
+        writeData(xml, "x", QString::number(nodes[i]->getCoords().getX()));
+        writeData(xml, "y", QString::number(nodes[i]->getCoords().getY()));
+        writeData(xml, "r", QString::number(nodes[i]->getColor().getRed()));
+        writeData(xml, "g", QString::number(nodes[i]->getColor().getGreen()));
+        writeData(xml, "b", QString::number(nodes[i]->getColor().getBlue()));
+        xml.writeEndElement();
     }
-
 }
 
-void GraphMLWriter::addEdges()
+bool GraphMLWriter::WriteEdge::operator()(Edge* edge)
 {
-    // fetch graph element
-    QDomElement graph = _doc.documentElement().firstChildElement("graph");
+    _xml.writeStartElement("edge");
+    _xml.writeAttribute("source", QString::number(_source));
+    _xml.writeAttribute("target", QString::number(_graph.nodeToIndex(edge->getTarget())));
+    // add key data: edge color and label
+    writeData(_xml, "r", QString::number(edge->getColor().getRed()));
+    writeData(_xml, "g", QString::number(edge->getColor().getGreen()));
+    writeData(_xml, "b", QString::number(edge->getColor().getBlue()));
+    writeData(_xml, "label", QString::fromStdString(edge->getLabel().getLabelString()));
+    _xml.writeEndElement();
+    return true;
+}
 
-    vector<Node*> nodes = _graphPointer->getNodes();
+void GraphMLWriter::writeEdges(QXmlStreamWriter& xml)
+{
+    const vector<Node*>& nodes = _graphPointer->getNodes();
     unsigned bound = _graphPointer->getNumberOfNodes();
-
-    // add all edges
+    // the edges are written while the graph walks over them, no lists are built
     for (unsigned i = 0; i < bound; ++i)
     {
-        list<Edge*> edges = _graphPointer->getOutgoingEdges(nodes[i]);
-        for (list<Edge*>::const_iterator j = edges.begin(); j != edges.end(); ++j)
-        {
-            QDomElement e = _doc.createElement("edge");
-            e.setAttribute("source", getNodeID((*j)->getSource()));
-            e.setAttribute("target", getNodeID((*j)->getTarget()));
-
-            // add key data: edge color
-            // r
-            QDomElement edgeR = _doc.createElement("data");
-            edgeR.setAttribute("key", "r");
-            QDomText rt = _doc.createTextNode(QString::number((*j)->getColor().getRed()));
-            edgeR.appendChild(rt);
-            e.appendChild(edgeR);
-            // g
-            QDomElement edgeG = _doc.createElement("data");
-            edgeG.setAttribute("key", "g");
-            QDomText gt = _doc.createTextNode(QString::number((*j)->getColor().getGreen()));
-            edgeG.appendChild(gt);
-            e.appendChild(edgeG);
-            // b
-            QDomElement edgeB = _doc.createElement("data");
-            edgeB.setAttribute("key", "b");
-            QDomText bt = _doc.createTextNode(QString::number((*j)->getColor().getBlue()));
-            edgeB.appendChild(bt);
-            e.appendChild(edgeB);
-
-            // add key data: edge label
-            QDomElement edgeLabel = _doc.createElement("data");
-            edgeLabel.setAttribute("key", "label");
-            QDomText t = _doc.createTextNode(QString::fromStdString((*j)->getLabel().getLabelString()));
-            edgeLabel.appendChild(t);
-            e.appendChild(edgeLabel);
-            graph.appendChild(e);
-        }
+        WriteEdge writeEdge(*_graphPointer, xml, i);
+        _graphPointer->forEachOutgoingEdge(nodes[i], writeEdge);
     }
-
-}
-
-void GraphMLWriter::writeToFile()
-{
-    QString xml = _doc.toString();
-
-    QFile data(QString::fromStdString(_fileName));
-    QTextStream out(&data);
-    if (data.open(QFile::WriteOnly | QFile::Truncate)) {
-        out << "<?xml version=\"1.0\"?>" << endl;
-        out << xml;
-    }
-
 }
 
 void GraphMLWriter::doIO()
@@ -217,15 +108,25 @@ void GraphMLWriter::doIO()
     // make sure _graphPointer is set
     assert(_graphPointer != NULL);
 
-    // STEP 1: init XML doc: (namespace and key values)
-    initDomDocument();
+    // STEP 1: open the file, QFile buffers the output of the writer
+    QFile file(QString::fromStdString(_fileName));
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        throw FileIOEx(_fileName, "the file can't be opened for writing");
+    QXmlStreamWriter xml(&file);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+
+    // STEP 2: the namespace and key values
+    writeHeader(xml);
 
-    // STEP 2: add the nodes (with matching key values)
-    addNodes();
+    // STEP 3: the nodes (with matching key values)
+    writeNodes(xml);
 
-    // STEP 3: add the edges (with matching key values)
-    addEdges();
+    // STEP 4: the edges (with matching key values)
+    writeEdges(xml);
 
-    // STEP 4: write the XML document to a file
-    writeToFile();
+    // closes the graph and graphml elements
+    xml.writeEndDocument();
+    if (xml.hasError())
+        throw FileIOEx(_fileName, "the file couldn't be written completely");
 }
@@ -4,33 +4,45 @@
 #define GRAPHMLWRITER_H
 
 #include "formathandlerstate.h"
-#include <QtXml>
+#include "graph/edgefunctor.h"
+
+class QXmlStreamWriter;
 
 class GraphMLWriter : public FormatHandlerState
 {
 public:
     GraphMLWriter();
+    // writes the nodes and edges straight to the file with a QXmlStreamWriter, throws FileIOEx if the file can't be written
     void doIO();
     string getDescription() const { return description(); }
     string getExtension() const { return extention(); }
     static string extention() {return "xml";}
+    FormatHandlerState* clone() const {return new GraphMLWriter();}
     static string description() { return "XML-based file format";}
 
 
 private:
-    // working dom document
-    QDomDocument _doc;
-
-    void initDomDocument();
-
-    void addNodes();
-
-    void addEdges();
-
-    void writeToFile();
-
-    // returns node id for the write away, -1 if given node is not a node of _graphPointer
-    int getNodeID(Node* node) const;
+    // writes each edge that the graph walks over, the index of the source is known and the target is looked up in the graph
+    class WriteEdge : public EdgeFunctor
+    {
+    public:
+        WriteEdge(const Graph& graph, QXmlStreamWriter& xml, unsigned source) : _graph(graph), _xml(xml), _source(source) {}
+        bool operator()(Edge* edge);
+    private:
+        const Graph& _graph;
+        QXmlStreamWriter& _xml;
+        unsigned _source;
+    };
+
+    // the graphml element with the key definitions and the start of the graph element
+    void writeHeader(QXmlStreamWriter& xml);
+
+    void writeNodes(QXmlStreamWriter& xml);
+
+    void writeEdges(QXmlStreamWriter& xml);
+
+    static void writeKey(QXmlStreamWriter& xml, const char* id, const char* forType, const char* type);
+    static void writeData(QXmlStreamWriter& xml, const char* key, const QString& value);
 };
 
 #endif // GRAPHMLWRITER_H
@@ -3,10 +3,10 @@
 
 #include "formathandlerstate.h"
 #include "exception/fileioex.h"
+#include "graph/graphbuilder.h"
 
-#include <vector>
+#include <string>
 
-class BitVector;
 class Sparse6Reader : public FormatHandlerState
 {
 public:
@@ -14,30 +14,17 @@ public:
     string getDescription() const {return description();}
     string getExtension() const {return extention();}
     static string extention() {return "s6";}
+    FormatHandlerState* clone() const {return new Sparse6Reader();}
+    bool canRead(const char* begin, const char* end) const;
     static string description() { return "Sparse 6 fileformat as defined by Brendan McKay";}
+    // maps the file and decodes the first graph in it
     void doIO();
-    // resets the membervariables
-    void reset();
+    /* decodes one graph (the characters of one line starting with ':', without the header and the '\n') and adds it's
+       nodes and edges to the builder, the edges are added while the groups are read */
+    void decodeGraph(const char* begin, const char* end, GraphBuilder& builder) const;
 private:
-    // will parse the groups in the integerMatrix
-    void parseGroups(const vector<pair<unsigned, unsigned> >& groups, IntegerMatrix& integerMatrix);
-    // help function for debugging that returns a string with the groups in
-    string printGroups(const vector<pair<unsigned, unsigned> >& groups);
-    /* returns a set of 1,groupSize pairs read from the bitVector,
-        every pair that has it's second equal or bigger than numberOfEdges are trimmed */
-    vector<pair< unsigned, unsigned> > getGroups(unsigned groupSize, const BitVector& bitVector, unsigned numberOfNodes);
-    // read the number of nodes from the bitvector
-    unsigned readNumberOfNodes();
-    // returns a bitvector that holds the bytes from the _charStream
-    BitVector prepareBitVector();
-    // removes the header from the charStream if there is any
-    bool removeHeader();
-    // checks and remove the ':' character at the beginning of the line
-    bool removeFrontChar();
-    // will read the file as a vector of characters in the _charStream
-    void prepareCharStream();
-    unsigned _index;
-    vector<char> _charStream;
+    // returns the position after the header, the header is optional. throws FileIOEx if the header is invalid
+    const char* skipHeader(const char* begin, const char* end) const;
     string _header;
 };
 
@@ -1,6 +1,5 @@
 #include <QDebug>
 #include <fstream>
-#include <cmath>
 
 #include "fileIO/bitvector.h"
 #include "sparse6writer.h"
@@ -17,13 +16,14 @@ void Sparse6Writer::reset()
 
 void Sparse6Writer::doIO()
 {
-    IntegerMatrix integerMatrix = _graphPointer->getIntegerMatrix();
+    SparseMatrix sparseMatrix = _graphPointer->getSparseMatrix();
     // need the undirectedVersion
-    integerMatrix.toUndirected();
-    vector<pair<unsigned, unsigned> > groups = constructGroups(integerMatrix);
+    sparseMatrix.toUndirected();
+    vector<pair<unsigned, unsigned> > groups = constructGroups(sparseMatrix);
 
-    unsigned numberOfNodes = integerMatrix.getNumberOfNodes();
-    unsigned k = ceil(log2(numberOfNodes - 1));
+    unsigned numberOfNodes = sparseMatrix.getNumberOfNodes();
+    // the number of bits of each x in the groups
+    unsigned k = BitVector::bitsFor(numberOfNodes ? numberOfNodes - 1 : 0);
 
     BitVector bitVector = constructBitvector(groups, k);
 
@@ -32,8 +32,8 @@ void Sparse6Writer::doIO()
 
     if (numberOfNodes >= 2)
     {
-        last = integerMatrix.nodeHasEdge(numberOfNodes - 1);
-        beforeLast =  integerMatrix.nodeHasEdge(numberOfNodes - 2);
+        last = sparseMatrix.nodeHasEdge(numberOfNodes - 1);
+        beforeLast =  sparseMatrix.nodeHasEdge(numberOfNodes - 2);
     }
     padUp(bitVector, numberOfNodes, k, last, beforeLast);
 
@@ -47,7 +47,7 @@ void Sparse6Writer::doIO()
     fileStream.close();
 }
 
-string Sparse6Writer::prepareString(BitVector bitVector, unsigned numberOfnodes)
+string Sparse6Writer::prepareString(const BitVector& bitVector, unsigned numberOfnodes)
 {
     // the graph is saved as a string starting with the number of nodes
     string result;
@@ -56,8 +56,7 @@ string Sparse6Writer::prepareString(BitVector bitVector, unsigned numberOfnodes)
     for (unsigned i = 0; i < encodeN.size(); ++i)
         result += encodeN[i];
     // add the edges
-    for (unsigned i = 0; i < bitVector.size(); i += 6)
-       result += (char)(bitVector.getIntBit(i, 6) + 63);
+    bitVector.writeSixBitGroups(result);
     return result;
 }
 
@@ -90,59 +89,58 @@ BitVector Sparse6Writer::constructBitvector(vector<pair<unsigned, unsigned> >& g
         // append the b[i]
         result.appendBit(groups[i].first);
         // append sizeOfGroup bits of the integer groups[i].second
-        result.appendByte(groups[i].second, sizeOfGroups);
+        result.appendBits(groups[i].second, sizeOfGroups);
     }
     return result;
 }
 
-vector<pair<unsigned, unsigned> > Sparse6Writer::constructGroups(const IntegerMatrix& integerMatrix)
+vector<pair<unsigned, unsigned> > Sparse6Writer::constructGroups(const SparseMatrix& sparseMatrix)
 {
     vector<pair<unsigned, unsigned> > group;
-    vector< vector< unsigned> > matrix = integerMatrix.getMatrix();
+    const vector<unsigned>& offsets = sparseMatrix.getOffsets();
+    const vector<SparseMatrix::Cell>& cells = sparseMatrix.getCells();
     pair<unsigned, unsigned> lastEdge;
     unsigned multiEdgecounter;
-    for (unsigned col = 0; col < matrix.size(); ++col)
-        for (unsigned row = 0; row <= col; ++row)
+    // the matrix is symmetric, only the cells up to the diagonal are visited (these are the cells that aren't 0)
+    for (unsigned col = 0; col < sparseMatrix.getNumberOfNodes(); ++col)
+        for (unsigned k = offsets[col]; k < offsets[col + 1] && cells[k].column <= col; ++k)
         {
-            // if there is at least one edge
-            if (matrix[col][row])
+            unsigned row = cells[k].column;
+            // if we are dealing with the first edge
+            if (group.empty())
             {
-                // if we are dealing with the first edge
-                if (group.empty())
+                // if the first edge is from the first node to the first node
+                if (row == 0 && col == 0)
                 {
-                    // if the first edge is from the first node to the first node
-                    if (row == 0 && col == 0)
-                    {
-                        addToGroup(0, 0, group);
-                    }
-                    else
-                    {
-                        addToGroup(0, col, group);
-                        addToGroup(0, row, group);
-                    }
+                    addToGroup(0, 0, group);
                 }
-                // 2 choices, we stay in the same col
-                else if (lastEdge.second == col)
-                {
-                    addToGroup(0, row, group);
-                    // printing happens implicitly because row is always smaller than col
-                }
-                // we change from colom
                 else
                 {
                     addToGroup(0, col, group);
                     addToGroup(0, row, group);
                 }
-                multiEdgecounter = matrix[col][row];
-                // save all the edges
-                while (multiEdgecounter > 1)
-                {
-                    multiEdgecounter--;
-                    addToGroup(0, row, group);
-                }
-                lastEdge.first = row;
-                lastEdge.second = col;
             }
+            // 2 choices, we stay in the same col
+            else if (lastEdge.second == col)
+            {
+                addToGroup(0, row, group);
+                // printing happens implicitly because row is always smaller than col
+            }
+            // we change from colom
+            else
+            {
+                addToGroup(0, col, group);
+                addToGroup(0, row, group);
+            }
+            multiEdgecounter = cells[k].multiplicity;
+            // save all the edges
+            while (multiEdgecounter > 1)
+            {
+                multiEdgecounter--;
+                addToGroup(0, row, group);
+            }
+            lastEdge.first = row;
+            lastEdge.second = col;
         }
 
     return group;
@@ -165,11 +163,11 @@ vector<char> Sparse6Writer::encodeNumberOfNodes(unsigned number)
     {
         // the first characer is 126
         result.push_back(126);
+        // followed by the 18 bits of the number in 3 groups of 6 bits, the most significant group first
         BitVector tempVector(number);
-        tempVector.padL(18);
-        result.push_back(tempVector.getIntBit(0, 6));
-        result.push_back(tempVector.getIntBit(6, 6));
-        result.push_back(tempVector.getIntBit(12, 6));
+        result.push_back(tempVector.getIntBit(0, 6) + 63);
+        result.push_back(tempVector.getIntBit(6, 6) + 63);
+        result.push_back(tempVector.getIntBit(12, 6) + 63);
     }
     return result;
 }
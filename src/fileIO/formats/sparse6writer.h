@@ -3,6 +3,7 @@
 
 #include "formathandlerstate.h"
 #include "fileIO/bitvector.h"
+#include "graph/sparsematrix.h"
 
 
 class Sparse6Writer : public FormatHandlerState
@@ -12,11 +13,12 @@ public:
     string getDescription() const {return description();}
     string getExtension() const {return extention();}
     static string extention() {return "s6";}
+    FormatHandlerState* clone() const {return new Sparse6Writer();}
     static string description() { return "Sparse 6 fileformat as defined by Brendan McKay";}
     void doIO();
 private:
     // the function R as described by Brendan McKay
-    string prepareString(BitVector bitVector, unsigned numberOfnodes);
+    string prepareString(const BitVector& bitVector, unsigned numberOfnodes);
     // returns true if the variable passed is a multiple of 2
     bool isMutipleOfTwo(unsigned numberOfNodes);
     // decides how to pad the bitvector
@@ -27,7 +29,7 @@ private:
     // purly for debugging perpouse
     string printGroups(const vector<pair<unsigned, unsigned> >& groups);
     // creates the groups as described in the analysis report
-    vector<pair<unsigned, unsigned> > constructGroups(const IntegerMatrix& integerMatrix);
+    vector<pair<unsigned, unsigned> > constructGroups(const SparseMatrix& sparseMatrix);
     // encodes the number with the N function defined by Brendan McKay
     vector<char> encodeNumberOfNodes(unsigned number);
     // resets all the member variables, the doIO() function starts with this so that it can start cleanly
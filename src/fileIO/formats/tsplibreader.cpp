@@ -1,101 +1,451 @@
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+#include <assert.h>
+
 #include "tsplibreader.h"
-#include <QFile>
-#include <QString>
+#include "fileIO/mappedfile.h"
 #include "graph/graphComp/node.h"
-#include <QDebug>
-
+#include "exception/fileioex.h"
 
 TSPLibReader::TSPLibReader()
 {
-    SUPPTYPES << "TSP" << "HAM" << "TOUR";
-    SUPPWEIGHTTYPES << "EUC_2D" << "GEO";
-    IGNORETYPES << "COMMENT" << "DIMENSION";
-}
 
+}
 
 void TSPLibReader::doIO()
 {
-    // read file
-    QFile file(QString::fromStdString(_fileName));
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return;
-    QTextStream in(&file);
+    assert(!_fileName.empty());
+    assert(_graphPointer);
+    // reset everything of a previous doIO()
+    _type = TSP;
+    _metric = DistanceMatrix::EXPLICIT;
+    _weightFormat = FULL_MATRIX;
+    _adjacencyList = false;
+    _dimension = 0;
+    _name.clear();
+    _x.clear();
+    _y.clear();
+    _displayX.clear();
+    _displayY.clear();
+    _hasWeights = false;
+    _distances = DistanceMatrix();
+    _edges.clear();
 
-    /* STEP 1: Handle the specification part of TSPLib file.
-       Every TSPLib file has a specification part and a data part.
-       We read every line one by one and validate them as following:
-       Every line looks like <keyword> : <value> where we support following pairs:
-       NAME : <string> || name of file and also name of graph
-       TYPE : <string> || with <string> TSP, HCP, TOUR
-       COMMENT : <string> || random graph content that gets ignored
-       DIMENSION : <int> || number of noes
-       EDGE_WEIGHT_TYPE : <string> || with <string> EUC_2D
-       NODE_COORD_TYPE : <string> || with <string> TWOD_COORDS, NO_COORDS
-       DISPLAY_DATA_TYPE : <string> || with <string> COORD_DISPLAY [display graph with coords] TWOD_DISPLAY [explicit coords] NO_DISPLAY
-       EOF
-    */
+    // map the file, if the file can't be opened an exception will be thrown
+    MappedFile file(_fileName);
+    Scanner scanner(file.begin(), file.end());
 
-    parseSpecification(in);
+    /* Every TSPLib file has a specification part and a data part. The specification is a list of lines <keyword> : <value>,
+       the data part is a list of sections that start with a line <keyword>_SECTION. The edges of an HCP or TOUR file are
+       added to the builder while the sections are read, the nodes are added at the end */
+    GraphBuilder builder;
+    parse(scanner, builder);
 
-    /* STEP 2: Handle the data part of the TSPLib file.
-       When we get here, we just have to add all nodes and edges to our graphs
-    */
+    if ((_type == TSP || _type == ATSP) && _metric == DistanceMatrix::EXPLICIT && !_hasWeights)
+        throw FileIOEx(_fileName, "the file has no EDGE_WEIGHT_SECTION");
+    if ((_type == TSP || _type == ATSP) && _metric != DistanceMatrix::EXPLICIT)
+    {
+        if (_x.size() != _dimension)
+            throw FileIOEx(_fileName, "the file has no NODE_COORD_SECTION");
+        _distances.setCoordinates(_metric, _x, _y);
+    }
+    addNodes(builder);
+    addEdges(builder);
+    // the graph is changed (and it's observers notified) once
+    builder.commit(*_graphPointer);
+    _graphPointer->setName(_name);
+    // the graph keeps the distances, a large instance has no edges so this is the only place they are (see Graph::getDistances)
+    if ((_type == TSP || _type == ATSP) && _graphPointer->getNumberOfNodes() == _dimension)
+        _graphPointer->setDistances(_distances);
+    _distances = DistanceMatrix();
+}
 
-    parseData(in);
+bool TSPLibReader::canRead(const char* begin, const char* end) const
+{
+    // the specification comes first, so the file starts with one of it's keywords followed by a ':'
+    static const char* keywords[] = {"NAME", "TYPE", "COMMENT", "DIMENSION", "CAPACITY", "EDGE_WEIGHT_TYPE"};
+    Scanner scanner(begin, end);
+    string keyword;
+    if (!scanner.readWord(keyword))
+        return false;
+    for (unsigned i = 0; i < sizeof(keywords) / sizeof(keywords[0]); ++i)
+        if (keyword == keywords[i])
+            return scanner.readColon();
+    return false;
+}
 
+void TSPLibReader::parse(Scanner& scanner, GraphBuilder& builder)
+{
+    string keyword;
+    while (scanner.readWord(keyword) && keyword != "EOF")
+    {
+        if (keyword.size() < 8 || keyword.compare(keyword.size() - 8, 8, "_SECTION") != 0)
+        {
+            string value = scanner.readValue();
+            parseSpecification(keyword, value, scanner);
+            continue;
+        }
+        // the sections need the dimension
+        if (_dimension == 0)
+            throwError(scanner, "the DIMENSION has to come before " + keyword);
+        // the rest of the line of the keyword (like a ':') isn't part of the data
+        scanner.readValue();
+        if (keyword == "NODE_COORD_SECTION")
+            parseCoordinates(scanner, _x, _y);
+        else if (keyword == "DISPLAY_DATA_SECTION")
+            parseCoordinates(scanner, _displayX, _displayY);
+        else if (keyword == "EDGE_WEIGHT_SECTION")
+            parseEdgeWeights(scanner);
+        else if (keyword == "EDGE_DATA_SECTION")
+            parseEdgeData(scanner, builder);
+        else if (keyword == "TOUR_SECTION")
+            parseTour(scanner, builder);
+        else if (keyword == "FIXED_EDGES_SECTION")
+            skipSection(scanner);
+        else
+            throwError(scanner, keyword + " isn't supported");
+    }
+}
+
+void TSPLibReader::parseSpecification(const string& keyword, const string& value, const Scanner& scanner)
+{
+    if (keyword == "NAME")
+        _name = value;
+    else if (keyword == "COMMENT" || keyword == "DISPLAY_DATA_TYPE")
+        return ;
+    else if (keyword == "TYPE")
+    {
+        if (value == "TSP")
+            _type = TSP;
+        else if (value == "ATSP")
+            _type = ATSP;
+        else if (value == "HCP")
+            _type = HCP;
+        else if (value == "TOUR")
+            _type = TOUR;
+        else
+            throwError(scanner, "the type " + value + " isn't supported");
+    }
+    else if (keyword == "DIMENSION")
+    {
+        int dimension = atoi(value.c_str());
+        if (dimension <= 0)
+            throwError(scanner, "invalid DIMENSION");
+        _dimension = dimension;
+        // the dimension is known before the data, everything can be allocated once
+        _x.reserve(_dimension);
+        _y.reserve(_dimension);
+    }
+    else if (keyword == "EDGE_WEIGHT_TYPE")
+    {
+        if (value == "EXPLICIT")
+            _metric = DistanceMatrix::EXPLICIT;
+        else if (value == "EUC_2D")
+            _metric = DistanceMatrix::EUC_2D;
+        else if (value == "CEIL_2D")
+            _metric = DistanceMatrix::CEIL_2D;
+        else if (value == "MAN_2D")
+            _metric = DistanceMatrix::MAN_2D;
+        else if (value == "MAX_2D")
+            _metric = DistanceMatrix::MAX_2D;
+        else if (value == "GEO")
+            _metric = DistanceMatrix::GEO;
+        else if (value == "ATT")
+            _metric = DistanceMatrix::ATT;
+        else
+            throwError(scanner, "the edge weight type " + value + " isn't supported");
+    }
+    else if (keyword == "EDGE_WEIGHT_FORMAT")
+    {
+        static const char* formats[] = {"FUNCTION", "FULL_MATRIX", "UPPER_ROW", "LOWER_ROW", "UPPER_DIAG_ROW", "LOWER_DIAG_ROW",
+                                        "UPPER_COL", "LOWER_COL", "UPPER_DIAG_COL", "LOWER_DIAG_COL"};
+        unsigned i = 0;
+        while (i < sizeof(formats) / sizeof(formats[0]) && value != formats[i])
+            ++i;
+        if (i == sizeof(formats) / sizeof(formats[0]))
+            throwError(scanner, "the edge weight format " + value + " isn't supported");
+        _weightFormat = WeightFormat(i);
+    }
+    else if (keyword == "EDGE_DATA_FORMAT")
+    {
+        if (value != "EDGE_LIST" && value != "ADJ_LIST")
+            throwError(scanner, "the edge data format " + value + " isn't supported");
+        _adjacencyList = value == "ADJ_LIST";
+    }
+    else if (keyword == "NODE_COORD_TYPE")
+    {
+        if (value != "TWOD_COORDS" && value != "NO_COORDS")
+            throwError(scanner, "the node coordinate type " + value + " isn't supported");
+    }
+    else
+        throwError(scanner, "the keyword " + keyword + " isn't supported");
 }
 
+void TSPLibReader::parseCoordinates(Scanner& scanner, vector<double>& x, vector<double>& y)
+{
+    x.assign(_dimension, 0);
+    y.assign(_dimension, 0);
+    // each line is <node> <x> <y>
+    for (unsigned k = 0; k < _dimension; ++k)
+    {
+        unsigned i = readNode(scanner);
+        x[i] = readNumber(scanner);
+        y[i] = readNumber(scanner);
+    }
+}
 
-void TSPLibReader::parseSpecification(QTextStream& in)
+void TSPLibReader::parseEdgeWeights(Scanner& scanner)
 {
-    while (!in.atEnd())
+    if (_weightFormat == FUNCTION)
+        throwError(scanner, "an EDGE_WEIGHT_SECTION needs an EDGE_WEIGHT_FORMAT");
+    _distances = DistanceMatrix(_dimension);
+    if (_weightFormat == FULL_MATRIX)
+    {
+        for (unsigned i = 0; i < _dimension; ++i)
+            for (unsigned j = 0; j < _dimension; ++j)
+                _distances.setDistance(i, j, readNumber(scanner));
+    }
+    else
     {
-        QString line = in.readLine();
-        QStringList list = line.split(" ", QString::SkipEmptyParts);
-        list.replaceInStrings(":", "");
-        list.removeAll("");
-        if (!list.empty())
+        /* the other formats are a triangle of a symmetric matrix. A triangle that is given column by column is the other
+           triangle given row by row, so each format is read as the row by row version of the upper or lower triangle */
+        bool upper = _weightFormat == UPPER_ROW || _weightFormat == UPPER_DIAG_ROW || _weightFormat == LOWER_COL || _weightFormat == LOWER_DIAG_COL;
+        bool diagonal = _weightFormat == UPPER_DIAG_ROW || _weightFormat == LOWER_DIAG_ROW || _weightFormat == UPPER_DIAG_COL || _weightFormat == LOWER_DIAG_COL;
+        for (unsigned i = 0; i < _dimension; ++i)
         {
-            // check first argument to decide what to do
-            if (list.at(0) == "NAME")
-                _graphPointer->setName(list.at(1).toStdString());
-            else if (list.at(0) == "TYPE")
-                validate(list.at(1), SUPPTYPES);
-            else if (list.at(0) == "EDGE_WEIGHT_TYPE")
-                validate(list.at(1), SUPPWEIGHTTYPES);
-            else if (list.at(0) == "NODE_COORD_SECTION")
-                return;
-                // proceed to the parsing of the data
-            else
-                // we can just ignore certain specifications, such as author comments, dimension (because we just add the nodes while parsin the file)
-                validate(list.at(0), IGNORETYPES);
+            unsigned first = upper ? (diagonal ? i : i + 1) : 0;
+            unsigned last = upper ? _dimension : (diagonal ? i + 1 : i);
+            for (unsigned j = first; j < last; ++j)
+            {
+                float distance = readNumber(scanner);
+                _distances.setDistance(i, j, distance);
+                _distances.setDistance(j, i, distance);
+            }
         }
     }
+    _hasWeights = true;
 }
 
-void TSPLibReader::parseData(QTextStream& in)
+void TSPLibReader::parseEdgeData(Scanner& scanner, GraphBuilder& builder)
 {
-    while (!in.atEnd())
+    // the edges of an HCP graph are undirected, they are added in both directions
+    if (!_adjacencyList)
     {
-        QString line = in.readLine();
-        if (line == "EOF")
-            return;
-        QStringList list = line.split(" ", QString::SkipEmptyParts);
-        // we can only read node info now
-        _graphPointer->addNode(Node(Label(list.at(0).toStdString()), Point(list.at(1).toFloat(), -list.at(2).toFloat())));
+        // EDGE_LIST: pairs of nodes, terminated by -1
+        double number;
+        while ((number = readNumber(scanner)) != -1)
+        {
+            unsigned source = toNode(scanner, number);
+            unsigned target = readNode(scanner);
+            addEdge(builder, source, target);
+        }
+        return ;
+    }
+    // ADJ_LIST: a node followed by it's neighbours and -1, the list is terminated by another -1
+    double number;
+    while ((number = readNumber(scanner)) != -1)
+    {
+        unsigned source = toNode(scanner, number);
+        while ((number = readNumber(scanner)) != -1)
+        {
+            unsigned target = toNode(scanner, number);
+            addEdge(builder, source, target);
+        }
     }
+}
 
+void TSPLibReader::parseTour(Scanner& scanner, GraphBuilder& builder)
+{
+    // the nodes of the tour are terminated by -1, each node gets an edge to the next and the last one to the first
+    double number = readNumber(scanner);
+    if (number == -1)
+        return ;
+    unsigned first = toNode(scanner, number);
+    unsigned previous = first;
+    // a tour visits each node once, a node that comes back would give an edge that's there already
+    vector<bool> visited(_dimension, false);
+    visited[first] = true;
+    while ((number = readNumber(scanner)) != -1)
+    {
+        unsigned node = toNode(scanner, number);
+        if (visited[node])
+            throwError(scanner, "node " + Label(int(number)).getLabelString() + " is in the tour more than once");
+        visited[node] = true;
+        builder.addEdge(previous, node);
+        previous = node;
+    }
+    if (previous != first)
+        builder.addEdge(previous, first);
+    // a file can contain more tours, only the first one is drawn
+    double ignored;
+    while (scanner.readNumber(ignored))
+        ;
 }
 
+void TSPLibReader::addEdge(GraphBuilder& builder, unsigned source, unsigned target)
+{
+    unsigned long long key = (static_cast<unsigned long long>(min(source, target)) << 32) | max(source, target);
+    if (_edges.contains(key))
+        return ;
+    _edges.insert(key, true);
+    builder.addEdge(source, target);
+    // a self-loop is only added once
+    if (source != target)
+        builder.addEdge(target, source);
+}
+
+void TSPLibReader::skipSection(Scanner& scanner)
+{
+    while (readNumber(scanner) != -1)
+        ;
+}
+
+double TSPLibReader::readNumber(Scanner& scanner)
+{
+    double number;
+    if (!scanner.readNumber(number))
+        throwError(scanner, scanner.atEnd() ? "unexpected end of the file" : "expected a number");
+    return number;
+}
+
+unsigned TSPLibReader::readNode(Scanner& scanner)
+{
+    return toNode(scanner, readNumber(scanner));
+}
 
-void TSPLibReader::validate(QString par, QStringList list)
+unsigned TSPLibReader::toNode(const Scanner& scanner, double number) const
 {
-    // is the type supported?
-    if (!list.contains(par))
+    if (number < 1 || number > _dimension || number != floor(number))
+        throwError(scanner, "invalid node " + Label(int(number)).getLabelString());
+    return unsigned(number) - 1;
+}
+
+void TSPLibReader::addNodes(GraphBuilder& builder)
+{
+    // the display data is meant for drawing, the node coordinates are used if there is none
+    const vector<double>& x = _displayX.empty() ? _x : _displayX;
+    const vector<double>& y = _displayY.empty() ? _y : _displayY;
+    builder.reserveNodes(_dimension);
+    for (unsigned i = 0; i < _dimension; ++i)
     {
-        qDebug() << "THE STRING " << par << " IS NOT IN THE LIST " << list;
-        exit(0);
+        // the y axis of the screen points down
+        Point point = x.empty() ? Point() : Point(int(x[i]), int(-y[i]));
+        builder.addNode(Node(Label(int(i + 1)), point));
     }
-    // replace with throw
+}
 
+void TSPLibReader::addEdges(GraphBuilder& builder)
+{
+    if ((_type != TSP && _type != ATSP) || _dimension > MAXIMUM_NODES_WITH_EDGES)
+        return ;
+    builder.reserveEdges(size_t(_dimension) * (_dimension - 1));
+    for (unsigned i = 0; i < _dimension; ++i)
+        for (unsigned j = 0; j < _dimension; ++j)
+        {
+            if (i == j || !_distances.hasEdge(i, j))
+                continue;
+            // labels are integers, explicit weights can be real numbers
+            builder.addEdge(i, j, Label(int(floor(_distances.distance(i, j) + 0.5))));
+        }
+}
+
+void TSPLibReader::throwError(const Scanner& scanner, const string& message) const
+{
+    throw FileIOEx(_fileName, "line " + Label(int(scanner.getLine())).getLabelString() + ": " + message);
+}
+
+bool TSPLibReader::Scanner::readWord(string& word)
+{
+    skipSpace(true);
+    const char* begin = _position;
+    while (_position != _end && *_position != ':' && !isspace(static_cast<unsigned char>(*_position)))
+        ++_position;
+    word.assign(begin, _position);
+    return !word.empty();
+}
+
+string TSPLibReader::Scanner::readValue()
+{
+    readColon();
+    skipSpace(false);
+    const char* begin = _position;
+    while (_position != _end && *_position != '\n')
+        ++_position;
+    const char* end = _position;
+    // the trailing spaces (and the '\r' of a windows file) aren't part of the value
+    while (end != begin && isspace(static_cast<unsigned char>(end[-1])))
+        --end;
+    return string(begin, end);
+}
+
+bool TSPLibReader::Scanner::readColon()
+{
+    skipSpace(false);
+    if (_position == _end || *_position != ':')
+        return false;
+    ++_position;
+    return true;
+}
+
+bool TSPLibReader::Scanner::readNumber(double& number)
+{
+    skipSpace(true);
+    // the number is parsed here instead of with strtod, the mapped file isn't terminated by a '\0'
+    const char* position = _position;
+    bool negative = position != _end && *position == '-';
+    if (position != _end && (*position == '-' || *position == '+'))
+        ++position;
+    double mantissa = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    for (; position != _end && isdigit(static_cast<unsigned char>(*position)); ++position, hasDigits = true)
+        mantissa = mantissa * 10 + (*position - '0');
+    if (position != _end && *position == '.')
+        for (++position; position != _end && isdigit(static_cast<unsigned char>(*position)); ++position, hasDigits = true)
+        {
+            mantissa = mantissa * 10 + (*position - '0');
+            --exponent;
+        }
+    if (!hasDigits)
+        return false;
+    if (position != _end && (*position == 'e' || *position == 'E'))
+    {
+        const char* exponentPosition = position + 1;
+        bool negativeExponent = exponentPosition != _end && *exponentPosition == '-';
+        if (exponentPosition != _end && (*exponentPosition == '-' || *exponentPosition == '+'))
+            ++exponentPosition;
+        int value = 0;
+        bool hasExponent = false;
+        for (; exponentPosition != _end && isdigit(static_cast<unsigned char>(*exponentPosition)); ++exponentPosition, hasExponent = true)
+            value = value * 10 + (*exponentPosition - '0');
+        // an 'e' without digits isn't part of the number
+        if (hasExponent)
+        {
+            exponent += negativeExponent ? -value : value;
+            position = exponentPosition;
+        }
+    }
+    // something like 12abc isn't a number
+    if (position != _end && !isspace(static_cast<unsigned char>(*position)))
+        return false;
+    number = exponent < 0 ? mantissa / pow(10.0, -exponent) : mantissa * pow(10.0, exponent);
+    if (negative)
+        number = -number;
+    _position = position;
+    return true;
+}
+
+void TSPLibReader::Scanner::skipSpace(bool newLines)
+{
+    for (; _position != _end && isspace(static_cast<unsigned char>(*_position)); ++_position)
+    {
+        if (*_position == '\n')
+        {
+            if (!newLines)
+                return ;
+            ++_line;
+        }
+    }
 }
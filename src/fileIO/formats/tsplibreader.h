@@ -1,44 +1,104 @@
 /* Author: Jeroen Vaelen
    Description: for more information relating TSPLib file formats see http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/DOC.PS
+   The types TSP, ATSP, HCP and TOUR are read. The distances of a TSP or ATSP instance are kept in a DistanceMatrix that is
+   given to the graph (see Graph::getDistances()): an EDGE_WEIGHT_SECTION in any of it's formats is stored as a dense matrix,
+   the coordinate metrics (EUC_2D, CEIL_2D, MAN_2D, MAX_2D, GEO, ATT) are computed when they are needed. The graph only gets
+   the complete set of edges (with the distances as labels) if the instance is small, the nodes get the coordinates of the file.
    */
 
 #ifndef TSPLIBREADER_H
 #define TSPLIBREADER_H
 
-/* @BALAZS en MEZELF:
-  1. We supporten niet alle keywords, wat als de user ene invoegt die we ni supporten
-  OFWEL een error throwen en tegen de user zeggen van fix uw file beke
-  OF shit ignoren en gewoon tekenen (als da gaat, als die zegt van buuuhd as 3d gaat da obv ni)
-
-  2. We tekenen atm de coords ma ik heb gemerkt da da vaak te dicht op elkaar is, hoe fixe?
-
-  3. De edges moet ik nog trekke ma das gewoon TREKKE, heb da nog ni gedaan omda ik met u die file wil bekijken van TSP
-     en dan wil interpreten van hoe we die edges trekken dan is da buh 1 regel code fzo
-  */
+#include <QHash>
 
 #include "formathandlerstate.h"
-#include <QStringList>
+#include "graph/graphbuilder.h"
+#include "graph/distancematrix.h"
 
 class TSPLibReader : public FormatHandlerState
 {
 public:
     TSPLibReader();
+    // throws FileIOEx if the file can't be read, isn't valid or uses something that isn't supported
     void doIO();
     string getDescription() const { return description(); }
     string getExtension() const { return extention(); }
     static string extention() {return "tsp";}
+    FormatHandlerState* clone() const {return new TSPLibReader();}
+    bool canRead(const char* begin, const char* end) const;
     static string description() { return "TSPLIB is a library of sample instances for the TSP (and related problems) from various "
                 "sources and of various types."; }
+    // instances with more nodes don't get edges in the graph, n^2 edges with labels take too much memory, only the distances
+    static const unsigned MAXIMUM_NODES_WITH_EDGES = 300;
 
 private:
+    // walks over the characters of the mapped file, the numbers are read without copying them
+    class Scanner
+    {
+    public:
+        Scanner(const char* begin, const char* end) : _position(begin), _end(end), _line(1) {}
+        bool atEnd() {skipSpace(true); return _position == _end;}
+        // reads a word (up to a space or ':'), returns false at the end of the file
+        bool readWord(string& word);
+        // reads the rest of the line without the ':' in front of it and without the spaces around it
+        string readValue();
+        // skips the spaces on the line and a ':', returns false if there is no ':'
+        bool readColon();
+        // reads an integer or real number, returns false if the next word isn't a number
+        bool readNumber(double& number);
+        unsigned getLine() const {return _line;}
+    private:
+        void skipSpace(bool newLines);
+        const char* _position;
+        const char* _end;
+        unsigned _line;
+    };
+
+    enum Type { TSP, ATSP, HCP, TOUR };
+    enum WeightFormat { FUNCTION, FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW,
+                        UPPER_COL, LOWER_COL, UPPER_DIAG_COL, LOWER_DIAG_COL };
 
-    QStringList SUPPTYPES;
-    QStringList SUPPWEIGHTTYPES;
-    QStringList IGNORETYPES;
+    // reads the keywords of the specification and the sections up to EOF (or the end of the file)
+    void parse(Scanner& scanner, GraphBuilder& builder);
+    void parseSpecification(const string& keyword, const string& value, const Scanner& scanner);
+    // reads a coordinate for each node, NODE_COORD_SECTION and DISPLAY_DATA_SECTION
+    void parseCoordinates(Scanner& scanner, vector<double>& x, vector<double>& y);
+    void parseEdgeWeights(Scanner& scanner);
+    void parseEdgeData(Scanner& scanner, GraphBuilder& builder);
+    void parseTour(Scanner& scanner, GraphBuilder& builder);
+    // adds the undirected edge of an HCP graph in both directions, unless the file listed it already
+    void addEdge(GraphBuilder& builder, unsigned source, unsigned target);
+    // skips a list of numbers that ends with -1 (like FIXED_EDGES_SECTION)
+    void skipSection(Scanner& scanner);
+    // reads a number that has to be there, the number of a node has to be between 1 and the dimension
+    double readNumber(Scanner& scanner);
+    unsigned readNode(Scanner& scanner);
+    // returns the index of node number, throws if it isn't a node
+    unsigned toNode(const Scanner& scanner, double number) const;
+    // creates the nodes (and the edges of a small TSP instance) once the data has been read
+    void addNodes(GraphBuilder& builder);
+    void addEdges(GraphBuilder& builder);
+    void throwError(const Scanner& scanner, const string& message) const;
 
-    void parseSpecification(QTextStream& in);
-    void parseData(QTextStream& in);
-    void validate(QString par, QStringList list);
+    Type _type;
+    DistanceMatrix::Metric _metric;
+    WeightFormat _weightFormat;
+    unsigned _dimension;
+    string _name;
+    // EDGE_DATA_FORMAT, true for ADJ_LIST and false for EDGE_LIST
+    bool _adjacencyList;
+    // the coordinates of the NODE_COORD_SECTION, used by the metrics and to draw the nodes
+    vector<double> _x;
+    vector<double> _y;
+    // the coordinates of the DISPLAY_DATA_SECTION, these are only used to draw the nodes
+    vector<double> _displayX;
+    vector<double> _displayY;
+    // true once the EDGE_WEIGHT_SECTION has been read into _distances
+    bool _hasWeights;
+    // the distances of the instance that is being read, they are handed to the graph at the end
+    DistanceMatrix _distances;
+    // the edges of an HCP graph that were added (smallest node << 32 | largest node), a file can list an edge both ways
+    QHash<unsigned long long, bool> _edges;
 };
 
 #endif // TSPLIBREADER_H
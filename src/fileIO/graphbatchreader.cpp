@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cstring>
+
+#include "graphbatchreader.h"
+#include "mappedfile.h"
+#include "sixbitstream.h"
+#include "exception/fileioex.h"
+
+// the lines are handed out in chunks of about this many bytes, so the workers don't have to lock the reader for each line
+static const size_t CHUNK_SIZE = 64 * 1024;
+
+GraphBatchReader::GraphBatchReader() : _numberOfThreads(0), _position(NULL), _end(NULL), _nextIndex(0), _failed(false)
+{
+
+}
+
+unsigned long GraphBatchReader::read(const string& fileName, GraphBatchHandler& handler)
+{
+    MappedFile file(fileName);
+    _fileName = fileName;
+    _position = file.begin();
+    _end = file.end();
+    _nextIndex = 0;
+    _failed = false;
+    _error.clear();
+
+    unsigned numberOfThreads = _numberOfThreads ? _numberOfThreads : max(QThread::idealThreadCount(), 1);
+    vector<Worker*> workers;
+    for (unsigned i = 0; i < numberOfThreads; ++i)
+        workers.push_back(new Worker(*this, handler));
+    // with one worker there is no need for a thread
+    if (numberOfThreads == 1)
+        workers[0]->process();
+    else
+    {
+        for (unsigned i = 0; i < workers.size(); ++i)
+            workers[i]->start();
+        for (unsigned i = 0; i < workers.size(); ++i)
+            workers[i]->wait();
+    }
+
+    unsigned long numberOfGraphs = 0;
+    for (unsigned i = 0; i < workers.size(); ++i)
+    {
+        handler.merge(workers[i]->getHandler());
+        numberOfGraphs += workers[i]->getNumberOfGraphs();
+        delete workers[i];
+    }
+    if (_failed)
+        throw FileIOEx(fileName, _error);
+    return numberOfGraphs;
+}
+
+bool GraphBatchReader::nextChunk(const char*& begin, const char*& end, unsigned long& index)
+{
+    QMutexLocker locker(&_mutex);
+    if (_failed || _position == _end)
+        return false;
+    begin = _position;
+    index = _nextIndex;
+    // the chunk ends after the first newline after CHUNK_SIZE bytes
+    end = begin + min(CHUNK_SIZE, size_t(_end - begin));
+    const char* newLine = static_cast<const char*>(memchr(end, '\n', _end - end));
+    end = newLine ? newLine + 1 : _end;
+    _nextIndex += count(begin, end, '\n');
+    _position = end;
+    return true;
+}
+
+void GraphBatchReader::fail(const string& error)
+{
+    QMutexLocker locker(&_mutex);
+    // only the first error is kept
+    if (!_failed)
+        _error = error;
+    _failed = true;
+}
+
+GraphBatchReader::Worker::Worker(GraphBatchReader& reader, const GraphBatchHandler& handler)
+    : _reader(reader), _handler(handler.clone()), _numberOfGraphs(0)
+{
+    _graph6Reader.setFileName(reader._fileName);
+    _sparse6Reader.setFileName(reader._fileName);
+}
+
+void GraphBatchReader::Worker::process()
+{
+    const char* begin;
+    const char* end;
+    unsigned long index;
+    while (_reader.nextChunk(begin, end, index))
+    {
+        for (const char* line = begin; line < end; ++index)
+        {
+            const char* lineEnd = SixBitStream::lineEnd(line, end);
+            try
+            {
+                if (decodeLine(line, lineEnd))
+                {
+                    _handler->handleGraph(_graph, index);
+                    ++_numberOfGraphs;
+                }
+            }
+            catch (BaseEx& e)
+            {
+                // an exception can't leave the thread, read() throws it after all the workers are finished
+                _reader.fail("line " + Label(index + 1).getLabelString() + ": " + e.getExtraInfo());
+                return ;
+            }
+            // skip the '\r' and '\n' at the end of the line
+            line = static_cast<const char*>(memchr(lineEnd, '\n', end - lineEnd));
+            line = line ? line + 1 : end;
+        }
+    }
+}
+
+bool GraphBatchReader::Worker::decodeLine(const char* begin, const char* end)
+{
+    // each line can start with the header of it's format
+    static const char graph6Header[] = ">>graph6<<";
+    static const char sparse6Header[] = ">>sparse6<<";
+    if (size_t(end - begin) >= sizeof(graph6Header) - 1 && memcmp(begin, graph6Header, sizeof(graph6Header) - 1) == 0)
+        begin += sizeof(graph6Header) - 1;
+    else if (size_t(end - begin) >= sizeof(sparse6Header) - 1 && memcmp(begin, sparse6Header, sizeof(sparse6Header) - 1) == 0)
+        begin += sizeof(sparse6Header) - 1;
+    if (begin == end)
+        return false;
+
+    _builder.clear();
+    if (*begin == ':')
+        _sparse6Reader.decodeGraph(begin, end, _builder);
+    else
+        _graph6Reader.decodeGraph(begin, end, _builder);
+    // the graph is reused, the csr arrays keep their memory
+    _graph.removeNodes();
+    _builder.commit(_graph);
+    return true;
+}
@@ -0,0 +1,94 @@
+/*
+ Author: Balazs Nemeth
+ Description: GraphBatchReader reads files that contain one graph6 or sparse6 graph on each line, like the output of nauty's geng.
+              These files can hold millions of small graphs, so the graphs aren't kept: each graph is decoded into a graph
+              that is reused for the next line and handed to a GraphBatchHandler. The file is mapped and split in chunks of
+              lines that are handed out to worker threads, each worker has it's own graph, builder and clone of the handler,
+              so the memory that is used doesn't depend on the number of graphs in the file. Usage:
+
+                PropertyBatchHandler handler(connectedVisitor);
+                GraphBatchReader reader;
+                reader.read("graphs.g6", handler);
+                handler.getNumberOfGraphs(PropertyVisitor::TRUEVAL);
+     */
+
+#ifndef GRAPHBATCHREADER_H
+#define GRAPHBATCHREADER_H
+
+#include <string>
+#include <QThread>
+#include <QMutex>
+
+#include "graph/csrgraph.h"
+#include "graph/graphbuilder.h"
+#include "fileIO/formats/graph6reader.h"
+#include "fileIO/formats/sparse6reader.h"
+
+using namespace std;
+
+class GraphBatchHandler
+{
+public:
+    virtual ~GraphBatchHandler() {}
+    // returns a new handler of the same type, each worker thread gets it's own handler so the handlers don't have to be thread safe
+    virtual GraphBatchHandler* clone() const = 0;
+    /* called for each graph in the file, index is the line of the graph in the file (starting at 0).
+       the graph is reused for the next graph of the worker, so it can't be kept */
+    virtual void handleGraph(Graph& graph, unsigned long index) = 0;
+    // adds the results of a clone of this handler to this handler, called for each clone after all the graphs have been handled
+    virtual void merge(const GraphBatchHandler& /* other */) {}
+};
+
+class GraphBatchReader
+{
+public:
+    GraphBatchReader();
+    // the number of worker threads, 0 uses one thread for each core (the default)
+    void setNumberOfThreads(unsigned numberOfThreads) {_numberOfThreads = numberOfThreads;}
+    /* reads all the graphs in the file and hands them to the handler, a line that starts with ':' is a sparse6 graph and other
+       lines are graph6 graphs. returns the number of graphs, throws FileIOEx if the file can't be read or a graph is invalid */
+    unsigned long read(const string& fileName, GraphBatchHandler& handler);
+
+private:
+    // a worker decodes and handles the lines that it gets from the reader until there are none left
+    class Worker : public QThread
+    {
+    public:
+        Worker(GraphBatchReader& reader, const GraphBatchHandler& handler);
+        ~Worker() {delete _handler;}
+        // the work of the thread, run() calls this but it can also be called directly to work in the current thread
+        void process();
+        const GraphBatchHandler& getHandler() const {return *_handler;}
+        unsigned long getNumberOfGraphs() const {return _numberOfGraphs;}
+    protected:
+        void run() {process();}
+    private:
+        // decodes the line into _graph, returns false if the line is empty
+        bool decodeLine(const char* begin, const char* end);
+
+        GraphBatchReader& _reader;
+        GraphBatchHandler* _handler;
+        CSRGraph _graph;
+        GraphBuilder _builder;
+        Graph6Reader _graph6Reader;
+        Sparse6Reader _sparse6Reader;
+        unsigned long _numberOfGraphs;
+    };
+
+    // hands out the next lines [begin, end) to a worker, index is the number of the first line. returns false if there are no lines left
+    bool nextChunk(const char*& begin, const char*& end, unsigned long& index);
+    // stops the other workers, the error is thrown by read() after all the workers are finished
+    void fail(const string& error);
+
+    unsigned _numberOfThreads;
+    string _fileName;
+    // the part of the file that hasn't been handed out yet and the number of it's first line, guarded by _mutex
+    QMutex _mutex;
+    const char* _position;
+    const char* _end;
+    unsigned long _nextIndex;
+    bool _failed;
+    string _error;
+};
+
+#endif // GRAPHBATCHREADER_H
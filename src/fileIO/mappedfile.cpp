@@ -0,0 +1,30 @@
+#include "mappedfile.h"
+#include "exception/fileioex.h"
+
+MappedFile::MappedFile(const string& fileName) : _file(QString::fromStdString(fileName)), _map(NULL), _data(NULL), _size(0)
+{
+    if (!_file.open(QIODevice::ReadOnly))
+        throw FileIOEx(fileName, "disk IO error, can't open file to read");
+    _size = _file.size();
+    // an empty file can't be mapped, there is nothing to read
+    if (_size == 0)
+        return ;
+    _map = _file.map(0, _size);
+    if (_map)
+    {
+        _data = reinterpret_cast<const char*>(_map);
+        return ;
+    }
+    // fall back to reading the whole file at once
+    _buffer.resize(_size);
+    if (_file.read(&_buffer[0], _size) != (long long)_size)
+        throw FileIOEx(fileName, "disk IO error, can't read the file");
+    _data = &_buffer[0];
+}
+
+MappedFile::~MappedFile()
+{
+    if (_map)
+        _file.unmap(_map);
+    _file.close();
+}
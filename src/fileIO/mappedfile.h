@@ -0,0 +1,42 @@
+/*
+ Author: Balazs Nemeth
+ Description: MappedFile maps a whole file into memory for reading, the readers decode straight from the mapped bytes instead of
+              copying the file into a buffer first. If the file can't be mapped (some filesystems don't support it), it is read
+              into a buffer in one call so the readers don't have to know the difference. The bytes stay valid until the
+              MappedFile is destroyed.
+     */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <QFile>
+
+using namespace std;
+
+class MappedFile
+{
+public:
+    // opens and maps the file, throws FileIOEx if the file can't be opened or read
+    MappedFile(const string& fileName);
+    ~MappedFile();
+
+    const char* begin() const {return _data;}
+    const char* end() const {return _data + _size;}
+    size_t size() const {return _size;}
+private:
+    // a mapped file can't be copied, it would be unmapped twice
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    QFile _file;
+    // the mapped bytes, NULL if the file is empty or has been read into _buffer
+    unsigned char* _map;
+    vector<char> _buffer;
+    const char* _data;
+    size_t _size;
+};
+
+#endif // MAPPEDFILE_H
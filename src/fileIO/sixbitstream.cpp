@@ -0,0 +1,43 @@
+#include "sixbitstream.h"
+#include <cstring>
+
+bool SixBitStream::readNumberOfNodes(unsigned& numberOfNodes)
+{
+    // the number starts at a character, bits that were already buffered are dropped
+    _bufferedBits = 0;
+    if (_position == _end)
+        return false;
+    if (*_position != 126)
+    {
+        numberOfNodes = *_position++ - 63;
+        return true;
+    }
+    ++_position;
+    // 126 126 is followed by 36 bits, 126 by 18 bits
+    unsigned length = 18;
+    if (_position != _end && *_position == 126)
+    {
+        ++_position;
+        length = 36;
+    }
+    if (bitsLeft() < length)
+        return false;
+    unsigned long long number = 0;
+    for (unsigned i = 0; i < length; i += 6)
+        number = (number << 6) | readBits(6);
+    // a graph this big can't be stored anyway
+    if (number > 0xFFFFFFFFULL)
+        return false;
+    numberOfNodes = number;
+    return true;
+}
+
+const char* SixBitStream::lineEnd(const char* begin, const char* end)
+{
+    const char* newLine = static_cast<const char*>(memchr(begin, '\n', end - begin));
+    if (!newLine)
+        newLine = end;
+    if (newLine != begin && *(newLine - 1) == '\r')
+        --newLine;
+    return newLine;
+}
@@ -0,0 +1,49 @@
+/*
+ Author: Balazs Nemeth
+ Description: SixBitStream reads the bits of a graph6 or sparse6 record straight from the characters of the file, each character
+              is 63 + a group of 6 bits (the most significant bit first). The characters are only read when the bits are
+              needed, so a reader can decode the edges while it walks over the (mapped) file without building a BitVector.
+     */
+
+#ifndef SIXBITSTREAM_H
+#define SIXBITSTREAM_H
+
+#include <cstddef>
+#include <assert.h>
+
+class SixBitStream
+{
+public:
+    // the stream reads the characters [begin, end)
+    SixBitStream(const char* begin, const char* end) : _position(begin), _end(end), _buffer(0), _bufferedBits(0) {}
+
+    /* reads the number of nodes N(n) as defined by Brendan McKay: one character for n <= 62, 126 and 3 characters for
+       n <= 258047, 126 126 and 6 characters otherwise. Returns false if the characters end before the number does */
+    bool readNumberOfNodes(unsigned& numberOfNodes);
+    // returns the next length bits (up to 32) as an integer, the first bit is the most significant, the stream must have enough bits left
+    unsigned readBits(unsigned length)
+    {
+        assert(length <= 32 && length <= bitsLeft());
+        while (_bufferedBits < length)
+        {
+            _buffer = (_buffer << 6) | ((*_position++ - 63) & 63);
+            _bufferedBits += 6;
+        }
+        _bufferedBits -= length;
+        return (_buffer >> _bufferedBits) & ((1ULL << length) - 1);
+    }
+    // the number of bits that can still be read
+    size_t bitsLeft() const {return 6 * size_t(_end - _position) + _bufferedBits;}
+    // the first character that hasn't been read yet
+    const char* position() const {return _position;}
+    // returns the end of the line that starts at begin (the '\n' or end), a '\r' before the '\n' isn't part of the line
+    static const char* lineEnd(const char* begin, const char* end);
+private:
+    const char* _position;
+    const char* _end;
+    // the bits of the last characters that haven't been returned yet, these are the lowest _bufferedBits bits
+    unsigned long long _buffer;
+    unsigned _bufferedBits;
+};
+
+#endif // SIXBITSTREAM_H
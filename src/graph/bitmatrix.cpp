@@ -0,0 +1,107 @@
+#include <algorithm>
+
+#include "bitmatrix.h"
+
+void BitMatrix::grow(unsigned size)
+{
+    assert(size >= _size);
+    // double the capacity so that adding the rows one by one doesn't copy the whole matrix each time
+    if (size > _capacity)
+        reserve(max(size, 2 * _capacity));
+    // the rows are wide enough, only the new rows have to be added at the end
+    _words.resize(size * _wordsPerRow, 0);
+    _size = size;
+}
+
+void BitMatrix::reserve(unsigned capacity)
+{
+    if (capacity <= _capacity)
+        return ;
+    unsigned wordsPerRow = wordsFor(capacity);
+    if (wordsPerRow != _wordsPerRow)
+    {
+        // the rows have to be wider, copy each row to it's new place
+        vector<Word> words;
+        words.reserve(capacity * wordsPerRow);
+        words.resize(_size * wordsPerRow, 0);
+        for (unsigned i = 0; i < _size; ++i)
+            for (unsigned k = 0; k < _wordsPerRow; ++k)
+                words[i * wordsPerRow + k] = _words[i * _wordsPerRow + k];
+        _words.swap(words);
+        _wordsPerRow = wordsPerRow;
+    }
+    else
+        _words.reserve(capacity * _wordsPerRow);
+    _capacity = capacity;
+}
+
+void BitMatrix::compact(const vector<unsigned>& keep)
+{
+    // the new column of each old column, -1 if the column is thrown away
+    vector<int> newColumn(_size, -1);
+    for (unsigned i = 0; i < keep.size(); ++i)
+    {
+        assert(keep[i] < _size && (i == 0 || keep[i - 1] < keep[i]));
+        newColumn[keep[i]] = i;
+    }
+    BitMatrix result;
+    result.reserve(keep.size());
+    result.grow(keep.size());
+    // only the set bits are copied
+    for (unsigned i = 0; i < keep.size(); ++i)
+        for (unsigned j = nextInRow(keep[i], 0); j < _size; j = nextInRow(keep[i], j + 1))
+            if (newColumn[j] != -1)
+                result.set(i, newColumn[j]);
+    swap(result);
+}
+
+void BitMatrix::clear()
+{
+    // give the memory back, a cleared matrix is often refilled with a different size
+    vector<Word>().swap(_words);
+    _size = 0;
+    _capacity = 0;
+    _wordsPerRow = 0;
+}
+
+void BitMatrix::swap(BitMatrix& other)
+{
+    _words.swap(other._words);
+    std::swap(_size, other._size);
+    std::swap(_capacity, other._capacity);
+    std::swap(_wordsPerRow, other._wordsPerRow);
+}
+
+void BitMatrix::resetAll()
+{
+    for (unsigned i = 0; i < _words.size(); ++i)
+        _words[i] = 0;
+}
+
+unsigned BitMatrix::nextInRow(unsigned row, unsigned from) const
+{
+    assert(row < _size);
+    if (from >= _size)
+        return _size;
+    const Word* words = &_words[row * _wordsPerRow];
+    unsigned k = from / BITS_PER_WORD;
+    // ignore the bits before from in the first word
+    Word word = words[k] & (~Word(0) << (from % BITS_PER_WORD));
+    while (true)
+    {
+        if (word)
+            return k * BITS_PER_WORD + countTrailingZeros(word);
+        if (++k == _wordsPerRow)
+            return _size;
+        word = words[k];
+    }
+}
+
+unsigned BitMatrix::countInRow(unsigned row) const
+{
+    assert(row < _size);
+    unsigned count = 0;
+    for (unsigned k = 0; k < _wordsPerRow; ++k)
+        count += popCount(_words[row * _wordsPerRow + k]);
+    return count;
+}
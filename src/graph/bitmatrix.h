@@ -0,0 +1,106 @@
+/*
+ Author: Balazs Nemeth
+ Description: BitMatrix is a square matrix of bits, one bit for each cell. The rows are stored one after another in a vector of
+              64 bit words and every row starts at a new word, so a row can be scanned a word at a time: the set bits are found
+              by counting the trailing zeros of a word instead of testing each cell. MatrixGraph uses it to know which cells
+              hold at least one edge, a graph with 20000 nodes needs 50MB instead of a list for each cell.
+              Like a vector the matrix has a capacity: the rows are as wide as the capacity and the capacity doubles when the
+              matrix grows beyond it, so adding n rows one by one only copies the matrix log(n) times.
+     */
+
+#ifndef BITMATRIX_H
+#define BITMATRIX_H
+
+#include <vector>
+#include <assert.h>
+
+using namespace std;
+
+class BitMatrix
+{
+public:
+    typedef unsigned long long Word;
+    enum { BITS_PER_WORD = 64 };
+
+    BitMatrix() : _size(0), _capacity(0), _wordsPerRow(0) {}
+
+    // the number of rows (and columns)
+    unsigned size() const {return _size;}
+    // adds rows and columns until the matrix has size rows, the new cells are 0
+    void grow(unsigned size);
+    // makes room for capacity rows and columns without changing the size
+    void reserve(unsigned capacity);
+    unsigned capacity() const {return _capacity;}
+    /* keeps only the rows and columns in keep (these have to be sorted), row keep[i] becomes row i.
+       Used to throw away the rows and columns that aren't used anymore in one pass */
+    void compact(const vector<unsigned>& keep);
+    // removes all the rows and columns
+    void clear();
+    // sets all the cells to 0 without changing the size
+    void resetAll();
+    void swap(BitMatrix& other);
+
+    bool test(unsigned row, unsigned column) const
+    {
+        assert(row < _size && column < _size);
+        return (_words[row * _wordsPerRow + column / BITS_PER_WORD] >> (column % BITS_PER_WORD)) & 1;
+    }
+    void set(unsigned row, unsigned column)
+    {
+        assert(row < _size && column < _size);
+        _words[row * _wordsPerRow + column / BITS_PER_WORD] |= Word(1) << (column % BITS_PER_WORD);
+    }
+    void reset(unsigned row, unsigned column)
+    {
+        assert(row < _size && column < _size);
+        _words[row * _wordsPerRow + column / BITS_PER_WORD] &= ~(Word(1) << (column % BITS_PER_WORD));
+    }
+
+    // returns the first column >= from that is set in the row, or size() if there is none
+    unsigned nextInRow(unsigned row, unsigned from) const;
+    // returns the number of cells that are set in the row
+    unsigned countInRow(unsigned row) const;
+
+    static unsigned countTrailingZeros(Word word);
+    static unsigned popCount(Word word);
+
+private:
+    static unsigned wordsFor(unsigned bits) {return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD;}
+
+    unsigned _size;
+    unsigned _capacity;
+    unsigned _wordsPerRow;
+    vector<Word> _words;
+};
+
+// word must not be 0
+inline unsigned BitMatrix::countTrailingZeros(Word word)
+{
+    assert(word);
+#ifdef __GNUC__
+    return __builtin_ctzll(word);
+#else
+    unsigned count = 0;
+    while (!(word & 1))
+    {
+        word >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline unsigned BitMatrix::popCount(Word word)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(word);
+#else
+    unsigned count = 0;
+    // each iteration clears the lowest set bit
+    for (; word; word &= word - 1)
+        ++count;
+    return count;
+#endif
+}
+
+#endif // BITMATRIX_H
@@ -0,0 +1,474 @@
+#include <assert.h>
+#include <list>
+#include <vector>
+#include <sstream>
+
+#include "csrgraph.h"
+#include "graphComp/node.h"
+#include "graphComp/edge.h"
+#include "exception/uniqueedgeex.h"
+#include "exception/unexistingedgeex.h"
+#include "exception/unexistingnodeex.h"
+
+CSRGraph::CSRGraph() : Graph()
+{
+    // an empty graph still has the closing offset
+    _offsets.push_back(0);
+    _incomingValid = false;
+}
+
+CSRGraph::CSRGraph(string name) : Graph(name)
+{
+    _offsets.push_back(0);
+    _incomingValid = false;
+}
+
+CSRGraph::CSRGraph(const Graph& other)
+{
+    // do not call the copyconstructor of Graph. nodes will be created by recreateFrom(other);
+    _offsets.push_back(0);
+    _incomingValid = false;
+    recreateFrom(other);
+}
+
+CSRGraph::CSRGraph(const IntegerMatrix& integerMatrix)
+{
+    _offsets.push_back(0);
+    _incomingValid = false;
+    recreateFrom(integerMatrix);
+}
+
+CSRGraph::~CSRGraph()
+{
+    // removeNodes will also remove all the edges
+    removeNodes();
+}
+
+void CSRGraph::recreateFrom(const Graph& other)
+{
+    // calling recreateFrom with itself doesn't change anything
+    if (&other == this)
+        return ;
+    _name = other.getName();
+    // remove any previous existing nodes
+    removeNodes();
+    const vector<Node*>& otherNodes = other.getNodes();
+    /* the nodes are added by the baseclass so that there is no notification for each node,
+       the observers are notified once when the whole structure has been built */
+    for (unsigned i = 0; i < otherNodes.size(); ++i)
+        Graph::addNode(createNode(*otherNodes[i]));
+    copyDistances(other);
+
+    _offsets.assign(1, 0);
+    _offsets.reserve(_numberOfNodes + 1);
+    _targets.reserve(other.getNumberOfEdges());
+    _edges.reserve(other.getNumberOfEdges());
+    list<Edge*> tempEdges;
+    // the outgoing edges of the other graph are visited per node in order, so each row can be appended at the end
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        tempEdges = other.getOutgoingEdges(otherNodes[i]);
+        for (list<Edge*>::const_iterator j = tempEdges.begin(); j != tempEdges.end(); ++j)
+        {
+            unsigned targetIndex = other.nodeToIndex((*j)->getTarget());
+            Edge* newEdge = createEdge(**j);
+            newEdge->setSource(_nodes[i]);
+            newEdge->setTarget(_nodes[targetIndex]);
+            _targets.push_back(targetIndex);
+            _edges.push_back(newEdge);
+            _lastAddedEdges.push_back(newEdge);
+        }
+        _offsets.push_back(_edges.size());
+    }
+    _numberOfEdges = _edges.size();
+    _incomingValid = false;
+    notifyObservers();
+}
+
+void CSRGraph::recreateFrom(const IntegerMatrix& integerMatrix)
+{
+    GraphBuilder builder;
+    builder.addIntegerMatrix(integerMatrix);
+    // clear the graph
+    removeNodes();
+    addBatch(builder);
+}
+
+void CSRGraph::recreateFrom(const SparseMatrix& sparseMatrix)
+{
+    GraphBuilder builder;
+    builder.addSparseMatrix(sparseMatrix);
+    // clear the graph
+    removeNodes();
+    addBatch(builder);
+}
+
+void CSRGraph::addBatch(const GraphBuilder& builder)
+{
+    // nothing is changed if the builder isn't valid
+    builder.validate();
+    unsigned first = _numberOfNodes;
+    addBatchNodes(builder);
+    const vector<GraphBuilder::EdgeEntry>& edges = builder.getEdges();
+    /* every edge starts in a new node, so the new rows come after the existing rows. The edges are put in their row with a
+       counting sort: count the edges of each new node, the sums are the start of each row */
+    vector<unsigned> rowStart(builder.getNumberOfNodes() + 1, 0);
+    for (vector<GraphBuilder::EdgeEntry>::const_iterator i = edges.begin(); i != edges.end(); ++i)
+        ++rowStart[i->source + 1];
+    for (unsigned i = 1; i < rowStart.size(); ++i)
+        rowStart[i] += rowStart[i - 1];
+
+    unsigned base = _edges.size();
+    _targets.resize(base + edges.size());
+    _edges.resize(base + edges.size());
+    vector<unsigned> next(rowStart.begin(), rowStart.end() - 1);
+    for (vector<GraphBuilder::EdgeEntry>::const_iterator i = edges.begin(); i != edges.end(); ++i)
+    {
+        unsigned position = base + next[i->source]++;
+        _targets[position] = first + i->target;
+        _edges[position] = createBatchEdge(*i, first);
+    }
+    _offsets.reserve(_numberOfNodes + 1);
+    for (unsigned i = 1; i < rowStart.size(); ++i)
+        _offsets.push_back(base + rowStart[i]);
+    _numberOfEdges += edges.size();
+    _incomingValid = false;
+    notifyObservers();
+}
+
+IntegerMatrix CSRGraph::getIntegerMatrix() const
+{
+    IntegerMatrix result;
+    for (vector<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+        result.addNode(**i);
+
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        for (unsigned k = _offsets[i]; k < _offsets[i + 1]; ++k)
+            result.addEdge(*_nodes[i], *_nodes[_targets[k]]);
+    return result;
+}
+
+SparseMatrix CSRGraph::getSparseMatrix() const
+{
+    SparseMatrix result(_numberOfNodes);
+    result.reserveEdges(_targets.size());
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        for (unsigned k = _offsets[i]; k < _offsets[i + 1]; ++k)
+            result.addEdge(i, _targets[k]);
+    return result;
+}
+
+void CSRGraph::addNode(Node* node)
+{
+    // node should not be the NULL pointer, using a NULL pointer can only be caused by bad programming
+    assert(node);
+    Graph::addNode(node);
+    // the new node has no edges, so it's row is empty and starts where the last row ends
+    _offsets.push_back(_edges.size());
+    _incomingValid = false;
+    notifyObservers();
+}
+
+void CSRGraph::addNode(const Node& other)
+{
+    addNode(createNode(other));
+}
+
+void CSRGraph::removeNodes()
+{
+    // free the edges, the nodes are freed by the baseclass
+    for (vector<Edge*>::iterator i = _edges.begin(); i != _edges.end(); ++i)
+        destroyEdge(*i);
+    _edges.clear();
+    _targets.clear();
+    _offsets.assign(1, 0);
+    _inOffsets.clear();
+    _inEdges.clear();
+    _incomingValid = false;
+    _numberOfEdges = 0;
+    Graph::removeNodes();
+    notifyObservers();
+}
+
+void CSRGraph::removeNode(unsigned id)
+{
+    if (id + 1 > _numberOfNodes)
+        throw UnexistingNodeEx(Node(), "id does not exist");
+    removeNode(_nodes[id]);
+}
+
+void CSRGraph::removeNode(Node* node)
+{
+    int index = nodeToIndex(node);
+    // an invalid Node* can only be caused by bad programming
+    assert(index != -1);
+    unsigned removed = static_cast<unsigned>(index);
+
+    /* compact the arrays in one pass: the row of the removed node and all the edges pointing to it are dropped,
+       the target indices that come after the removed node shift one place */
+    vector<unsigned> newOffsets;
+    newOffsets.reserve(_numberOfNodes);
+    newOffsets.push_back(0);
+    unsigned position = 0;
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        for (unsigned k = _offsets[i]; k < _offsets[i + 1]; ++k)
+        {
+            if (i == removed || _targets[k] == removed)
+            {
+                destroyEdge(_edges[k]);
+                --_numberOfEdges;
+            }
+            else
+            {
+                _targets[position] = _targets[k] > removed ? _targets[k] - 1 : _targets[k];
+                _edges[position] = _edges[k];
+                ++position;
+            }
+        }
+        if (i != removed)
+            newOffsets.push_back(position);
+    }
+    _targets.resize(position);
+    _edges.resize(position);
+    _offsets.swap(newOffsets);
+    _incomingValid = false;
+    // removing the node from the _nodes vector is done by the baseclass
+    Graph::removeNode(node);
+    notifyObservers();
+}
+
+void CSRGraph::addEdge(unsigned sourceIndex, unsigned targetIndex, const Label& label)
+{
+    // if one of the nodes does not exist, throw exception
+    if (sourceIndex + 1 > _numberOfNodes || targetIndex + 1 > _numberOfNodes)
+        throw UnexistingNodeEx(Node(), "The edge can't be created, because one (or both) node(s) are invalid", 2);
+    addEdge(Edge(_nodes[sourceIndex], _nodes[targetIndex], label));
+}
+
+void CSRGraph::addEdge(const Edge& edge)
+{
+    int sourceIndex = nodeToIndex(edge.getSource());
+    int targetIndex = nodeToIndex(edge.getTarget());
+    // both souldn't be -1, this would mean that source or target don't exists and this can only be caused by bad programming
+    assert(sourceIndex != -1 && targetIndex != -1);
+    if (!isUniqueEdge(edge))
+        throw UniqueEdgeEx(edge);
+    Edge* newEdge = createEdge(edge);
+    insertEdge(sourceIndex, targetIndex, newEdge);
+    _numberOfEdges++;
+    _lastAddedEdges.push_back(newEdge);
+    notifyObservers();
+}
+
+void CSRGraph::insertEdge(unsigned sourceIndex, unsigned targetIndex, Edge* edge)
+{
+    unsigned position = _offsets[sourceIndex + 1];
+    _targets.insert(_targets.begin() + position, targetIndex);
+    _edges.insert(_edges.begin() + position, edge);
+    // all the rows after the source row start one position later
+    for (unsigned i = sourceIndex + 1; i < _offsets.size(); ++i)
+        ++_offsets[i];
+    _incomingValid = false;
+}
+
+void CSRGraph::eraseEdge(unsigned sourceIndex, unsigned position)
+{
+    _targets.erase(_targets.begin() + position);
+    _edges.erase(_edges.begin() + position);
+    for (unsigned i = sourceIndex + 1; i < _offsets.size(); ++i)
+        --_offsets[i];
+    _incomingValid = false;
+}
+
+void CSRGraph::removeEdges()
+{
+    for (vector<Edge*>::iterator i = _edges.begin(); i != _edges.end(); ++i)
+        destroyEdge(*i);
+    _edges.clear();
+    _targets.clear();
+    // every row is empty now
+    _offsets.assign(_numberOfNodes + 1, 0);
+    _incomingValid = false;
+    _numberOfEdges = 0;
+    notifyObservers();
+}
+
+void CSRGraph::removeEdge(unsigned sourceIndex, unsigned targetIndex, const Label& label)
+{
+    if (sourceIndex + 1 > _numberOfNodes || targetIndex + 1 > _numberOfNodes)
+        throw(UnexistingNodeEx(Node(), "invalid node id"));
+    else if (!edgeExists(_nodes[sourceIndex], _nodes[targetIndex], label))
+        throw(UnexistingEdgeEx(Edge(_nodes[sourceIndex], _nodes[targetIndex], label)));
+
+    removeEdge(_nodes[sourceIndex], _nodes[targetIndex], label);
+}
+
+void CSRGraph::removeEdge(Node* source, Node* target, const Label& label)
+{
+    int sourceIndex = nodeToIndex(source);
+    int targetIndex = nodeToIndex(target);
+    assert(sourceIndex != -1 && targetIndex != -1);
+
+    bool found = false;
+    for (unsigned k = _offsets[sourceIndex]; !found && k < _offsets[sourceIndex + 1]; ++k)
+    {
+        if (_targets[k] == static_cast<unsigned>(targetIndex) && _edges[k]->getLabel() == label)
+        {
+            found = true;
+            // free the memory allocated for that edge and remove it from the arrays
+            destroyEdge(_edges[k]);
+            eraseEdge(sourceIndex, k);
+            _numberOfEdges--;
+        }
+    }
+    notifyObservers();
+}
+
+list<Node*> CSRGraph::getNeighbours(Node* node) const
+{
+    list<Node*> neighbours;
+    int sourceIndex = nodeToIndex(node);
+    assert(sourceIndex != -1);
+    for (unsigned k = _offsets[sourceIndex]; k < _offsets[sourceIndex + 1]; ++k)
+        neighbours.push_back(_nodes[_targets[k]]);
+    return neighbours;
+}
+
+list<Edge*> CSRGraph::getOutgoingEdges(Node* node) const
+{
+    list<Edge*> outgoingEdges;
+    int sourceIndex = nodeToIndex(node);
+    assert(sourceIndex != -1);
+    for (unsigned k = _offsets[sourceIndex]; k < _offsets[sourceIndex + 1]; ++k)
+        outgoingEdges.push_back(_edges[k]);
+    return outgoingEdges;
+}
+
+list<Edge*> CSRGraph::getIncomingEdges(Node* node) const
+{
+    list<Edge*> incomingEdges;
+    int targetIndex = nodeToIndex(node);
+    assert(targetIndex != -1);
+    if (!_incomingValid)
+        buildIncoming();
+    for (unsigned k = _inOffsets[targetIndex]; k < _inOffsets[targetIndex + 1]; ++k)
+        incomingEdges.push_back(_edges[_inEdges[k]]);
+    return incomingEdges;
+}
+
+void CSRGraph::forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const
+{
+    int sourceIndex = nodeToIndex(node);
+    assert(sourceIndex != -1);
+    for (unsigned k = _offsets[sourceIndex]; k < _offsets[sourceIndex + 1]; ++k)
+        if (!functor(_edges[k]))
+            return ;
+}
+
+void CSRGraph::forEachIncomingEdge(Node* node, EdgeFunctor& functor) const
+{
+    int targetIndex = nodeToIndex(node);
+    assert(targetIndex != -1);
+    if (!_incomingValid)
+        buildIncoming();
+    for (unsigned k = _inOffsets[targetIndex]; k < _inOffsets[targetIndex + 1]; ++k)
+        if (!functor(_edges[_inEdges[k]]))
+            return ;
+}
+
+void CSRGraph::forEachNeighbour(Node* node, NodeFunctor& functor) const
+{
+    int sourceIndex = nodeToIndex(node);
+    assert(sourceIndex != -1);
+    for (unsigned k = _offsets[sourceIndex]; k < _offsets[sourceIndex + 1]; ++k)
+        if (!functor(_nodes[_targets[k]]))
+            return ;
+}
+
+void CSRGraph::buildIncoming() const
+{
+    // counting sort of the edge ids on their target, first count the incoming edges of each node
+    _inOffsets.assign(_numberOfNodes + 1, 0);
+    for (unsigned k = 0; k < _targets.size(); ++k)
+        ++_inOffsets[_targets[k] + 1];
+    // prefix sum so that _inOffsets[i] is the start of the row of node i
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        _inOffsets[i + 1] += _inOffsets[i];
+    // fill in the rows, the fill pointer per row is kept in a copy of the offsets
+    vector<unsigned> fill(_inOffsets.begin(), _inOffsets.end() - 1);
+    _inEdges.resize(_targets.size());
+    for (unsigned k = 0; k < _targets.size(); ++k)
+        _inEdges[fill[_targets[k]]++] = k;
+    _incomingValid = true;
+}
+
+bool CSRGraph::isUniqueEdge(const Edge& edge) const
+{
+    int sourceIndex = nodeToIndex(edge.getSource());
+    int targetIndex = nodeToIndex(edge.getTarget());
+    // this is a help function, a bad source/target is caused by errorneous programming
+    assert(sourceIndex != -1 && targetIndex != -1);
+    for (unsigned k = _offsets[sourceIndex]; k < _offsets[sourceIndex + 1]; ++k)
+        if (_targets[k] == static_cast<unsigned>(targetIndex) && _edges[k]->getLabel() == edge.getLabel())
+            return false;
+    return true;
+}
+
+bool CSRGraph::edgeExists(Node* source, Node* target, const Label& label) const
+{
+    int sourceIndex = nodeToIndex(source);
+    int targetIndex = nodeToIndex(target);
+    assert(sourceIndex != -1 && targetIndex != -1);
+    for (unsigned k = _offsets[sourceIndex]; k < _offsets[sourceIndex + 1]; ++k)
+        if (_targets[k] == static_cast<unsigned>(targetIndex) && _edges[k]->getLabel() == label)
+            return true;
+    return false;
+}
+
+string CSRGraph::toString(bool useID) const
+{
+    ostringstream str;
+    str << "GrapName: " << _name.c_str() << "\n";
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        if (useID)
+            str << i;
+        else
+            str << _nodes[i]->getLabel();
+        for (unsigned k = _offsets[i]; k < _offsets[i + 1]; ++k)
+        {
+            str << "->";
+            if (useID)
+                str << _targets[k];
+            else
+                str << _nodes[_targets[k]]->getLabel();
+            str << "|\"" << _edges[k]->getLabel() << "\"";
+        }
+        str << endl;
+    }
+    return str.str();
+}
+
+string CSRGraph::toString() const
+{
+    return toString(false);
+}
+
+string CSRGraph::toStringID() const
+{
+    return toString(true);
+}
+
+// friend, this function is not efficient and should only be used in debugmode
+QDebug operator<<(QDebug dbg, const CSRGraph& other)
+{
+    dbg.nospace() << other.toString().c_str();
+    return dbg;
+}
+
+ostream& operator<<(ostream& dbg, const CSRGraph& other)
+{
+    cout << other.toString();
+    return dbg;
+}
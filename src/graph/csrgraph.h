@@ -0,0 +1,108 @@
+/*
+ Author: Balazs Nemeth
+ Description: implements a compressed sparse row (CSR) graph. The adjacency is kept in three contiguous arrays instead of
+              linked lists, this makes scanning the outgoing edges of a node a walk over consecutive memory.
+              This structure is meant for graphs that are loaded once and then analysed (read-mostly), changing the
+              structure is supported but costs O(V+E) for each edge or node that is added or removed.
+     */
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <QDebug>
+#include <list>
+#include <vector>
+
+#include "graph.h"
+
+using namespace std;
+/* the csr arrays look like this (3 nodes, edges 0->1, 0->2, 2->0):
+
+    _offsets:  0 2 2 3      the edges of node i are at the positions [_offsets[i], _offsets[i+1])
+    _targets:  1 2 0        the index of the target node for each position
+    _edges:    e e e        the Edge* for each position, the position is the edge id
+
+    the incoming edges are kept in the same way in _inOffsets and _inEdges (which holds edge ids),
+    these are only rebuilt when they are asked for after the structure changed
+            */
+
+class CSRGraph : public Graph
+{
+public:
+    CSRGraph();
+    // creates an empty CSRGraph with a name, the baseclass handles this
+    CSRGraph(string name);
+    // copy constructor -- also used for other Graph types (ListGraph, MatrixGraph, HybridGraph)
+    CSRGraph(const Graph& other);
+    // create a CSRGraph from an IntegerMatrix
+    CSRGraph(const IntegerMatrix& integerMatrix);
+    // removes the nodes and the edges
+    ~CSRGraph();
+    // returns this graph in the form of an IntegerMatrix
+    IntegerMatrix getIntegerMatrix() const;
+    // the rows are copied straight from the csr arrays
+    SparseMatrix getSparseMatrix() const;
+    // adds a node to the graph without any edges
+    void addNode(const Node& other = Node());
+    // removes all nodes from the graph, including all the edges
+    void removeNodes();
+    // removes the node by index
+    void removeNode(unsigned id);
+    // removes all the edges, the nodes are kept
+    void removeEdges();
+    // removes the edge between from and target with Label label
+    void removeEdge(Node* source, Node* target, const Label& label);
+    // remove edge by index
+    void removeEdge(unsigned sourceIndex, unsigned targetIndex, const Label& label);
+    // builds the csr arrays from another graph in one pass
+    void recreateFrom(const Graph& other);
+    // builds the csr arrays from an integermatrix in one pass
+    void recreateFrom(const IntegerMatrix& integerMatrix);
+    void recreateFrom(const SparseMatrix& sparseMatrix);
+    // the rows of the new nodes are appended to the csr arrays in one pass
+    void addBatch(const GraphBuilder& builder);
+    list<Node*> getNeighbours(Node* node) const;
+    list<Edge*> getOutgoingEdges(Node* node) const;
+    list<Edge*> getIncomingEdges(Node* node) const;
+    void forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const;
+    void forEachIncomingEdge(Node* node, EdgeFunctor& functor) const;
+    void forEachNeighbour(Node* node, NodeFunctor& functor) const;
+    void accept(Visitor& v) {v.visit(*this);}
+    // add an edge between the nodes with the given indices
+    void addEdge(unsigned sourceIndex, unsigned targetIndex, const Label& label);
+    void addEdge(const Edge& edge);
+    // an edge is uniquely defined by its source-target-label
+    bool isUniqueEdge(const Edge& edge) const;
+    bool edgeExists(Node* source, Node* target, const Label& label) const;
+
+    // public because GUI uses these functions
+    // see the base class for comments
+    void addNode(Node* node);
+    // removes a node including the edges(!) that are connected to this node
+    void removeNode(Node* node);
+
+    friend QDebug operator<<(QDebug dbg, const CSRGraph& other);
+    friend ostream& operator<<(ostream& dbg, const CSRGraph& other);
+
+    string toString() const;
+    string toStringID() const;
+private:
+    // inserts the edge at the end of the row of sourceIndex, all the rows after it are shifted by one
+    void insertEdge(unsigned sourceIndex, unsigned targetIndex, Edge* edge);
+    // removes the edge at the given position from the arrays, the edge itself is not deleted
+    void eraseEdge(unsigned sourceIndex, unsigned position);
+    // rebuilds _inOffsets and _inEdges out of the outgoing arrays
+    void buildIncoming() const;
+    // returns a string representation, if useID is true the index of a node is used instead of it's label
+    string toString(bool useID) const;
+private:
+    vector<unsigned> _offsets;
+    vector<unsigned> _targets;
+    vector<Edge*> _edges;
+    // the incoming arrays are derived from the outgoing arrays, they are mutable because they are built lazily in const functions
+    mutable vector<unsigned> _inOffsets;
+    mutable vector<unsigned> _inEdges;
+    mutable bool _incomingValid;
+};
+
+#endif // CSRGRAPH_H
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <algorithm>
+
+#include "distancematrix.h"
+
+// the radius of the earth and pi as TSPLIB defines them for GEO
+static const double EARTHRADIUS = 6378.388;
+static const double PI = 3.141592;
+
+// rounds to the nearest integer, nint in TSPLIB
+static double nint(double x)
+{
+    return floor(x + 0.5);
+}
+
+// converts a GEO coordinate DDD.MM (degrees and minutes) to radians
+static double geoToRadians(double x)
+{
+    double degrees = x < 0 ? ceil(x) : floor(x);
+    double minutes = x - degrees;
+    return PI * (degrees + 5.0 * minutes / 3.0) / 180.0;
+}
+
+DistanceMatrix::DistanceMatrix(unsigned numberOfNodes) : _metric(EXPLICIT), _numberOfNodes(numberOfNodes)
+{
+    _distances.assign(size_t(numberOfNodes) * numberOfNodes, infinity());
+    for (unsigned i = 0; i < numberOfNodes; ++i)
+        _distances[size_t(i) * numberOfNodes + i] = 0;
+}
+
+void DistanceMatrix::setCoordinates(Metric metric, const vector<double>& x, const vector<double>& y)
+{
+    assert(metric != EXPLICIT && x.size() == y.size());
+    _metric = metric;
+    _numberOfNodes = x.size();
+    // the matrix isn't needed, the distances are computed
+    vector<float>().swap(_distances);
+    _x = x;
+    _y = y;
+    if (metric == GEO)
+    {
+        // the conversion is done once instead of for each distance
+        for (unsigned i = 0; i < _numberOfNodes; ++i)
+        {
+            _x[i] = geoToRadians(x[i]);
+            _y[i] = geoToRadians(y[i]);
+        }
+    }
+}
+
+float DistanceMatrix::computeDistance(unsigned source, unsigned target) const
+{
+    if (source == target)
+        return 0;
+    double dx = _x[source] - _x[target];
+    double dy = _y[source] - _y[target];
+    switch (_metric)
+    {
+    case EUC_2D:
+        return nint(sqrt(dx * dx + dy * dy));
+    case CEIL_2D:
+        return ceil(sqrt(dx * dx + dy * dy));
+    case MAN_2D:
+        return nint(fabs(dx) + fabs(dy));
+    case MAX_2D:
+        return max(nint(fabs(dx)), nint(fabs(dy)));
+    case ATT:
+    {
+        // pseudo euclidean distance, the distance is rounded up
+        double r = sqrt((dx * dx + dy * dy) / 10.0);
+        double t = nint(r);
+        return t < r ? t + 1 : t;
+    }
+    case GEO:
+    {
+        // x is the latitude and y the longitude
+        double q1 = cos(_y[source] - _y[target]);
+        double q2 = cos(_x[source] - _x[target]);
+        double q3 = cos(_x[source] + _x[target]);
+        return floor(EARTHRADIUS * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+    default:
+        assert(false);
+        return infinity();
+    }
+}
+
+float DistanceMatrix::lowerBound(double difference) const
+{
+    // the distance of two nodes that only differ in x, the rounding of the metrics doesn't make a longer distance shorter
+    switch (_metric)
+    {
+    case EUC_2D:
+    case MAN_2D:
+    case MAX_2D:
+        return nint(difference);
+    case CEIL_2D:
+        return ceil(difference);
+    case ATT:
+    {
+        double r = difference / sqrt(10.0);
+        double t = nint(r);
+        return t < r ? t + 1 : t;
+    }
+    case GEO:
+        // the angle between two points on the earth is at least the difference of their latitudes
+        return EARTHRADIUS * difference;
+    default:
+        assert(false);
+        return 0;
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ Author: Balazs Nemeth
+ Description: DistanceMatrix holds the distances between all pairs of n nodes without creating n^2 edges. The distances are
+              either stored in a dense matrix of floats (EXPLICIT, like the EDGE_WEIGHT_SECTION of a TSPLIB file) or computed
+              when they are asked from the coordinates of the nodes with one of the TSPLIB distance functions, in that case
+              only the coordinates are stored. The distances of the coordinate metrics are rounded the way TSPLIB defines them.
+     */
+
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include <vector>
+#include <limits>
+#include <assert.h>
+
+using namespace std;
+
+class DistanceMatrix
+{
+public:
+    enum Metric { EXPLICIT, EUC_2D, CEIL_2D, MAN_2D, MAX_2D, GEO, ATT };
+
+    // an explicit matrix of n nodes, all distances are infinity (no edge) except the diagonal which is 0
+    DistanceMatrix(unsigned numberOfNodes = 0);
+
+    // the distances are computed from the coordinates, node i is at (x[i], y[i])
+    void setCoordinates(Metric metric, const vector<double>& x, const vector<double>& y);
+    // only for an explicit matrix, sets the distance from source to target (the matrix doesn't have to be symmetric)
+    void setDistance(unsigned source, unsigned target, float distance)
+    {
+        assert(_metric == EXPLICIT && source < _numberOfNodes && target < _numberOfNodes);
+        _distances[size_t(source) * _numberOfNodes + target] = distance;
+    }
+    float distance(unsigned source, unsigned target) const
+    {
+        assert(source < _numberOfNodes && target < _numberOfNodes);
+        if (_metric == EXPLICIT)
+            return _distances[size_t(source) * _numberOfNodes + target];
+        return computeDistance(source, target);
+    }
+    // false if there is no edge from source to target (the distance is infinity)
+    bool hasEdge(unsigned source, unsigned target) const {return distance(source, target) != infinity();}
+
+    unsigned getNumberOfNodes() const {return _numberOfNodes;}
+    Metric getMetric() const {return _metric;}
+    // the coordinates of a node, only for the coordinate metrics (the latitude and longitude in radians for GEO)
+    double getX(unsigned node) const {assert(_metric != EXPLICIT); return _x[node];}
+    double getY(unsigned node) const {assert(_metric != EXPLICIT); return _y[node];}
+    /* the shortest distance two nodes can have if their x or y coordinates are difference apart (only x, the latitude, for
+       GEO), used to stop searching for near nodes. not for EXPLICIT */
+    float lowerBound(double difference) const;
+    static float infinity() {return numeric_limits<float>::infinity();}
+private:
+    float computeDistance(unsigned source, unsigned target) const;
+
+    Metric _metric;
+    unsigned _numberOfNodes;
+    // the dense matrix (row by row) for EXPLICIT, empty otherwise
+    vector<float> _distances;
+    // the coordinates for the other metrics, for GEO these are latitude and longitude in radians
+    vector<double> _x;
+    vector<double> _y;
+};
+
+#endif // DISTANCEMATRIX_H
@@ -0,0 +1,30 @@
+/*
+ Author: Balazs Nemeth
+ Description: EdgeFunctor and NodeFunctor are used to walk over the edges or the neighbours of a node without building a list,
+              the graph calls the functor for each edge (node) directly from it's own structure. Algorithms that have to look at
+              every edge (like the searches) derive a small functor class from these and pass it to Graph::forEachOutgoingEdge etc.
+     */
+
+#ifndef EDGEFUNCTOR_H
+#define EDGEFUNCTOR_H
+
+class Edge;
+class Node;
+
+class EdgeFunctor
+{
+public:
+    virtual ~EdgeFunctor() {}
+    // called for each edge, returning false stops the walk over the remaining edges
+    virtual bool operator()(Edge* edge) = 0;
+};
+
+class NodeFunctor
+{
+public:
+    virtual ~NodeFunctor() {}
+    // called for each node, returning false stops the walk over the remaining nodes
+    virtual bool operator()(Node* node) = 0;
+};
+
+#endif // EDGEFUNCTOR_H
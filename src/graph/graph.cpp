@@ -1,5 +1,6 @@
 #include <sstream>
 #include <assert.h>
+#include <new>
 
 #include "graph.h"
 #include "graphComp/node.h"
@@ -23,7 +24,10 @@ Graph::Graph(const Graph& other) : Subject()
     // copy the name of the other graph
     _name = other.getName();
     for (unsigned i = 0; i < other.getNumberOfNodes(); ++i)
-        _nodes.push_back(new Node(*(other._nodes[i])));
+        _nodes.push_back(createNode(*(other._nodes[i])));
+    indexNodesFrom(0);
+    indexLabelsFrom(0);
+    copyDistances(other);
     // the rest of the copyconstructor is done in the derived classes
 }
 
@@ -35,18 +39,47 @@ Graph::~Graph()
 
 void Graph::addNode(const Node& node)
 {
-    addNode(new Node(node));
+    addNode(createNode(node));
 }
 
 // adds a Node by a pointer to a node
 void Graph::addNode(Node* node)
 {
     _nodes.push_back(node);
+    indexNodesFrom(_nodes.size() - 1);
+    indexLabelsFrom(_nodes.size() - 1);
+    // the distances don't have the new node
+    _distances = DistanceMatrix();
     // add this to the lastAddedNodes list so that it can be used to update the observers of the graph
     _lastAddedNodes.push_back(node);
     ++_numberOfNodes; // adjust counter
 }
 
+void Graph::addBatchNodes(const GraphBuilder& builder)
+{
+    const vector<Node>& nodes = builder.getNodes();
+    unsigned first = _nodes.size();
+    _nodes.reserve(first + nodes.size());
+    for (vector<Node>::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+    {
+        Node* node = createNode(*i);
+        _nodes.push_back(node);
+        _lastAddedNodes.push_back(node);
+    }
+    // the new nodes are indexed at once
+    indexNodesFrom(first);
+    indexLabelsFrom(first);
+    _numberOfNodes += nodes.size();
+    _distances = DistanceMatrix();
+}
+
+Edge* Graph::createBatchEdge(const GraphBuilder::EdgeEntry& entry, unsigned firstNode)
+{
+    Edge* edge = createEdge(Edge(_nodes[firstNode + entry.source], _nodes[firstNode + entry.target], entry.label, entry.rgb));
+    _lastAddedEdges.push_back(edge);
+    return edge;
+}
+
 list<Edge*> Graph::getLastAddedEdges()
 {
     list<Edge*> tempList = _lastAddedEdges;
@@ -66,9 +99,20 @@ void Graph::removeNodes()
 {
     // delete all the nodes we have created, keep deleting the first one untill there are none left
     for (vector<Node*>::iterator i = _nodes.begin(); i != _nodes.end(); ++i)
-        delete *i;
-    // now clear the nodes
+    {
+        (*i)->_graph = NULL;
+        destroyNode(*i);
+    }
+    // all the nodes are gone so the slabs can be freed at once, the derived classes remove the edges before they get here
+    _nodePool.releaseAll();
+    if (_numberOfEdges == 0)
+        _edgePool.releaseAll();
+    // now clear the nodes and the indexes on them
     _nodes.clear();
+    _nodeIndex.clear();
+    _idIndex.clear();
+    _labelIndex.clear();
+    _distances = DistanceMatrix();
     _numberOfNodes = 0; // adjust counter
 //    notifyObservers(); // all removeNodes operations finish with this one, so notifyObservers() only needs to be here
 }
@@ -76,56 +120,158 @@ void Graph::removeNodes()
 // removes a given node identified by a pointer to that node
 void Graph::removeNode(Node* node)
 {
-     delete node;
-    _nodes.erase(_nodes.begin() + nodeToIndex(node));
-    --_numberOfNodes; // adjust counter
+    int index = nodeToIndex(node);
+    assert(index != -1);
+    Graph::removeNode(unsigned(index));
 //    notifyObservers(); // all removeNode operations finish with this one, so notifyObservers() only needs to be here
 }
 
 void Graph::removeNode(unsigned id)
 {
-    assert(id < _nodes.size() - 1);
-    delete _nodes[id];
+    assert(id < _nodes.size());
+    // the node has to be taken out of the indexes before it's deleted
+    unindexNode(id);
+    destroyNode(_nodes[id]);
     _nodes.erase(_nodes.begin() + id);
+    // all the nodes after the removed one moved one position
+    indexNodesFrom(id);
     --_numberOfNodes;
+    _distances = DistanceMatrix();
 //    notifyObservers();
 }
 
+void Graph::setDistances(const DistanceMatrix& distances)
+{
+    assert(distances.getNumberOfNodes() == _nodes.size());
+    _distances = distances;
+}
+
+void Graph::copyDistances(const Graph& other)
+{
+    const DistanceMatrix* distances = other.getDistances();
+    if (distances && distances->getNumberOfNodes() == _nodes.size())
+        _distances = *distances;
+}
+
 // will return the node with label label
 Node* Graph::labelToNode(const Label& label) const
 {
+    QString key = QString::fromStdString(label.getLabelString());
+    // the nodes with the same label are next to each other in the index, the first one in _nodes is returned
     Node* result = NULL;
-    // search for the node with the same label
-    for (unsigned i = 0; i < this->_nodes.size(); ++i)
+    unsigned resultIndex = 0;
+    for (QMultiHash<QString, Node*>::const_iterator i = _labelIndex.constFind(key); i != _labelIndex.constEnd() && i.key() == key; ++i)
     {
-        result = _nodes.at(i);
-        if (result->getLabel() == label)
-            return result;
+        unsigned index = _nodeIndex.value(i.value());
+        if (result == NULL || index < resultIndex)
+        {
+            result = i.value();
+            resultIndex = index;
+        }
     }
+    return result;
+}
 
-    return NULL;
+// returns the edges of the graph row by row, row i are the edges of _nodes[i]
+SparseMatrix Graph::getSparseMatrix() const
+{
+    // the rows are walked through the virtual functions, so this works for each type of graph
+    const vector<Node*>& nodes = getNodes();
+    SparseMatrix result(nodes.size());
+    result.reserveEdges(getNumberOfEdges());
+    for (unsigned i = 0; i < nodes.size(); ++i)
+    {
+        AddToSparseMatrix addToSparseMatrix(*this, result, i);
+        forEachOutgoingEdge(nodes[i], addToSparseMatrix);
+    }
+    return result;
 }
 
 // returns the index of the node* in the vector of nodes
 int Graph::nodeToIndex(Node *node) const
 {
-    int index = -1;
-    if (!node)
-        return index;
-    for (unsigned i = 0; i < this->_nodes.size(); ++i)
+    QHash<Node*, unsigned>::const_iterator i = _nodeIndex.constFind(node);
+    if (i == _nodeIndex.constEnd())
+        return -1;
+    return i.value();
+}
+
+Node* Graph::idToNode(unsigned long id) const
+{
+    QHash<unsigned long, unsigned>::const_iterator i = _idIndex.constFind(id);
+    if (i == _idIndex.constEnd())
+        return NULL;
+    return _nodes[i.value()];
+}
+
+void Graph::indexNodesFrom(unsigned first)
+{
+    for (unsigned i = first; i < _nodes.size(); ++i)
     {
-        if (_nodes.at(i) == node)
-            return i;
+        _nodeIndex.insert(_nodes[i], i);
+        _idIndex.insert(_nodes[i]->getID(), i);
     }
-    return index;
 }
 
-Node* Graph::idToNode(unsigned long id) const
+void Graph::indexLabelsFrom(unsigned first)
 {
-    for (unsigned i = 0; i < _nodes.size(); ++i)
-        if (_nodes[i]->getID() == id)
-            return _nodes[i];
-    return NULL;
+    for (unsigned i = first; i < _nodes.size(); ++i)
+    {
+        _labelIndex.insert(QString::fromStdString(_nodes[i]->getLabel().getLabelString()), _nodes[i]);
+        _nodes[i]->_graph = this;
+    }
+}
+
+void Graph::unindexNode(unsigned index)
+{
+    Node* node = _nodes[index];
+    _nodeIndex.remove(node);
+    _idIndex.remove(node->getID());
+    _labelIndex.remove(QString::fromStdString(node->getLabel().getLabelString()), node);
+    node->_graph = NULL;
+}
+
+void Graph::relabelNode(Node* node, const Label& label)
+{
+    _labelIndex.remove(QString::fromStdString(node->getLabel().getLabelString()), node);
+    _labelIndex.insert(QString::fromStdString(label.getLabelString()), node);
+}
+
+Node* Graph::createNode(const Node& node)
+{
+    return new (_nodePool.allocate()) Node(node);
+}
+
+Edge* Graph::createEdge(const Edge& edge)
+{
+    return new (_edgePool.allocate()) Edge(edge);
+}
+
+Edge* Graph::createEdge(Node* source, Node* target, const Label& label)
+{
+    return new (_edgePool.allocate()) Edge(source, target, label);
+}
+
+void Graph::destroyNode(Node* node)
+{
+    if (_nodePool.owns(node))
+    {
+        node->~Node();
+        _nodePool.deallocate(node);
+    }
+    else
+        delete node;
+}
+
+void Graph::destroyEdge(Edge* edge)
+{
+    if (_edgePool.owns(edge))
+    {
+        edge->~Edge();
+        _edgePool.deallocate(edge);
+    }
+    else
+        delete edge;
 }
 
 bool Graph::isUniqueNode(const Label& label) const
@@ -133,13 +279,8 @@ bool Graph::isUniqueNode(const Label& label) const
     // empty labels are by definition unique
     if (label == Label(""))
         return true;
-    for (unsigned i = 0; i < _nodes.size(); ++i)
-    {
-        // return true if we find a node with the same label
-        if(_nodes[i]->getLabel() == label)
-            return false;
-    }
-    return true;
+    // unique if there is no node with the same label
+    return labelToNode(label) == NULL;
 }
 
 QDebug operator<<(QDebug dbg, const Graph& other)
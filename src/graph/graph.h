@@ -9,19 +9,27 @@
 #define GRAPH_H
 
 #include <QDebug>
+#include <QHash>
+#include <QString>
 #include <string>
 #include <vector>
 
 #include "graph/integermatrix.h"
+#include "graph/sparsematrix.h"
+#include "graph/distancematrix.h"
 #include "graphComp/label.h"
 #include "visitor/visitor.h"
 #include "observer/subject.h"
 #include "graphComp/node.h"
 #include "graphComp/edge.h"
+#include "edgefunctor.h"
+#include "objectpool.h"
+#include "graphbuilder.h"
 
 // avoid circular dependence
 class MatrixGraph;
 class ListGraph;
+class CSRGraph;
 
 using namespace std;
 
@@ -41,8 +49,15 @@ public:
     // the name functions are virtual because HybridGraph reimplements them so that these 2 functions are delegated it's state
     virtual string getName() const {return _name;}
     virtual void setName(const string& name) {_name = name;}
+    /* the distances between all pairs of nodes if the graph was read from a file that has them (see TSPLibReader), a large
+       instance has no edges but keeps it's real distances here. They belong to the nodes as they were read, adding or removing
+       a node forgets them. getDistances() returns NULL if the graph has no distances */
+    virtual void setDistances(const DistanceMatrix& distances);
+    virtual const DistanceMatrix* getDistances() const {return _distances.getNumberOfNodes() ? &_distances : NULL;}
     // returns the graph in the form of a two tuple (V, E)
     virtual IntegerMatrix getIntegerMatrix() const = 0;
+    // the same as getIntegerMatrix but only the edges are stored, node i is _nodes[i]. Use this for large graphs
+    virtual SparseMatrix getSparseMatrix() const;
     /* create a new Node with that label and add that using a help function, this function is only called from within graph
         when a node is created by another method, this function is public because the derived classes have to have this function
         publicly defined. Also this function can't be called directly because this class is abract*/
@@ -88,6 +103,10 @@ public:
     // a graph should be creatable from other types
     virtual void recreateFrom(const Graph& other) = 0;
     virtual void recreateFrom(const IntegerMatrix& integerMatrix) = 0;
+    virtual void recreateFrom(const SparseMatrix& sparseMatrix) = 0;
+    /* adds all the nodes and edges of the builder after the nodes that are already in the graph. The builder is validated first
+       (nothing is added if that throws), the edges aren't checked one by one and the observers are notified once */
+    virtual void addBatch(const GraphBuilder& builder) = 0;
 //    // returns true if there are no nodes nor edges
 //    virtual bool isEmpty() const {return _numberOfNodes == 0 && _numberOfEdges == 0;}
     // returns the neighbours of a node
@@ -98,6 +117,11 @@ public:
     virtual list<Edge*> getOutgoingEdges(Node* node) const = 0;
     // returns the incoming edges of a node
     virtual list<Edge*> getIncomingEdges(Node* node)  const = 0;
+    /* the same as the three functions above but without building a list, the functor is called for each edge (or neighbour)
+       straight from the structure of the graph. use these in algorithms that look at each edge */
+    virtual void forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const = 0;
+    virtual void forEachIncomingEdge(Node* node, EdgeFunctor& functor) const = 0;
+    virtual void forEachNeighbour(Node* node, NodeFunctor& functor) const = 0;
     // public because used in recreateFrom(Graph&)
     virtual int nodeToIndex(Node* node) const;
     // returns a default name for a node, we use label to convert the integer to a label
@@ -107,6 +131,8 @@ public:
     virtual list<Edge*> getLastAddedEdges();
     // returns a node that has the id given in the paramter or if that node isn't in the graph, returns NULL
     virtual Node* idToNode(unsigned long id) const;
+    // returns the first node with the given label or NULL if there is no such node (virtual because it's reimplemented in HybridGraph)
+    virtual Node* labelToNode(const Label& label) const;
     virtual string toString() const = 0;
     virtual string toStringID() const = 0;
     // does the graph contain an edge from source to target with Label label
@@ -116,13 +142,44 @@ public:
 
 protected:
     // help methods
-    // addEdge is properly defined in the deriven classes
-    Node* labelToNode(const Label& label) const;
     // returns true if the parameter is a unique label, meaning there is no other node with the same label
     bool isUniqueNode(const Label& label) const;
+    /* the nodes and edges of a graph are allocated from the pools of that graph, the derived classes use these functions
+       instead of new and delete. destroy also accepts objects that were allocated with new (see addNode(Node*)) */
+    Node* createNode(const Node& node);
+    Edge* createEdge(const Edge& edge);
+    Edge* createEdge(Node* source, Node* target, const Label& label = Label());
+    void destroyNode(Node* node);
+    void destroyEdge(Edge* edge);
+    // copies the distances of the other graph, used after the nodes of the other graph have been copied
+    void copyDistances(const Graph& other);
+    // used by addBatch: adds the nodes of the builder to _nodes and the indexes without notifying the observers
+    void addBatchNodes(const GraphBuilder& builder);
+    // allocates the edge of the builder, firstNode is the position in _nodes of the first node of the builder
+    Edge* createBatchEdge(const GraphBuilder::EdgeEntry& entry, unsigned firstNode);
    // virtual bool isUniqueEdge(Edge edge) const = 0;
 private:
+    // adds each edge it's called for to the row of it's source, used by getSparseMatrix
+    class AddToSparseMatrix : public EdgeFunctor
+    {
+    public:
+        AddToSparseMatrix(const Graph& graph, SparseMatrix& sparseMatrix, unsigned source) : _graph(graph), _sparseMatrix(sparseMatrix), _source(source) {}
+        bool operator()(Edge* edge) {_sparseMatrix.addEdge(_source, _graph.nodeToIndex(edge->getTarget())); return true;}
+    private:
+        const Graph& _graph;
+        SparseMatrix& _sparseMatrix;
+        unsigned _source;
+    };
     // help methods
+    // puts the nodes starting at position first in the index maps, called after nodes have been added or shifted
+    void indexNodesFrom(unsigned first);
+    // puts the labels of the nodes starting at position first in the label index, called after nodes have been added
+    void indexLabelsFrom(unsigned first);
+    // removes the node at position index from the index maps, the node itself has to be still valid
+    void unindexNode(unsigned index);
+    // called by Node::setLabel before the label of a node of this graph changes, moves the node in the label index
+    void relabelNode(Node* node, const Label& label);
+    friend class Node;
 
 protected:
     string _name;
@@ -132,6 +189,19 @@ protected:
     // keep track of the number of edges and nodes so that when the user of this class asks for these values, they don't have to be calculated.
     unsigned _numberOfEdges;
     unsigned _numberOfNodes;
+private:
+    /* hash indexes on _nodes so that the lookups don't have to scan the vector, these are kept up to date by
+       addNode, removeNode and removeNodes of this class (all the derived classes use these to change _nodes).
+       the label index holds every node under it's label, several nodes can have the same label. a node tells the graph
+       that holds it when it's label changes (see Node::setLabel) */
+    QHash<Node*, unsigned> _nodeIndex;
+    QHash<unsigned long, unsigned> _idIndex;
+    QMultiHash<QString, Node*> _labelIndex;
+    // see getDistances(), the matrix has no nodes if there are no distances
+    DistanceMatrix _distances;
+    // the memory for the nodes and edges, these are destroyed after the destructor of Graph removed the nodes
+    ObjectPool<Node> _nodePool;
+    ObjectPool<Edge> _edgePool;
 };
 
 #endif // GRAPH_H
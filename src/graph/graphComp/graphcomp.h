@@ -20,7 +20,8 @@ public:
     const Label& getLabel() const {return _label;}
     void setColor(const RGB& rgb);
 
-    void setLabel(const Label& label);
+    // virtual because Node tells it's graph about the new label
+    virtual void setLabel(const Label& label);
     // this makes it possible to tell the observers that the object will be deleted right before deletion
     bool getWillBeDeleted() const {return _willBeDeleted;}
     // can be called directly on a node to check if the label in the node has a cost, this method is delegated to the label class.
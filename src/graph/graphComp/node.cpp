@@ -1,4 +1,12 @@
 #include "node.h"
+#include "graph/graph.h"
+#include <QMutex>
+
+// the graphs of GraphBatchReader are filled by several threads at the same time, every node still needs it's own id
+static unsigned long nextId = 0;
+#ifndef __GNUC__
+static QMutex nextIdMutex;
+#endif
 
 Node::Node()
 {
@@ -6,6 +14,7 @@ Node::Node()
     _label = Label("");
     _willBeDeleted = false;
     _id = Node::getNextID();
+    _graph = NULL;
     // default constructor for the RGB class will be used and a black node will be created
 }
 
@@ -22,6 +31,7 @@ Node::Node(const Label& label)
     _label = label;
     _willBeDeleted = false;
     _id = Node::getNextID();
+    _graph = NULL;
 }
 
 // copying the observers would give us problems, so the observers aren't copied
@@ -32,6 +42,8 @@ Node::Node(const Node& other) : GraphComp()
     _willBeDeleted = other._willBeDeleted;
     _rgbColor = other._rgbColor;
     _id = other._id;
+    // the copy isn't in a graph yet
+    _graph = NULL;
 }
 
 Node::Node(const Label& label, const Point& coord)
@@ -40,6 +52,7 @@ Node::Node(const Label& label, const Point& coord)
     _coord = coord;
     _willBeDeleted = false;
     _id = Node::getNextID();
+    _graph = NULL;
     // default constructor for RGB class will be used
 }
 
@@ -50,15 +63,28 @@ Node::Node(const Label& label, const Point &coord, const RGB &rgb)
     _willBeDeleted = false;
     _rgbColor = rgb;
     _id = Node::getNextID();
+    _graph = NULL;
 }
 
 unsigned long Node::getNextID()
 {
-    static unsigned long _nextId = 0;
-    return _nextId++;
+#ifdef __GNUC__
+    return __sync_fetch_and_add(&nextId, 1);
+#else
+    QMutexLocker locker(&nextIdMutex);
+    return nextId++;
+#endif
 }
 
 
+void Node::setLabel(const Label& label)
+{
+    // the graph has to find the node under it's old label to move it
+    if (_graph)
+        _graph->relabelNode(this, label);
+    GraphComp::setLabel(label);
+}
+
 void Node::setCoords(const Point& coords)
 {
     // set the new coords
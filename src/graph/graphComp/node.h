@@ -13,6 +13,8 @@
 #include "observer/subject.h"
 #include "graphcomp.h"
 
+class Graph;
+
 class Node : public GraphComp
 {
 public:
@@ -32,6 +34,8 @@ public:
 
     const Point& getCoords() const {return _coord;}
     void setCoords(const Point& coords);
+    // also moves the node in the label index of the graph that holds it
+    void setLabel(const Label& label);
     //friends
     friend QDebug operator<<(QDebug dbg, const Node& other);
 protected:
@@ -39,6 +43,9 @@ protected:
     static unsigned long getNextID();
     unsigned long _id;
     Point _coord;
+    // the graph that holds this node (set by that graph), NULL if it's in no graph
+    Graph* _graph;
+    friend class Graph;
 };
 //unsigned long Node::_nextId = 0;
 #endif // NODE_H
@@ -0,0 +1,115 @@
+#include <algorithm>
+
+#include "graphbuilder.h"
+#include "graph.h"
+#include "graphComp/edge.h"
+#include "exception/uniqueedgeex.h"
+#include "exception/unexistingnodeex.h"
+
+unsigned GraphBuilder::addNode(const Node& node)
+{
+    _nodes.push_back(node);
+    return _nodes.size() - 1;
+}
+
+void GraphBuilder::addNodes(const vector<Node>& nodes)
+{
+    _nodes.insert(_nodes.end(), nodes.begin(), nodes.end());
+}
+
+void GraphBuilder::addEdge(unsigned source, unsigned target, const Label& label, const RGB& rgb)
+{
+    _edges.push_back(EdgeEntry(source, target, label, rgb));
+}
+
+void GraphBuilder::addCountedEdge(unsigned source, unsigned target, const Label& label, const RGB& rgb)
+{
+    _edges.push_back(EdgeEntry(source, target, label, rgb, true));
+}
+
+void GraphBuilder::addEdges(const vector<pair<unsigned, unsigned> >& edges)
+{
+    _edges.reserve(_edges.size() + edges.size());
+    for (vector<pair<unsigned, unsigned> >::const_iterator i = edges.begin(); i != edges.end(); ++i)
+        _edges.push_back(EdgeEntry(i->first, i->second, Label(), RGB()));
+}
+
+void GraphBuilder::addIntegerMatrix(const IntegerMatrix& integerMatrix)
+{
+    const vector<vector<unsigned> >& integers = integerMatrix.getMatrix();
+    unsigned first = _nodes.size();
+    _nodes.reserve(first + integers.size());
+    _edges.reserve(_edges.size() + integerMatrix.getNumberOfEdges());
+    // integermatrix doesn't have information about the nodes, use the same names as Graph::getNodeNameHint
+    for (unsigned i = 0; i < integers.size(); ++i)
+        _nodes.push_back(Node("Node " + Label(i).getLabelString()));
+    for (unsigned i = 0; i < integers.size(); ++i)
+        for (unsigned j = 0; j < integers[i].size(); ++j)
+            for (unsigned k = 0; k < integers[i][j]; ++k) // add k number of edges from i to j
+                _edges.push_back(EdgeEntry(first + i, first + j, Label(), RGB(), true));
+}
+
+void GraphBuilder::addSparseMatrix(const SparseMatrix& sparseMatrix)
+{
+    const vector<unsigned>& offsets = sparseMatrix.getOffsets();
+    const vector<SparseMatrix::Cell>& cells = sparseMatrix.getCells();
+    unsigned first = _nodes.size();
+    _nodes.reserve(first + sparseMatrix.getNumberOfNodes());
+    _edges.reserve(_edges.size() + sparseMatrix.getNumberOfEdges());
+    for (unsigned i = 0; i < sparseMatrix.getNumberOfNodes(); ++i)
+        _nodes.push_back(Node("Node " + Label(i).getLabelString()));
+    for (unsigned i = 0; i < sparseMatrix.getNumberOfNodes(); ++i)
+        for (unsigned k = offsets[i]; k < offsets[i + 1]; ++k)
+            for (unsigned m = 0; m < cells[k].multiplicity; ++m)
+                _edges.push_back(EdgeEntry(first + i, first + cells[k].column, Label(), RGB(), true));
+}
+
+void GraphBuilder::validate() const
+{
+    for (unsigned i = 0; i < _edges.size(); ++i)
+        if (_edges[i].source >= _nodes.size() || _edges[i].target >= _nodes.size())
+            throw UnexistingNodeEx(Node(), "The edge can't be created, because one (or both) node(s) are invalid", 2);
+
+    // sort the positions of the edges instead of the edges themselves, equal edges are next to each other after sorting
+    vector<unsigned> order(_edges.size());
+    for (unsigned i = 0; i < order.size(); ++i)
+        order[i] = i;
+    sort(order.begin(), order.end(), CompareEdges(_edges));
+    for (unsigned i = 1; i < order.size(); ++i)
+    {
+        const EdgeEntry& previous = _edges[order[i - 1]];
+        const EdgeEntry& current = _edges[order[i]];
+        // the edges that a matrix counts more than once are a multigraph, that's allowed
+        if (previous.counted && current.counted)
+            continue;
+        if (previous.source == current.source && previous.target == current.target && previous.label == current.label)
+        {
+            // the exception needs an edge, it refers to the nodes in the builder because the graph hasn't been changed
+            Node* source = const_cast<Node*>(&_nodes[current.source]);
+            Node* target = const_cast<Node*>(&_nodes[current.target]);
+            throw UniqueEdgeEx(Edge(source, target, current.label));
+        }
+    }
+}
+
+void GraphBuilder::commit(Graph& graph) const
+{
+    graph.addBatch(*this);
+}
+
+void GraphBuilder::clear()
+{
+    _nodes.clear();
+    _edges.clear();
+}
+
+bool GraphBuilder::CompareEdges::operator()(unsigned a, unsigned b) const
+{
+    const EdgeEntry& first = _edges[a];
+    const EdgeEntry& second = _edges[b];
+    if (first.source != second.source)
+        return first.source < second.source;
+    if (first.target != second.target)
+        return first.target < second.target;
+    return first.label.getLabelString() < second.label.getLabelString();
+}
@@ -0,0 +1,95 @@
+/*
+ Author: Balazs Nemeth
+ Description: GraphBuilder collects nodes and edges so that they can be added to a graph in one go. Adding the nodes and edges
+              one by one checks each edge for uniqueness against the graph and notifies the observers after each change,
+              with the builder the edges are validated in one pass (sorting them) and the graph notifies it's observers once.
+              The edges refer to the nodes by their position in the builder. Usage:
+
+                GraphBuilder builder;
+                builder.reserveNodes(n);
+                unsigned a = builder.addNode(Node("a"));
+                unsigned b = builder.addNode(Node("b"));
+                builder.addEdge(a, b, Label("x"));
+                builder.commit(graph); // the nodes and edges are added after the nodes that were already in the graph
+     */
+
+#ifndef GRAPHBUILDER_H
+#define GRAPHBUILDER_H
+
+#include <vector>
+#include <utility>
+
+#include "graphComp/node.h"
+#include "graphComp/label.h"
+#include "graphComp/rgb.h"
+#include "integermatrix.h"
+#include "sparsematrix.h"
+
+using namespace std;
+
+class Graph;
+
+class GraphBuilder
+{
+public:
+    // an edge between two nodes of the builder, the nodes are given by their position in the builder
+    struct EdgeEntry
+    {
+        EdgeEntry(unsigned source, unsigned target, const Label& label, const RGB& rgb, bool counted = false)
+            : source(source), target(target), label(label), rgb(rgb), counted(counted) {}
+        unsigned source;
+        unsigned target;
+        Label label;
+        RGB rgb;
+        // true if the edge comes from the count of a matrix, a count above 1 is a multigraph so these aren't unique
+        bool counted;
+    };
+
+    GraphBuilder() {}
+
+    // make room for the nodes and edges if the number is known in advance (like in the header of a file)
+    void reserveNodes(unsigned n) {_nodes.reserve(n);}
+    void reserveEdges(unsigned n) {_edges.reserve(n);}
+    // adds a node and returns it's position in the builder
+    unsigned addNode(const Node& node = Node());
+    void addNodes(const vector<Node>& nodes);
+    void addEdge(unsigned source, unsigned target, const Label& label = Label(), const RGB& rgb = RGB());
+    // adds an edge of a multigraph, the same counted edge can be added more than once (like the edges of a matrix)
+    void addCountedEdge(unsigned source, unsigned target, const Label& label = Label(), const RGB& rgb = RGB());
+    // adds edges without a label, each pair is the position of the source and the target
+    void addEdges(const vector<pair<unsigned, unsigned> >& edges);
+    // adds a node for each row of the matrix (with the default names) and the edges that the matrix counts, several times if the count is higher than 1
+    void addIntegerMatrix(const IntegerMatrix& integerMatrix);
+    // the same for a sparse matrix, only the cells that aren't 0 are visited
+    void addSparseMatrix(const SparseMatrix& sparseMatrix);
+
+    unsigned getNumberOfNodes() const {return _nodes.size();}
+    unsigned getNumberOfEdges() const {return _edges.size();}
+    const vector<Node>& getNodes() const {return _nodes;}
+    const vector<EdgeEntry>& getEdges() const {return _edges;}
+
+    /* checks all the edges at once, throws UnexistingNodeEx if an edge refers to a position that isn't a node in the builder and
+       UniqueEdgeEx if the same edge (source-target-label) is in the builder more than once, unless each time it comes from the
+       count of a matrix. Called by Graph::addBatch before the graph is changed */
+    void validate() const;
+    // adds all the nodes and edges to the graph (see Graph::addBatch)
+    void commit(Graph& graph) const;
+    // removes all the nodes and edges, the builder can be used for the next graph
+    void clear();
+
+private:
+    // orders the edges on source, target and label so that the same edges end up next to each other
+    class CompareEdges
+    {
+    public:
+        CompareEdges(const vector<EdgeEntry>& edges) : _edges(edges) {}
+        bool operator()(unsigned a, unsigned b) const;
+    private:
+        const vector<EdgeEntry>& _edges;
+    };
+
+    vector<Node> _nodes;
+    vector<EdgeEntry> _edges;
+};
+
+#endif // GRAPHBUILDER_H
@@ -0,0 +1,128 @@
+#include <assert.h>
+#include <QElapsedTimer>
+
+#include "csrstate.h"
+#include "graph/hybridgraph.h"
+#include "graph/hybridGraphState/liststate.h"
+
+CSRState::CSRState(HybridGraph* context, const HybridGraphState& other)
+{
+    assert(context);
+    // create this state from another state, the csr arrays are built in one pass
+    _graph = new CSRGraph(*(other.getGraph()));
+}
+
+void CSRState::addNode(HybridGraph *context, const Node& other)
+{
+    _graph->addNode(other);
+    thaw(context);
+}
+
+void CSRState::removeNodes(HybridGraph* context)
+{
+    _graph->removeNodes();
+    thaw(context);
+}
+
+void CSRState::removeNode(HybridGraph *context, unsigned index)
+{
+    _graph->removeNode(index);
+    thaw(context);
+}
+
+void CSRState::removeNode(HybridGraph* context, unsigned long ID)
+{
+    _graph->removeNode(ID);
+    thaw(context);
+}
+
+void CSRState::removeNode(HybridGraph *context, Node *node)
+{
+    _graph->removeNode(node);
+    thaw(context);
+}
+
+void CSRState::addEdge(HybridGraph* context, unsigned sourceIndex, unsigned targetIndex, const Label& label)
+{
+    _graph->addEdge(sourceIndex, targetIndex, label);
+    thaw(context);
+}
+
+void CSRState::addEdge(HybridGraph *context, unsigned long sourceID, unsigned long targetID, const Label& label)
+{
+    _graph->addEdge(sourceID, targetID, label);
+    thaw(context);
+}
+
+void CSRState::addEdge(HybridGraph *context, const Edge& edge)
+{
+    _graph->addEdge(edge);
+    thaw(context);
+}
+
+void CSRState::removeEdges(HybridGraph* context)
+{
+    _graph->removeEdges();
+    thaw(context);
+}
+
+void CSRState::removeEdge(HybridGraph *context, unsigned sourceIndex, unsigned targetIndex, const Label& label)
+{
+    _graph->removeEdge(sourceIndex, targetIndex, label);
+    thaw(context);
+}
+
+void CSRState::removeEdge(HybridGraph *context, unsigned long sourceID, unsigned long targetID, const Label& label)
+{
+    _graph->removeEdge(sourceID, targetID, label);
+    thaw(context);
+}
+
+void CSRState::removeEdge(HybridGraph* context, Node* source, Node* target, const Label& label)
+{
+    _graph->removeEdge(source, target, label);
+    thaw(context);
+}
+
+void CSRState::recreateFrom(HybridGraph* context, const Graph& other)
+{
+    assert(context);
+    delete _graph;
+    _graph = new CSRGraph(other);
+}
+
+void CSRState::recreateFrom(HybridGraph* context, const IntegerMatrix& other)
+{
+    assert(context);
+    _graph->recreateFrom(other);
+}
+
+void CSRState::recreateFrom(HybridGraph* context, const SparseMatrix& other)
+{
+    assert(context);
+    _graph->recreateFrom(other);
+}
+
+void CSRState::addBatch(HybridGraph* context, const GraphBuilder& builder)
+{
+    assert(context);
+    // the new rows are appended to the csr arrays in one pass, so the graph can stay frozen
+    _graph->addBatch(builder);
+}
+
+void CSRState::thaw(HybridGraph* context)
+{
+    // context can't be the NULL pointer and can only be caused by programming error
+    assert(context);
+    QElapsedTimer timer;
+    timer.start();
+    setState(context, new ListState(context, *this)); // this will "delete this"
+    context->getCostModel().recordTransition(timer.nsecsElapsed() / 1000000.0);
+}
+
+// friend
+QDebug operator<<(QDebug dbg, const CSRState& other)
+{
+    dbg.nospace() << other.toString().c_str();
+    return dbg.space();
+}
@@ -0,0 +1,52 @@
+/*
+ Author: Balazs Nemeth
+ Description: This class represents the frozen "analysis" state. The graph is kept in a CSRGraph so that algorithms can run over it
+              as fast as possible. The HybridGraph gets into this state when it's frozen (HybridGraph::freeze(), this is done
+              by HybridGraph::accept before a visitor that only reads the graph), any change to the structure of the graph thaws it again, after which the graph continues in the ListState
+     */
+#ifndef CSRSTATE_H
+#define CSRSTATE_H
+
+#include "graph/graphComp/edge.h"
+#include "graph/csrgraph.h"
+#include "graph/hybridGraphState/hybridgraphstate.h"
+
+class CSRState : public HybridGraphState
+{
+public:
+    CSRState() {_graph = new CSRGraph();}
+    CSRState(string name) {_graph = new CSRGraph(name);}
+    // copy the state from another state, this is how the graph gets frozen
+    CSRState(HybridGraph* context, const HybridGraphState& other);
+    CSRState(const IntegerMatrix& other) {_graph = new CSRGraph(other);}
+    // the functions that change the structure of the graph are done on the CSRGraph, after that the state thaws to the ListState
+    void addNode(HybridGraph *context, const Node& other);
+    void removeNodes(HybridGraph* context);
+    void removeNode(HybridGraph* context, unsigned index);
+    void removeNode(HybridGraph* context, unsigned long ID);
+    void removeNode(HybridGraph* context, Node* node);
+    void addEdge(HybridGraph* context, unsigned sourceIndex, unsigned targetIndex, const Label& label);
+    void addEdge(HybridGraph* context, unsigned long sourceID, unsigned long targetID, const Label& label);
+    void addEdge(HybridGraph* context, const Edge& edge);
+    void removeEdges(HybridGraph* context);
+    void removeEdge(HybridGraph* context, unsigned sourceIndex, unsigned targetIndex, const Label& label);
+    void removeEdge(HybridGraph* context, unsigned long sourceID, unsigned long targetID, const Label& label);
+    void removeEdge(HybridGraph* context, Node* source, Node* target, const Label& label);
+    // recreating the graph is a bulk operation, the csr arrays are rebuilt in one pass and the graph stays frozen
+    void recreateFrom(HybridGraph* context, const Graph& other);
+    void recreateFrom(HybridGraph* context, const IntegerMatrix& other);
+    void recreateFrom(HybridGraph* context, const SparseMatrix& other);
+    void addBatch(HybridGraph* context, const GraphBuilder& builder);
+    // the graph is already frozen
+    void freeze(HybridGraph*) {}
+    bool isFrozen() const {return true;}
+    // the copy gets it's own graph, the states delete their graph
+    HybridGraphState* clone() const {CSRState* copy = new CSRState(getName()); copy->_graph->recreateFrom(*_graph); return copy;}
+    // friends
+    friend QDebug operator<<(QDebug dbg, const CSRState& other);
+private:
+    // switches to the ListState, this is called after every change to the structure of the graph
+    void thaw(HybridGraph* context);
+};
+
+#endif // CSRSTATE_H
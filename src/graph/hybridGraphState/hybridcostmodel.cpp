@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <sstream>
+
+#include "hybridcostmodel.h"
+
+HybridCostModel::HybridCostModel()
+{
+    _edgeQueries = 0;
+    _neighbourScans = 0;
+    _edgeMutations = 0;
+    _nodeMutations = 0;
+    // the defaults: twice as cheap, decided every 64 operations, at most 1024*1024 cells
+    _hysteresis = 2.0;
+    _window = 64;
+    _maxMatrixNodes = 1024;
+    _copyCost = 4.0;
+}
+
+void HybridCostModel::setHysteresis(double hysteresis)
+{
+    // a hysteresis below 1 would make the graph switch to a representation that is more expensive
+    assert(hysteresis >= 1.0);
+    _hysteresis = hysteresis;
+}
+
+HybridCostModel::Representation HybridCostModel::choose(Representation current, unsigned n, unsigned e)
+{
+    // a matrix of a big graph takes too much memory, whatever the operations are
+    if (n > _maxMatrixNodes)
+        return LIST;
+    // for very small graphs both representations are the same
+    if (n < 3 || operationsSeen() < _window)
+        return current;
+
+    Representation other = (current == LIST) ? MATRIX : LIST;
+    double currentCost = operationCost(current, n, e);
+    double otherCost = operationCost(other, n, e);
+    // what we would have won over the last window if we were in the other representation
+    double gain = (currentCost - otherCost) * operationsSeen();
+    decay();
+
+    if (otherCost * _hysteresis < currentCost && gain > _copyCost * (n + e))
+        return other;
+    return current;
+}
+
+void HybridCostModel::recordTransition(double milliseconds)
+{
+    _copyTimes.push_back(milliseconds);
+    // the new representation gets a full window before it can be switched again
+    _edgeQueries = _neighbourScans = _edgeMutations = _nodeMutations = 0;
+}
+
+double HybridCostModel::getTotalCopyTime() const
+{
+    double total = 0;
+    for (unsigned i = 0; i < _copyTimes.size(); ++i)
+        total += _copyTimes[i];
+    return total;
+}
+
+string HybridCostModel::toString() const
+{
+    ostringstream stream;
+    stream << getNumberOfTransitions() << " state switches, " << getTotalCopyTime() << " msecs copying";
+    if (!_copyTimes.empty())
+        stream << " (last " << _copyTimes.back() << " msecs)";
+    return stream.str();
+}
+
+double HybridCostModel::operationCost(Representation representation, unsigned n, unsigned e) const
+{
+    // the average number of edges per node, this is what a list has to walk
+    double degree = n ? double(e) / n : 0;
+    double queryCost, scanCost, edgeMutationCost, nodeMutationCost;
+    if (representation == LIST)
+    {
+        // everything walks the list of one node, adding an edge checks if it's unique first
+        queryCost = 1 + degree;
+        scanCost = 1 + degree;
+        edgeMutationCost = 1 + degree;
+        nodeMutationCost = 1 + degree;
+    }
+    else
+    {
+        // the average number of edges in one cell of the matrix
+        double multiplicity = n ? double(e) / (double(n) * n) : 0;
+        queryCost = 1 + multiplicity;
+        // a scan has to look at each word of the row, a word holds 64 cells
+        scanCost = n / 64.0 + degree;
+        edgeMutationCost = 1 + multiplicity;
+        // adding or removing a node changes a row and a column
+        nodeMutationCost = 2.0 * n;
+    }
+    double total = operationsSeen();
+    if (total == 0)
+        return 0;
+    return (_edgeQueries * queryCost + _neighbourScans * scanCost + _edgeMutations * edgeMutationCost
+            + _nodeMutations * nodeMutationCost) / total;
+}
+
+void HybridCostModel::decay()
+{
+    _edgeQueries /= 2;
+    _neighbourScans /= 2;
+    _edgeMutations /= 2;
+    _nodeMutations /= 2;
+}
@@ -0,0 +1,80 @@
+/*
+ Author: Balazs Nemeth
+ Description: HybridCostModel decides if a HybridGraph should be in the ListState or in the MatrixState. HybridGraph counts the
+              operations that are done on it (edge queries, neighbour scans and mutations) and the states ask the model after each
+              change which representation fits the measured operation mix best. To prevent the graph from switching back and forth
+              near the point where both are equally good, the other representation has to be cheaper by a factor (the hysteresis)
+              and the gain over the last window of operations has to pay for copying the graph.
+              The model also keeps the number of transitions and how long each copy took (freezing and thawing included),
+              these are shown in the status bar of the GUI, by the command line and in the debug output of HybridGraph.
+     */
+
+#ifndef HYBRIDCOSTMODEL_H
+#define HYBRIDCOSTMODEL_H
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+class HybridCostModel
+{
+public:
+    enum Representation { LIST, MATRIX };
+
+    HybridCostModel();
+
+    // the operations that are counted, these are called by HybridGraph
+    void recordEdgeQuery() {++_edgeQueries;}
+    void recordNeighbourScan() {++_neighbourScans;}
+    void recordEdgeMutation() {++_edgeMutations;}
+    void recordNodeMutation() {++_nodeMutations;}
+
+    // returns the representation a graph with n nodes and e edges should be in, current is the one it's in now
+    Representation choose(Representation current, unsigned n, unsigned e);
+    // has to be called after a transition, milliseconds is the time it took to copy the graph
+    void recordTransition(double milliseconds);
+
+    // configuration
+    // the other representation has to be this many times cheaper before we switch (>= 1)
+    void setHysteresis(double hysteresis);
+    double getHysteresis() const {return _hysteresis;}
+    // the number of operations that have to be seen before a decision is made
+    void setWindow(unsigned operations) {_window = operations;}
+    unsigned getWindow() const {return _window;}
+    // graphs with more nodes than this are never put in a matrix, a matrix uses n*n cells
+    void setMaxMatrixNodes(unsigned nodes) {_maxMatrixNodes = nodes;}
+    unsigned getMaxMatrixNodes() const {return _maxMatrixNodes;}
+    // the cost of copying one node or edge when the representation changes, in the same unit as the cost of an operation
+    void setCopyCost(double cost) {_copyCost = cost;}
+    double getCopyCost() const {return _copyCost;}
+
+    // statistics
+    unsigned getNumberOfTransitions() const {return _copyTimes.size();}
+    // the time each transition took to copy the graph in milliseconds
+    const vector<double>& getCopyTimes() const {return _copyTimes;}
+    double getTotalCopyTime() const;
+    // the statistics in one line, like "3 state switches, 12.5 msecs copying (last 4.1 msecs)"
+    string toString() const;
+
+private:
+    // the estimated cost of one operation of the measured mix
+    double operationCost(Representation representation, unsigned n, unsigned e) const;
+    unsigned operationsSeen() const {return _edgeQueries + _neighbourScans + _edgeMutations + _nodeMutations;}
+    // halves the counters so that the mix follows the recent operations
+    void decay();
+
+    unsigned _edgeQueries;
+    unsigned _neighbourScans;
+    unsigned _edgeMutations;
+    unsigned _nodeMutations;
+
+    double _hysteresis;
+    unsigned _window;
+    unsigned _maxMatrixNodes;
+    double _copyCost;
+
+    vector<double> _copyTimes;
+};
+
+#endif // HYBRIDCOSTMODEL_H
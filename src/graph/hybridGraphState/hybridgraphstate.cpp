@@ -1,6 +1,9 @@
 #include "hybridgraphstate.h"
 #include "graph/hybridgraph.h"
+#include "graph/hybridGraphState/csrstate.h"
 #include <QDebug>
+#include <QHash>
+#include <QElapsedTimer>
 
 // this function will be called like so: changeState(context, new ListGraph(..))
 void HybridGraphState::setState(HybridGraph* context, HybridGraphState* state)
@@ -15,6 +18,21 @@ void HybridGraphState::setState(HybridGraph* context, HybridGraphState* state)
     context->setOldState(this);
 }
 
+void HybridGraphState::freeze(HybridGraph* context)
+{
+    QElapsedTimer timer;
+    timer.start();
+    setState(context, new CSRState(context, *this)); // this will "delete this"
+    context->getCostModel().recordTransition(timer.nsecsElapsed() / 1000000.0);
+}
+
+HybridGraphState::~HybridGraphState()
+{
+    // the observers of the graph itself are copied to the new state by HybridGraph, they don't have to know about this graph anymore
+    _graph->unregisterAllObservers();
+    delete _graph;
+}
+
 void HybridGraphState::moveNodeObservers(HybridGraphState* toState)
 {
     // copy the observers, start by copying the node observers
@@ -39,26 +57,37 @@ void HybridGraphState::moveEdgeObservers(HybridGraphState* toState)
     collectEdges(this, oldEdges);
     list<Edge*> newEdges;
     collectEdges(toState, newEdges);
-    bool skipRest;
-    // the next part has complexity n^2, because for each edge, we have to seach for the corresponding edge
+    // the new edges are indexed by the IDs of their nodes, so each old edge finds it's copy without searching all the edges
+    QMultiHash<unsigned long long, Edge*> index;
+    index.reserve(newEdges.size());
+    for (list<Edge*>::iterator j = newEdges.begin(); j != newEdges.end(); ++j)
+        index.insert(edgeKey(*j), *j);
     for (list<Edge*>::iterator i = oldEdges.begin(); i != oldEdges.end(); ++i)
     {
-        skipRest = false;
-        for(list<Edge*>::iterator j = newEdges.begin(); !skipRest && j != newEdges.end(); ++j)
+        unsigned long long key = edgeKey(*i);
+        for (QMultiHash<unsigned long long, Edge*>::const_iterator j = index.constFind(key); j != index.constEnd() && j.key() == key; ++j)
         {
-
-           if ((*j)->getSource()->getID() == (*i)->getSource()->getID() &&
-                   (*j)->getTarget()->getID() == (*i)->getTarget()->getID() && (*i)->getLabel() == (*j)->getLabel())
-           {
-               skipRest = true;
-               (*j)->registerObservers((*i)->getObservers());
-               (*j)->notifyObservers();
-               (*i)->unregisterAllObservers();
-           }
+            Edge* copy = j.value();
+            if (copy->getSource()->getID() == (*i)->getSource()->getID() &&
+                    copy->getTarget()->getID() == (*i)->getTarget()->getID() && (*i)->getLabel() == copy->getLabel())
+            {
+                copy->registerObservers((*i)->getObservers());
+                copy->notifyObservers();
+                (*i)->unregisterAllObservers();
+                // the same edge can be in a multigraph more than once, each copy gets the observers of one old edge
+                index.remove(key, copy);
+                break;
+            }
         }
     }
 }
 
+unsigned long long HybridGraphState::edgeKey(Edge* edge)
+{
+    // the IDs of two nodes can give the same key, the edges with the same key are compared
+    return ((unsigned long long)edge->getSource()->getID() << 32) ^ edge->getTarget()->getID();
+}
+
 void HybridGraphState::collectEdges(HybridGraphState *state, list<Edge*>& edges)
 {
     Graph* graph = state->getGraph();
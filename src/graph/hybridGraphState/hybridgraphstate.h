@@ -17,6 +17,7 @@
 class HybridGraph;
 class MatrixState;
 class ListState;
+class CSRState;
 class Node;
 
 using namespace std;
@@ -24,6 +25,8 @@ using namespace std;
 class HybridGraphState
 {
 public:
+    // deletes the graph of the state, the observers have been moved to the new state before this happens
+    virtual ~HybridGraphState();
     virtual void removeNodes(HybridGraph* context) = 0;
     virtual void removeNode(HybridGraph* context, unsigned index) = 0;
     virtual void removeNode(HybridGraph* context, unsigned long ID) = 0;
@@ -37,23 +40,36 @@ public:
     virtual void removeEdge(HybridGraph* context, Node* source, Node* target, const Label& label) = 0;
     virtual void recreateFrom(HybridGraph* context, const Graph& other) = 0;
     virtual void recreateFrom(HybridGraph *context, const IntegerMatrix& other) = 0;
+    virtual void recreateFrom(HybridGraph *context, const SparseMatrix& other) = 0;
+    virtual void addBatch(HybridGraph* context, const GraphBuilder& builder) = 0;
     virtual void addNode(HybridGraph *context, const Node& other) = 0;
 
     virtual HybridGraphState* clone() const = 0;
+    // switches to the frozen CSRState, this is the same for every state that isn't frozen yet
+    virtual void freeze(HybridGraph* context);
+    // returns true if the state is the frozen analysis state
+    virtual bool isFrozen() const {return false;}
 
     // the next functions are basicly delegated to the underlying class, nothing special has to be done
     string getName() const {return _graph->getName();}
     int nodeToIndex(Node* node) const {return _graph->nodeToIndex(node);}
     Node* idToNode(unsigned long id) const {return _graph->idToNode(id);}
+    Node* labelToNode(const Label& label) const {return _graph->labelToNode(label);}
     list<Node*> getLastAddedNodes() {return _graph->getLastAddedNodes();}
     list<Edge*> getLastAddedEdges() {return _graph->getLastAddedEdges();}
     void setName(string name) {_graph->setName(name);}
+    void setDistances(const DistanceMatrix& distances) {_graph->setDistances(distances);}
+    const DistanceMatrix* getDistances() const {return _graph->getDistances();}
     unsigned getNumberOfEdges() const {return _graph->getNumberOfEdges();}
     unsigned getNumberOfNodes() const {return _graph->getNumberOfNodes();}
     list<Node*> getNeighbours(Node* node) const {return _graph->getNeighbours(node);}
     list<Edge*> getOutgoingEdges(Node* node) const {return _graph->getOutgoingEdges(node);}
     list<Edge*> getIncomingEdges(Node* node) const {return _graph->getIncomingEdges(node);}
+    void forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const {_graph->forEachOutgoingEdge(node, functor);}
+    void forEachIncomingEdge(Node* node, EdgeFunctor& functor) const {_graph->forEachIncomingEdge(node, functor);}
+    void forEachNeighbour(Node* node, NodeFunctor& functor) const {_graph->forEachNeighbour(node, functor);}
     IntegerMatrix getIntegerMatrix() const {return _graph->getIntegerMatrix();}
+    SparseMatrix getSparseMatrix() const {return _graph->getSparseMatrix();}
     string toString() const {return _graph->toString();}
     string toStringID() const {return _graph->toStringID();}
     const vector<Node*>& getNodes() const {return _graph->getNodes();}
@@ -65,6 +81,8 @@ public:
 protected:
     // help function for moving the observers from the old edges to the new edges
     void moveEdgeObservers(HybridGraphState* toState);
+    // the key of an edge in the index of moveEdgeObservers, made from the IDs of it's nodes
+    static unsigned long long edgeKey(Edge* edge);
     // help function for moving the observers from the old nodes to the new nodes
     void moveNodeObservers(HybridGraphState* toState);
     // collect the edges from a given graph, the edges will be put in the list given as a second parameter, this way, we don't call the copyconstructor of list
@@ -1,7 +1,7 @@
 #include <assert.h>
-// needed for round to decide if the condition for the state switch is met
-#include <math.h>
+#include <QElapsedTimer>
 #include "liststate.h"
+#include "graph/hybridgraph.h"
 #include "graph/hybridGraphState/matrixstate.h"
 
 ListState::ListState(HybridGraph* context, const Graph& other)
@@ -12,9 +12,9 @@ ListState::ListState(HybridGraph* context, const Graph& other)
 
 ListState::ListState(HybridGraph* context, const HybridGraphState& other)
 {
-    // first check that the state that is being constructor is the right state
-    switchState(context, other.getNumberOfNodes(), other.getNumberOfEdges());
-    // create this state from another state
+    assert(context);
+    /* create this state from another state, the state is not switched from within the constructor because the context
+       isn't pointing to this state yet, the next change to the graph will decide if a switch is needed */
     _graph = new ListGraph(*(other.getGraph()));
 }
 
@@ -24,6 +24,12 @@ void ListState::recreateFrom(HybridGraph *context, const IntegerMatrix &other)
     switchState(context);
 }
 
+void ListState::recreateFrom(HybridGraph *context, const SparseMatrix &other)
+{
+    _graph->recreateFrom(other);
+    switchState(context);
+}
+
 void ListState::removeNodes(HybridGraph* context)
 {
     _graph->removeNodes();
@@ -101,6 +107,12 @@ void ListState::recreateFrom(HybridGraph* context, const Graph& other)
     switchState(context, other.getNumberOfEdges(), other.getNumberOfNodes());
 }
 
+void ListState::addBatch(HybridGraph* context, const GraphBuilder& builder)
+{
+    _graph->addBatch(builder);
+    switchState(context);
+}
+
 void ListState::addNode(HybridGraph *context, const Node& other)
 {
     _graph->addNode(other);
@@ -118,11 +130,13 @@ void ListState::switchState(HybridGraph* context, float e, float n)
 {
     // context can't be the NULL pointer and can only be caused by programming error
     assert(context);
-    // we have to switch to matrixstate if the following condition is true
-    if (e > (n*n) && n >= 3)
+    // the cost model compares the measured operations on both representations
+    if (context->getCostModel().choose(HybridCostModel::LIST, n, e) == HybridCostModel::MATRIX)
     {
-        qDebug() << "Setting state to: MatrixState";
+        QElapsedTimer timer;
+        timer.start();
         setState(context, new MatrixState(context , *this)); // this will "delete this"
+        context->getCostModel().recordTransition(timer.nsecsElapsed() / 1000000.0);
     }
 }
 
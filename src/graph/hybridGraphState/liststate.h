@@ -36,8 +36,11 @@ public:
     void removeEdge(HybridGraph *context, unsigned long sourceID, unsigned long targetID, const Label& label);
     void recreateFrom(HybridGraph* context, const Graph& other);
     void recreateFrom(HybridGraph* context, const IntegerMatrix& other);
+    void recreateFrom(HybridGraph* context, const SparseMatrix& other);
+    void addBatch(HybridGraph* context, const GraphBuilder& builder);
     void removeEdge(HybridGraph* context, Node* source, Node* target, const Label& label);
-    HybridGraphState* clone() const {return new ListState(*this);}
+    // the copy gets it's own graph, the states delete their graph
+    HybridGraphState* clone() const {ListState* copy = new ListState(getName()); copy->_graph->recreateFrom(*_graph); return copy;}
     // friends
     friend QDebug operator<<(QDebug dbg, const ListState& other);
 private:
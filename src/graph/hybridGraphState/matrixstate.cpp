@@ -1,5 +1,5 @@
-#include <math.h>
 #include <assert.h>
+#include <QElapsedTimer>
 
 #include "matrixstate.h"
 #include "graph/hybridgraph.h"
@@ -13,9 +13,10 @@ MatrixState::MatrixState(HybridGraph* context, const Graph& other)
 
 MatrixState::MatrixState(HybridGraph* context, const HybridGraphState& other)
 {
-    // create this state from another state
+    assert(context);
+    /* create this state from another state, the state is not switched from within the constructor because the context
+       isn't pointing to this state yet, the next change to the graph will decide if a switch is needed */
     _graph = new MatrixGraph(*(other.getGraph()));
-    switchState(context, other.getNumberOfEdges(), other.getNumberOfNodes());
 }
 
 void MatrixState::recreateFrom(HybridGraph *context, const IntegerMatrix &other)
@@ -24,6 +25,12 @@ void MatrixState::recreateFrom(HybridGraph *context, const IntegerMatrix &other)
     switchState(context);
 }
 
+void MatrixState::recreateFrom(HybridGraph *context, const SparseMatrix &other)
+{
+    _graph->recreateFrom(other);
+    switchState(context);
+}
+
 void MatrixState::addNode(HybridGraph *context, const Node& other)
 {
     _graph->addNode(other);
@@ -69,8 +76,8 @@ void MatrixState::removeEdge(HybridGraph* context, Node* source, Node* target, c
 
 void MatrixState::removeEdges(HybridGraph* context)
 {
-    switchState(context, 0, _graph->getNumberOfNodes());
     _graph->removeEdges();
+    switchState(context, 0, _graph->getNumberOfNodes());
 }
 
 void MatrixState::removeEdge(HybridGraph *context, unsigned sourceIndex, unsigned targetIndex, const Label& label)
@@ -107,6 +114,12 @@ void MatrixState::recreateFrom(HybridGraph* context, const Graph& other)
     switchState(context, other.getNumberOfEdges(), other.getNumberOfNodes());
 }
 
+void MatrixState::addBatch(HybridGraph* context, const GraphBuilder& builder)
+{
+    _graph->addBatch(builder);
+    switchState(context);
+}
+
 void MatrixState::switchState(HybridGraph* context)
 {
     switchState(context, getNumberOfEdges(), getNumberOfNodes());
@@ -114,10 +127,14 @@ void MatrixState::switchState(HybridGraph* context)
 
 void MatrixState::switchState(HybridGraph* context, float e, float n)
 {
-    if (round(e*1.1F) <= (n*n) && n >= 3)
+    assert(context);
+    // the cost model compares the measured operations on both representations
+    if (context->getCostModel().choose(HybridCostModel::MATRIX, n, e) == HybridCostModel::LIST)
     {
-        qDebug() << "Setting state to: ListState";
+        QElapsedTimer timer;
+        timer.start();
         setState(context, new ListState(context, *this)); // this will "delete this"
+        context->getCostModel().recordTransition(timer.nsecsElapsed() / 1000000.0);
     }
 }
 
@@ -28,6 +28,7 @@ HybridGraph::HybridGraph(const Graph &other)
 
 void HybridGraph::addNode(const Node& other)
 {
+    _costModel.recordNodeMutation();
     _state->addNode(this, other);
     deleteOldState();
     notifyObservers();
@@ -40,6 +41,20 @@ void HybridGraph::recreateFrom(const IntegerMatrix& other)
     notifyObservers();
 }
 
+void HybridGraph::recreateFrom(const SparseMatrix& other)
+{
+    _state->recreateFrom(this, other);
+    deleteOldState();
+    notifyObservers();
+}
+
+void HybridGraph::addBatch(const GraphBuilder& builder)
+{
+    _state->addBatch(this, builder);
+    deleteOldState();
+    notifyObservers();
+}
+
 // removes nodes
 void HybridGraph::removeNodes()
 {
@@ -61,6 +76,7 @@ void HybridGraph::deleteOldState()
 
 void HybridGraph::removeNode(Node *node)
 {
+    _costModel.recordNodeMutation();
     _state->removeNode(this, node);
     deleteOldState();
     notifyObservers();
@@ -68,6 +84,7 @@ void HybridGraph::removeNode(Node *node)
 
 void HybridGraph::removeNode(unsigned id)
 {
+    _costModel.recordNodeMutation();
     _state->removeNode(this, id);
     deleteOldState();
     notifyObservers();
@@ -75,6 +92,7 @@ void HybridGraph::removeNode(unsigned id)
 
 void HybridGraph::removeNode(unsigned long ID)
 {
+    _costModel.recordNodeMutation();
     _state->removeNode(this, ID);
     deleteOldState();
     notifyObservers();
@@ -82,6 +100,7 @@ void HybridGraph::removeNode(unsigned long ID)
 
 void HybridGraph::removeEdge(unsigned sourceID, unsigned targetID, const Label& label)
 {
+    _costModel.recordEdgeMutation();
     _state->removeEdge(this, sourceID, targetID, label);
     deleteOldState();
     notifyObservers();
@@ -89,6 +108,7 @@ void HybridGraph::removeEdge(unsigned sourceID, unsigned targetID, const Label&
 
 void HybridGraph::removeEdge(unsigned long sourceID, unsigned long targetID, const Label& label)
 {
+    _costModel.recordEdgeMutation();
     _state->removeEdge(this, sourceID, targetID, label);
     deleteOldState();
     notifyObservers();
@@ -96,6 +116,7 @@ void HybridGraph::removeEdge(unsigned long sourceID, unsigned long targetID, con
 
 void HybridGraph::addEdge(unsigned sourceID, unsigned targetID, const Label& label)
 {
+    _costModel.recordEdgeMutation();
     _state->addEdge(this, sourceID, targetID, label);
     deleteOldState();
     notifyObservers();
@@ -103,6 +124,7 @@ void HybridGraph::addEdge(unsigned sourceID, unsigned targetID, const Label& lab
 
 void HybridGraph::addEdge(unsigned long sourceID, unsigned long targetID, const Label& label)
 {
+    _costModel.recordEdgeMutation();
     _state->addEdge(this, sourceID, targetID, label);
     deleteOldState();
     notifyObservers();
@@ -110,6 +132,7 @@ void HybridGraph::addEdge(unsigned long sourceID, unsigned long targetID, const
 
 void HybridGraph::addEdge(const Edge& edge)
 {
+    _costModel.recordEdgeMutation();
     _state->addEdge(this, edge);
     deleteOldState();
     notifyObservers();
@@ -124,11 +147,19 @@ void HybridGraph::removeEdges()
 
 void HybridGraph::removeEdge(Node* source, Node* target, const Label& label)
 {
+    _costModel.recordEdgeMutation();
     _state->removeEdge(this, source, target, label);
     deleteOldState();
     notifyObservers();
 }
 
+void HybridGraph::freeze()
+{
+    _state->freeze(this);
+    deleteOldState();
+    notifyObservers();
+}
+
 // recreates from other graphtypes
 void HybridGraph::recreateFrom(const Graph& other)
 {
@@ -142,7 +173,6 @@ void HybridGraph::recreateFrom(const Graph& other)
 // TODO: determin the state before starting the copy of the integerMatrix
 HybridGraph::HybridGraph(const IntegerMatrix& integerMatrix)
 {
-    delete _state;
     _oldState = NULL;
     // default startingstate is list because an empty graph is sparse
     _state = new ListState(integerMatrix);
@@ -161,12 +191,12 @@ HybridGraph::~HybridGraph()
 // friend
 QDebug operator<<(QDebug dbg, const HybridGraph& other)
 {
-    dbg.nospace() << *(other._state);
+    dbg.nospace() << *(other._state) << other._costModel.toString().c_str();
     return dbg.space();
 }
 
 ostream& operator<<(ostream& dbg, const HybridGraph& other)
 {
-    cout << other.toString();
+    cout << other.toString() << other._costModel.toString() << endl;
     return dbg;
 }
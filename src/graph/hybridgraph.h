@@ -1,7 +1,7 @@
 /*
  Author: Balazs Nemeth
- Description: This class is a special in the sense that it uses the statepattern to switch between exactly 2 states,
-              namely MatrixState and ListState
+ Description: This class is a special in the sense that it uses the statepattern to switch between the states
+              MatrixState and ListState, a third state (CSRState) is only used when the graph is frozen for analysis
               This allows us to use the best implementation for each possible graph.
               For a sparse graph an adjacencyList-list implementation is optimal while for a dense graph a adjacencyList-matrix
               implementation is a better choice.
@@ -17,6 +17,7 @@
 #include "matrixgraph.h"
 #include "listgraph.h"
 #include "graph/hybridGraphState/hybridgraphstate.h"
+#include "graph/hybridGraphState/hybridcostmodel.h"
 #include "graph/integermatrix.h"
 #include "graphComp/edge.h"
 
@@ -38,8 +39,11 @@ public:
         these doens't change the graph itself */
     string getName() const {return _state->getName();}
     void setName(const string& name) {_state->setName(name);}
+    void setDistances(const DistanceMatrix& distances) {_state->setDistances(distances);}
+    const DistanceMatrix* getDistances() const {return _state->getDistances();}
     // simple delegation to the state
     IntegerMatrix getIntegerMatrix() const {return _state->getIntegerMatrix();}
+    SparseMatrix getSparseMatrix() const {return _state->getSparseMatrix();}
     // override the getNumberOfNodes and getNumberOfEdges functions so that they can be delegated to the state
     // returns the number of edges of the state, which is the number of edges in the graph
     unsigned getNumberOfEdges() const {return _state->getNumberOfEdges();}
@@ -48,16 +52,21 @@ public:
     // returns the last added nodes from the current state
     list<Edge*> getLastAddedEdges() { return _state->getLastAddedEdges(); }
     list<Node*> getLastAddedNodes() { return _state->getLastAddedNodes(); }
-    list<Node*> getNeighbours(Node* node) const { return _state->getNeighbours(node); }
-    list<Edge*> getOutgoingEdges(Node* node) const {return _state->getOutgoingEdges(node); }
-    list<Edge*> getIncomingEdges(Node* node)  const {return _state->getIncomingEdges(node); }
+    // the queries are counted by the cost model, these counts decide which state fits best
+    list<Node*> getNeighbours(Node* node) const { _costModel.recordNeighbourScan(); return _state->getNeighbours(node); }
+    list<Edge*> getOutgoingEdges(Node* node) const { _costModel.recordNeighbourScan(); return _state->getOutgoingEdges(node); }
+    list<Edge*> getIncomingEdges(Node* node)  const { _costModel.recordNeighbourScan(); return _state->getIncomingEdges(node); }
+    void forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const { _costModel.recordNeighbourScan(); _state->forEachOutgoingEdge(node, functor);}
+    void forEachIncomingEdge(Node* node, EdgeFunctor& functor) const { _costModel.recordNeighbourScan(); _state->forEachIncomingEdge(node, functor);}
+    void forEachNeighbour(Node* node, NodeFunctor& functor) const { _costModel.recordNeighbourScan(); _state->forEachNeighbour(node, functor);}
     int nodeToIndex(Node* node) const {return _state->nodeToIndex(node);}
     Node* idToNode(unsigned long id) const {return _state->idToNode(id);}
+    Node* labelToNode(const Label& label) const {return _state->labelToNode(label);}
     // returns a string that gives information about the graph as one would expect
     string toString() const { return _state->toString();}
     string toStringID() const { return _state->toStringID();}
     // returns true if the edge exists in the state
-    bool edgeExists(Node* source, Node* target, const Label& label) const { return _state->edgeExists(source,target,label); }
+    bool edgeExists(Node* source, Node* target, const Label& label) const { _costModel.recordEdgeQuery(); return _state->edgeExists(source,target,label); }
     const vector<Node*>& getNodes() const {return _state->getNodes();}
     string getNodeNameHint() const {return "Node " + Label(_state->getNumberOfNodes()).getLabelString();}
 
@@ -82,11 +91,23 @@ public:
     // recreates from other graphtypes
     void recreateFrom(const Graph& other);
     void recreateFrom(const IntegerMatrix& other);
+    void recreateFrom(const SparseMatrix& other);
+    void addBatch(const GraphBuilder& builder);
+    /* freezes the graph in the CSRState, this state is optimized for running algorithms on a graph that doesn't change,
+        the first change to the structure of the graph will thaw it again. accept() calls this before an algorithm runs */
+    void freeze();
+    // returns true if the graph is frozen
+    bool isFrozen() const {return _state->isFrozen();}
+    /* the cost model decides when the graph switches between the list and the matrix state, it can be configured
+       and it holds the number of transitions and the time each copy took */
+    HybridCostModel& getCostModel() {return _costModel;}
+    const HybridCostModel& getCostModel() const {return _costModel;}
 
 
 
     // visitor pattern function, this is the same as in all the other derived functions. The this pointer points to something else in this case
-    void accept(Visitor &v) { v.visit(*this); }
+    // the graph is frozen first if the visitor only reads it's structure, the next change thaws it again
+    void accept(Visitor &v) { if (v.freezesGraph() && !isFrozen()) freeze(); v.visit(*this); }
 
     // friends
     friend QDebug operator<<(QDebug dbg, const HybridGraph& other);
@@ -102,6 +123,8 @@ private:
      // a pointer to the current state. this is used for the statepattern
     HybridGraphState* _state;
     HybridGraphState* _oldState; // last state will be deleted after that adding or removing has been done
+    // mutable because the queries (which are const) are counted
+    mutable HybridCostModel _costModel;
 };
 
 #endif // HYBRIDGRAPH_H
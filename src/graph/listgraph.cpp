@@ -23,6 +23,7 @@ void ListGraph::recreateFrom(const Graph& other)
     vector<Node*> otherNodes = other.getNodes();
     for (unsigned i = 0; i < otherNodes.size(); ++i)
         addNode(*otherNodes[i]); // addNode(otherNodes[i]) will NOT allocate new node!!
+    copyDistances(other);
 
     // nodes have been added to the structure, now add all edges
     for (unsigned i = 0; i < _numberOfNodes; ++i)
@@ -33,9 +34,11 @@ void ListGraph::recreateFrom(const Graph& other)
             Edge tempEdge = **j;
             tempEdge.setSource(_nodes[(other.nodeToIndex((*j)->getSource()))]);
             tempEdge.setTarget(_nodes[(other.nodeToIndex((*j)->getTarget()))]);
-            addEdge(tempEdge);
+            // the other graph is valid already, checking each edge would refuse the edges of a multigraph (and cost O(degree))
+            insertEdge(tempEdge);
         }
     }
+    notifyObservers();
 }
 
 ListGraph::ListGraph(const Graph& other)
@@ -75,20 +78,48 @@ ListGraph::ListGraph(const IntegerMatrix& other)
 
 void ListGraph::recreateFrom(const IntegerMatrix& other)
 {
+    // each node gets a standard label, integermatrix doesn't have information about this
+    GraphBuilder builder;
+    builder.addIntegerMatrix(other);
+    removeNodes();
+    addBatch(builder);
+}
+
+void ListGraph::recreateFrom(const SparseMatrix& sparseMatrix)
+{
+    GraphBuilder builder;
+    builder.addSparseMatrix(sparseMatrix);
+    // clear the graph
     removeNodes();
-    // Graph(integerMatrix) will create the nodes from the integerMatrix, each node with standard labels
-    const vector<vector<unsigned> >& integers = other.getMatrix();
-    for (unsigned i = 0; i < integers.size(); ++i)
+    addBatch(builder);
+}
+
+void ListGraph::addBatch(const GraphBuilder& builder)
+{
+    // nothing is changed if the builder isn't valid
+    builder.validate();
+    unsigned first = _numberOfNodes;
+    addBatchNodes(builder);
+    // the first element of the list of a node is the node itself (see addNode(Node*))
+    _adjacencyList.reserve(_numberOfNodes);
+    _incomingList.resize(_numberOfNodes);
+    for (unsigned i = first; i < _numberOfNodes; ++i)
+        _adjacencyList.push_back(list<pair<Node*, Edge*> >(1, pair<Node*, Edge*>(_nodes[i], NULL)));
+
+    const vector<GraphBuilder::EdgeEntry>& edges = builder.getEdges();
+    for (vector<GraphBuilder::EdgeEntry>::const_iterator i = edges.begin(); i != edges.end(); ++i)
     {
-        Node newNode(getNodeNameHint());
-        // use a standard name for the node, integermatrix doesn't hav information about this
-        addNode(newNode);
+        Edge* newEdge = createBatchEdge(*i, first);
+        list<pair<Node*, Edge*> >& adjacency = _adjacencyList[first + i->source];
+        // a self edge is kept in the first element if that one is still free (see addEdge)
+        if (i->source == i->target && adjacency.front().second == NULL)
+            adjacency.front().second = newEdge;
+        else
+            adjacency.push_back(pair<Node*, Edge*>(newEdge->getTarget(), newEdge));
+        _incomingList[first + i->target].push_back(newEdge);
     }
-    // add edges
-    for(unsigned i  = 0; i < integers.size(); ++i)
-        for (unsigned j = 0; j < integers[i].size(); ++j)
-            for (unsigned k = 0 ; k < integers[i][j]; ++k)
-                addEdge(Edge(_nodes[i], _nodes[j]));
+    _numberOfEdges += edges.size();
+    notifyObservers();
 }
 
 
@@ -98,26 +129,19 @@ list<Edge*> ListGraph::getOutgoingEdges(Node* node) const
     // make sure node exists
     assert(node != NULL);
 
-    bool stop = false;
     list<Edge*> result;
-    // run through lists
-    for (unsigned i = 0; i < this->_numberOfNodes && !stop; ++i)
-    {
-        if (this->_adjacencyList[i].front().first == node)
-        {
-            // list that represents our node has been found
-
-            // first node can have a self edge, if it does not Edge* is NULL
-            if (this->_adjacencyList[i].front().second != NULL)
-                result.push_back(this->_adjacencyList[i].front().second);
-            // iterate through rest of list and add all edges to result
-            for (list<pair<Node*, Edge*> >::const_iterator it = ++this->_adjacencyList[i].begin();
-                 it != this->_adjacencyList[i].end(); ++it)
-                // no need for tests because every node in this list MUST HAVE a correct Edge*
-                result.push_back((*it).second);
-            stop = true;
-        }
-    }
+    // the list that represents our node has the same index as the node
+    int index = nodeToIndex(node);
+    if (index == -1)
+        return result;
+    const list<pair<Node*, Edge*> >& adjacency = _adjacencyList[index];
+    // first node can have a self edge, if it does not Edge* is NULL
+    if (adjacency.front().second != NULL)
+        result.push_back(adjacency.front().second);
+    // iterate through rest of list and add all edges to result
+    for (list<pair<Node*, Edge*> >::const_iterator it = ++adjacency.begin(); it != adjacency.end(); ++it)
+        // no need for tests because every node in this list MUST HAVE a correct Edge*
+        result.push_back((*it).second);
 
     return result;
 }
@@ -126,27 +150,11 @@ list<Edge*> ListGraph::getIncomingEdges(Node* node)  const
 {
     // make sure node exists
     assert(node != NULL);
-
-    list<Edge*> result;
-    // run through lists
-    for (unsigned i = 0; i < this->_numberOfNodes; ++i)
-    {
-        // if we are in the list that is not corresponding with node, we have to start from the second element
-        // else we need the self edges and have to also check the first element
-
-        // also test for the first element, could be a self edge
-        if (this->_adjacencyList[i].front().first == node && this->_adjacencyList[i].front().second != NULL)
-            result.push_back(this->_adjacencyList[i].front().second);
-
-        for (list<pair<Node*, Edge*> >::const_iterator it = ++this->_adjacencyList[i].begin();
-             it != this->_adjacencyList[i].end(); ++it)
-        {
-            if ( (*it).first == node )
-                result.push_back( (*it).second );
-        }
-
-    }
-    return result;
+    // the incoming edges are kept per node, self edges included
+    int index = nodeToIndex(node);
+    if (index == -1)
+        return list<Edge*>();
+    return _incomingList[index];
 }
 
 list<Node*> ListGraph::getNeighbours(Node* node) const
@@ -154,27 +162,59 @@ list<Node*> ListGraph::getNeighbours(Node* node) const
     // make sure node exists
     assert(node != NULL);
 
-    bool stop = false;
     list<Node*> result;
-    // get all nodes that are connected to node
-    for (unsigned i = 0; i < this->_numberOfNodes && !stop; ++i)
+    int index = nodeToIndex(node);
+    if (index == -1)
+        return result;
+    const list<pair<Node*, Edge*> >& adjacency = _adjacencyList[index];
+    // iterate through list and add all nodes to result
+    for (list<pair<Node*, Edge*> >::const_iterator it = adjacency.begin(); it != adjacency.end(); ++it)
     {
-        if (this->_adjacencyList[i].front().first == node)
-        {
-            // iterate through list and add all nodes to result
-            for (list<pair<Node*, Edge*> >::const_iterator it = this->_adjacencyList[i].begin();
-                 it != this->_adjacencyList[i].end(); ++it)
-            {
-                // test 1 is a sanity check, test 2 makes sure we add node itself only when it has a self edge
-                if ((*it).first != NULL && (*it).second != NULL)
-                    result.push_back((*it).first);
-            }
-            stop = true;
-        }
+        // test 1 is a sanity check, test 2 makes sure we add node itself only when it has a self edge
+        if ((*it).first != NULL && (*it).second != NULL)
+            result.push_back((*it).first);
     }
     return result;
 }
 
+void ListGraph::forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const
+{
+    assert(node != NULL);
+    int index = nodeToIndex(node);
+    if (index == -1)
+        return ;
+    const list<pair<Node*, Edge*> >& adjacency = _adjacencyList[index];
+    // the self edge is kept in the head of the list
+    if (adjacency.front().second != NULL && !functor(adjacency.front().second))
+        return ;
+    for (list<pair<Node*, Edge*> >::const_iterator it = ++adjacency.begin(); it != adjacency.end(); ++it)
+        if (!functor((*it).second))
+            return ;
+}
+
+void ListGraph::forEachIncomingEdge(Node* node, EdgeFunctor& functor) const
+{
+    assert(node != NULL);
+    int index = nodeToIndex(node);
+    if (index == -1)
+        return ;
+    for (list<Edge*>::const_iterator it = _incomingList[index].begin(); it != _incomingList[index].end(); ++it)
+        if (!functor(*it))
+            return ;
+}
+
+void ListGraph::forEachNeighbour(Node* node, NodeFunctor& functor) const
+{
+    assert(node != NULL);
+    int index = nodeToIndex(node);
+    if (index == -1)
+        return ;
+    // same as getNeighbours: the node itself is only a neighbour when it has a self edge
+    for (list<pair<Node*, Edge*> >::const_iterator it = _adjacencyList[index].begin(); it != _adjacencyList[index].end(); ++it)
+        if ((*it).first != NULL && (*it).second != NULL && !functor((*it).first))
+            return ;
+}
+
 // this function cannot be called directly by the user!
 // this function does NOT allocate a Node*, see addNode(Label)
 void ListGraph::addNode(Node *node)
@@ -193,12 +233,14 @@ void ListGraph::addNode(Node *node)
     newPair.second = NULL;
     newElement.push_back(newPair);
     this->_adjacencyList.push_back(newElement);
+    // and a new list for the incoming edges
+    this->_incomingList.push_back(list<Edge*>());
     notifyObservers();
 }
 
 void ListGraph::addNode(const Node &other)
 {
-    addNode(new Node(other));
+    addNode(createNode(other));
 }
 
 void ListGraph::removeNode(unsigned id)
@@ -216,41 +258,43 @@ void ListGraph::removeNode(Node *node)
     assert(originalNodeIndex != -1);
     // we know that nodeToIndex(node) returns the index of _nodes corresponding with our node
     // let i be the i-th member of _nodes, then we also know that it's the i-th member of our _adjacencyListList!! [VERSLAG]
-    // first clean the adjacencyList list (remove edges corresponding with our node)
-    for (unsigned int i = 0; i < this->_numberOfNodes; ++i)
+    // first remove the edges that point to our node from the lists of their sources, the incoming list tells us which lists to visit
+    list<Edge*>& incoming = _incomingList[originalNodeIndex];
+    for (list<Edge*>::iterator in = incoming.begin(); in != incoming.end(); ++in)
     {
-        if (!(_adjacencyList[i].begin()->first == node))
+        // self edges are deleted together with the list of the node itself
+        if ((*in)->getSource() == node)
+            continue;
+        list<pair<Node*, Edge*> >& adjacency = _adjacencyList[nodeToIndex((*in)->getSource())];
+        // notice that we begin at begin() + 1 because the first element is the source itself
+        for (list<pair<Node*, Edge*> >::iterator it = ++adjacency.begin(); it != adjacency.end(); ++it)
         {
-            // run through the list and check for edges with the node we want to delete-> delete these edges
-            // notice that we begin at begin() + 1 because we already know that the first element is not important
-            // and we test for *it.first
-
-            list<pair<Node*, Edge*> >::iterator it = _adjacencyList[i].begin();
-            while (it != _adjacencyList[i].end())
+            if ((*it).second == *in)
             {
-                if ((*it).first == node)
-                {
-                    delete (*it).second;
-                    // remove the pair from the list
-                    _adjacencyList[i].erase(it);
-                    // restart because iterator has changed
-                    it = _adjacencyList[i].begin();
-                }
-                else
-                    it++;
+                adjacency.erase(it);
+                break;
             }
         }
+        destroyEdge(*in);
+        --_numberOfEdges;
     }
 
     // now delete the entire list corresponding with our node (delete edges and remove the list)
     for (list<pair<Node*, Edge*> >::iterator it = this->_adjacencyList[originalNodeIndex].begin();
          it != this->_adjacencyList[originalNodeIndex].end(); ++it)
     {
-        delete (*it).second;
+        if ((*it).second == NULL)
+            continue;
+        // the targets don't have this edge as an incoming edge anymore
+        if ((*it).first != node)
+            _incomingList[nodeToIndex((*it).first)].remove((*it).second);
+        destroyEdge((*it).second);
+        --_numberOfEdges;
     }
 
     // we have deleted all edges in the list corresponding with the node, now remove the entire list
     _adjacencyList.erase(_adjacencyList.begin() + originalNodeIndex);
+    _incomingList.erase(_incomingList.begin() + originalNodeIndex);
 
     // remove from _nodes vector-> node is really gone now
     Graph::removeNode(node);
@@ -265,6 +309,7 @@ void ListGraph::removeNodes()
 
     // empty all lists -> no deletion, just list clearing
     _adjacencyList.clear();
+    _incomingList.clear();
 
     // remove and delete nodes in _node vector
     Graph::removeNodes();
@@ -273,15 +318,19 @@ void ListGraph::removeNodes()
 
 void ListGraph::addEdge(const Edge &edge)
 {
-    int sourceIndex = nodeToIndex(edge.getSource());
-    int targetIndex = nodeToIndex(edge.getTarget());
-
     if (!isUniqueEdge(edge)) // check if the edge is unique
         throw UniqueEdgeEx(edge);
+    insertEdge(edge);
+    notifyObservers();
+}
+
+void ListGraph::insertEdge(const Edge& edge)
+{
+    int sourceIndex = nodeToIndex(edge.getSource());
+    int targetIndex = nodeToIndex(edge.getTarget());
     // make sure the nodes exist -- replace with exception?
     assert(sourceIndex != -1 && targetIndex != -1);
 
-    bool stop = false;
     /* we need to check for self-edges because else we can get the situation:
      [0]->1,NULL->2,Edge*->1,Edge*
      [1]->2,NULL->blabla
@@ -294,28 +343,21 @@ void ListGraph::addEdge(const Edge &edge)
     bool isSelfEdge = (edge.getSource()== edge.getTarget());
 
     // edge does not exist yet, so create it
-    Edge* newEdge = new Edge(edge);
+    Edge* newEdge = createEdge(edge);
     // parameters for adjacencyListlist
     pair<Node*, Edge*> newPair;
     newPair.first = edge.getTarget();
     newPair.second = newEdge;
-    // navigate to the correct spot to add the edge
-    for (unsigned int i = 0; i < _numberOfNodes && !stop; ++i)
-    {
-        if (_adjacencyList[i].front().first == edge.getSource())
-        {
-            // found the correct list (corresponding with the source node)
-            // add the new pair (target, edge) or add the selfedge
-            if (isSelfEdge && _adjacencyList[i].front().second == NULL)
-                _adjacencyList[i].front().second  = newEdge;
-            else
-                _adjacencyList[i].push_back(newPair);
-            stop = true;
-            _lastAddedEdges.push_back(newEdge);
-            _numberOfEdges++;
-        }
-    }
-    notifyObservers();
+    // the list corresponding with the source node has the same index as the source node
+    // add the new pair (target, edge) or add the selfedge
+    list<pair<Node*, Edge*> >& adjacency = _adjacencyList[sourceIndex];
+    if (isSelfEdge && adjacency.front().second == NULL)
+        adjacency.front().second  = newEdge;
+    else
+        adjacency.push_back(newPair);
+    _incomingList[targetIndex].push_back(newEdge);
+    _lastAddedEdges.push_back(newEdge);
+    _numberOfEdges++;
 }
 
 void ListGraph::addEdge(unsigned sourceIndex, unsigned targetIndex, const Label& label)
@@ -332,33 +374,27 @@ void ListGraph::removeEdge(Node *source, Node *target, const Label& label)
     assert(source != NULL && target != NULL);
 
     bool isSelfEdge = (source == target);
-    bool stop = false;
-
-    for (unsigned i = 0; i < this->_numberOfNodes && !stop; ++i)
+    int sourceIndex = nodeToIndex(source);
+    if (sourceIndex == -1)
+        return ;
+    // list corresponding with our node
+    list<pair<Node*, Edge*> >& adjacency = _adjacencyList[sourceIndex];
+    // run through list to find target
+    for (list<pair<Node*, Edge*> >::iterator it = adjacency.begin(); it != adjacency.end(); ++it)
     {
-        // list corresponding with our node
-        if (_adjacencyList[i].front().first == source)
+        if ( (*it).first == target && (*it).second != NULL && (*it).second->getLabel() == label )
         {
-            // run through list to find target
-            list<pair<Node*, Edge*> >::iterator it = _adjacencyList[i].begin();
-            while (it != _adjacencyList[i].end() && !stop)
-            {
-                if ( (*it).first == target && (*it).second != NULL && (*it).second->getLabel() == label )
-                {
-                    delete (*it).second;
-                    stop = true;
-                    this->_numberOfEdges--;
-                    // if it is a self edge AND the self edge is the list head we only have to delete the pointer
-                    // otherwise we also have to delete the pair out of our list
-                    if (!(isSelfEdge && it == _adjacencyList[i].begin()))
-                        _adjacencyList[i].erase(it);
-                    else
-                        // set to NULL so we don't have a danling pointer!
-                        (*it).second = NULL;
-                }
-                else
-                    it++;
-            }
+            _incomingList[nodeToIndex(target)].remove((*it).second);
+            destroyEdge((*it).second);
+            this->_numberOfEdges--;
+            // if it is a self edge AND the self edge is the list head we only have to delete the pointer
+            // otherwise we also have to delete the pair out of our list
+            if (!(isSelfEdge && it == adjacency.begin()))
+                adjacency.erase(it);
+            else
+                // set to NULL so we don't have a danling pointer!
+                (*it).second = NULL;
+            break;
         }
     }
     notifyObservers();
@@ -400,13 +436,14 @@ void ListGraph::removeEdges()
         for (list<pair<Node*, Edge*> >::iterator it = _adjacencyList[i].begin(); it != _adjacencyList[i].end(); ++it)
         {
             // delete all edges
-            delete it->second;
+            destroyEdge(it->second);
         }
         _adjacencyList[i].clear();
         pair<Node*, Edge*> newPair;
         newPair.first = _nodes[i];
         newPair.second = NULL;
         _adjacencyList[i].push_back(newPair);
+        _incomingList[i].clear();
     }
     this->_numberOfEdges = 0;
     notifyObservers();
@@ -415,24 +452,18 @@ void ListGraph::removeEdges()
 
 bool ListGraph::isUniqueEdge(const Edge& edge) const
 {
-    // loop lijsten af, kijk wanneer edge zijn source de first is van een lijst
-    // loop dan die lijst af en kijk wanneer er een first gelijk is met de target
-    // check die zijn label == edge.label
-    for (unsigned i = 0; i < this->_numberOfNodes; ++i)
+    // only the list corresponding with our source has to be checked
+    int sourceIndex = nodeToIndex(edge.getSource());
+    if (sourceIndex == -1)
+        return true;
+    const list<pair<Node*, Edge*> >& adjacency = _adjacencyList[sourceIndex];
+    // iterate through list
+    for (list<pair<Node*, Edge*> >::const_iterator it = adjacency.begin(); it != adjacency.end(); ++it)
     {
-        // located the list corresponding with our source
-        if (this->_adjacencyList[i].front().first == edge.getSource())
-        {
-            // iterate through list
-            for (list<pair<Node*, Edge*> >::const_iterator it = this->_adjacencyList[i].begin();
-                 it != this->_adjacencyList[i].end(); ++it)
-            {
-                // if there is an edge between source and target, check if the labels are equal
-                // if so, edge is not unique
-                if ((*it).first == edge.getTarget() && (*it).second != NULL && (*it).second->getLabel() == edge.getLabel())
-                    return false;
-            }
-        }
+        // if there is an edge between source and target, check if the labels are equal
+        // if so, edge is not unique
+        if ((*it).first == edge.getTarget() && (*it).second != NULL && (*it).second->getLabel() == edge.getLabel())
+            return false;
     }
     // if we get here, edge is unique
     return true;
@@ -6,6 +6,8 @@
               an actual node, the following pairs represent nodes that are connected with the actual node. The edge pointers are the edges
               from our actual node to the node that is the first element of the pair where edge is the second element of the pair.
               For more clear and detailed information about this implementation we redirect you to our report
+              The i-th list of the vector always belongs to the i-th node in _nodes, so a list is found with nodeToIndex.
+              For every node there is also a list of the incoming edges so that these don't have to be searched in all the lists.
      */
 
 #ifndef LISTGRAPH_H
@@ -58,11 +60,16 @@ public:
     // a new ListGraph object and the following functions change the current ListGraph object
     void recreateFrom(const Graph& other);
     void recreateFrom(const IntegerMatrix& other);
+    void recreateFrom(const SparseMatrix& sparseMatrix);
+    void addBatch(const GraphBuilder& builder);
     // returns a list of a certain node's neighbours
     list<Node*> getNeighbours(Node* node) const;
     // return a node's outgoing/incoming edges
     list<Edge*> getOutgoingEdges(Node* node) const;
     list<Edge*> getIncomingEdges(Node* node)  const;
+    void forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const;
+    void forEachIncomingEdge(Node* node, EdgeFunctor& functor) const;
+    void forEachNeighbour(Node* node, NodeFunctor& functor) const;
     // an edge is uniquely defined by its source-target-label
     bool isUniqueEdge(const Edge& edge) const;
 
@@ -87,10 +94,14 @@ public:
 protected:
     // structure of the graph! for more info, check description above
     vector<list<pair<Node*, Edge*> > > _adjacencyList;
+    // the incoming edges of every node, the i-th list belongs to the i-th node in _nodes (same as _adjacencyList)
+    vector<list<Edge*> > _incomingList;
 
     // given a label, give back a pointer to the edge
     // equal node function was made in super class because it is independent of the implementation (matrix/list)
     Edge* labelToEdge(const Label& label) const;
+    // adds the edge without checking if it's unique and without notifying the observers, used by addEdge and recreateFrom
+    void insertEdge(const Edge& edge);
 
 
 
@@ -3,6 +3,7 @@
 #include <vector>
 #include <sstream>
 #include <cmath>
+#include <iterator>
 
 #include "matrixgraph.h"
 #include "graphComp/node.h"
@@ -12,43 +13,59 @@
 #include "exception/unexistingedgeex.h"
 #include "exception/unexistingnodeex.h"
 
-MatrixGraph::MatrixGraph() : Graph()
+MatrixGraph::MatrixGraph() : Graph(), _numberOfTombstones(0)
 {
     // default constructor does nothing for now
 }
 
-MatrixGraph::MatrixGraph(const Graph& other)
+MatrixGraph::MatrixGraph(const Graph& other) : _numberOfTombstones(0)
 {
     // do not call the copyconstructor of Graph. nodes will be created by recreateFrom(other);
     recreateFrom(other);
 }
 
-MatrixGraph::MatrixGraph(const IntegerMatrix& integerMatrix)
+MatrixGraph::MatrixGraph(const IntegerMatrix& integerMatrix) : _numberOfTombstones(0)
 {
     recreateFrom(integerMatrix);
 }
 
 void MatrixGraph::recreateFrom(const IntegerMatrix& integerMatrix)
 {
+    GraphBuilder builder;
+    builder.addIntegerMatrix(integerMatrix);
     // clear the graph
     removeNodes();
-    // temp edge variable that holds the allocated edge
-    Edge* newEdge;
-    const vector<vector<unsigned> >& integers = integerMatrix.getMatrix();
-    for (unsigned i = 0; i < integers.size(); ++i)
+    addBatch(builder);
+}
+
+void MatrixGraph::recreateFrom(const SparseMatrix& sparseMatrix)
+{
+    GraphBuilder builder;
+    builder.addSparseMatrix(sparseMatrix);
+    // clear the graph
+    removeNodes();
+    addBatch(builder);
+}
+
+void MatrixGraph::addBatch(const GraphBuilder& builder)
+{
+    // nothing is changed if the builder isn't valid
+    builder.validate();
+    unsigned first = _numberOfNodes;
+    addBatchNodes(builder);
+    // the new nodes get new slots at the end, the matrix grows once
+    unsigned firstSlot = _matrix.size();
+    for (unsigned i = first; i < _numberOfNodes; ++i)
     {
-        Node newNode(getNodeNameHint());
-        addNode(newNode);
+        _slots.push_back(_slotNodes.size());
+        _slotNodes.push_back(_nodes[i]);
     }
-    // add the edges
-    for(unsigned i  = 0; i < integers.size(); ++i)
-        for (unsigned j = 0; j < integers[i].size(); ++j)
-            for (unsigned k = 0 ; k < integers[i][j]; ++k) // add k number of edges from i to j
-            {
-                newEdge = new Edge(_nodes[i], _nodes[j]);
-                _matrix[i][j].push_back(newEdge);
-                _lastAddedEdges.push_back(newEdge);
-            }
+    _matrix.grow(_slotNodes.size());
+
+    const vector<GraphBuilder::EdgeEntry>& edges = builder.getEdges();
+    for (vector<GraphBuilder::EdgeEntry>::const_iterator i = edges.begin(); i != edges.end(); ++i)
+        insertEdge(firstSlot + i->source, firstSlot + i->target, createBatchEdge(*i, first));
+    _numberOfEdges += edges.size();
     notifyObservers();
 }
 
@@ -65,9 +82,9 @@ IntegerMatrix MatrixGraph::getIntegerMatrix() const
         result.addNode(**i);
 
     for (unsigned i = 0; i < _matrix.size(); ++i)
-        for (unsigned j = 0; j < _matrix[i].size(); ++j)
-            for (unsigned k = 0; k < _matrix[i][j].size(); ++k) // add k edges from i to j
-                result.addEdge(*_nodes[i], *_nodes[j]);
+        for (unsigned j = _matrix.nextInRow(i, 0); j < _matrix.size(); j = _matrix.nextInRow(i, j + 1))
+            for (unsigned k = cellSize(i, j); k > 0; --k) // add k edges from i to j
+                result.addEdge(*_slotNodes[i], *_slotNodes[j]);
     return result;
 }
 
@@ -78,32 +95,36 @@ void MatrixGraph::addNode(Node* node)
     assert(node);
     // add the node to the node vector using the superclass
     Graph::addNode(node);
-    // now extend the matrix by one
-    extendMatrix(1);
+    // the node gets a new slot at the end, the matrix doubles it's capacity when it's full
+    _slots.push_back(_matrix.size());
+    _slotNodes.push_back(node);
+    _matrix.grow(_matrix.size() + 1);
 }
 
 void MatrixGraph::addNode(const Node& other)
 {
-    MatrixGraph::addNode(new Node(other));
+    MatrixGraph::addNode(createNode(other));
     notifyObservers();
 }
 
 void MatrixGraph::removeNodes()
 {
     // immediatly quit if the matrix is empty, also this is for efficiency
-    if (_matrix.empty())
+    if (_matrix.size() == 0)
         return ;
-    // remove everything from the matrix
-    for (int i = static_cast<int>(_matrix.size()) -1; i >= 0; --i)
-    {
-        for (int j =  static_cast<int>(_matrix[i].size()) - 1; j >= 0 ; --j)
-        {
-            // remove all the edges between node i and j
-            deleteEdgesBetweenNodes(i, j);
-        }
-    }
+    // free all the edges, there is no need to look at the cells one by one
+    for (QHash<Cell, Edge*>::iterator i = _firstEdges.begin(); i != _firstEdges.end(); ++i)
+        destroyEdge(i.value());
+    for (QHash<Cell, list<Edge*> >::iterator i = _otherEdges.begin(); i != _otherEdges.end(); ++i)
+        for (list<Edge*>::iterator k = i.value().begin(); k != i.value().end(); ++k)
+            destroyEdge(*k);
+    _firstEdges.clear();
+    _otherEdges.clear();
     //reset the matrix, all the pointers in the matrix should be freed.
     _matrix.clear();
+    _slots.clear();
+    _slotNodes.clear();
+    _numberOfTombstones = 0;
     // now we have no edges
     _numberOfEdges = 0;
     // finish by removing the nodes form the _nodes vector. this is done by the baseclass
@@ -125,17 +146,22 @@ void MatrixGraph::removeNode(Node* node)
     int index = Graph::nodeToIndex(node);
     // this function is private, and can only be called by functions from within MatrixGraph, the invalid Node* can only be caused by bad programming
     assert(index != -1);
+    unsigned slot = _slots[index];
 
-    // remove the actual edges
-    for (int i = static_cast<int>(_matrix.size()) - 1; i >=0; --i)
-    {
-        deleteEdgesBetweenNodes(index, i);
-        deleteEdgesBetweenNodes(i, index);
-    }
-    // remove the right colomn and row from the matrix
-    retractMatrix(index);
+    // remove the actual edges, only the cells with a bit set have edges
+    for (unsigned j = _matrix.nextInRow(slot, 0); j < _matrix.size(); j = _matrix.nextInRow(slot, j + 1))
+        deleteEdgesBetweenNodes(slot, j);
+    for (unsigned i = 0; i < _matrix.size(); ++i)
+        if (_matrix.test(i, slot))
+            deleteEdgesBetweenNodes(i, slot);
+    // the row and column are empty now, the slot becomes a tombstone instead of moving all the other rows and columns
+    _slotNodes[slot] = NULL;
+    _slots.erase(_slots.begin() + index);
+    ++_numberOfTombstones;
     // removing the node from the _nodes vector is done by the baseclass
     Graph::removeNode(node);
+    if (_numberOfTombstones > _numberOfNodes)
+        compactMatrix();
     notifyObservers();
 }
 
@@ -150,15 +176,15 @@ void MatrixGraph::addEdge(unsigned sourceID, unsigned targetID, const Label& lab
 
 void MatrixGraph::addEdge(const Edge& edge)
 {
-    int sourceIndex = nodeToIndex(edge.getSource());
-    int targetIndex = nodeToIndex(edge.getTarget());
+    int sourceSlot = nodeToSlot(edge.getSource());
+    int targetSlot = nodeToSlot(edge.getTarget());
     // both souldn't be -1, this would mean that source or target don't exists and this can only be caused by bad programming
-    assert(sourceIndex != -1 && targetIndex != -1);
+    assert(sourceSlot != -1 && targetSlot != -1);
     // new edge
     if (!isUniqueEdge(Edge(edge))) // check if the edge is unique
         throw UniqueEdgeEx(edge);
-    Edge* newEdge = new Edge(edge);
-    _matrix[sourceIndex][targetIndex].push_back(newEdge);
+    Edge* newEdge = createEdge(edge);
+    insertEdge(sourceSlot, targetSlot, newEdge);
     _numberOfEdges++; // increase the number of edges
     _lastAddedEdges.push_back(newEdge);
     notifyObservers();
@@ -166,17 +192,16 @@ void MatrixGraph::addEdge(const Edge& edge)
 
 void MatrixGraph::removeEdges()
 {
-    /* for efficiency (!!), removeEdge() isn't used here because that would require consecutive looping through
-       the lists for each edge that we would delete instead we delete the all the edges and clear the lists*/
-    for (unsigned i = 0; i < _matrix.size(); ++i)
-        for (unsigned j = 0; j < _matrix.size(); ++j)
-        {
-            // free up the memory used by the edges
-            for (list<Edge*>::iterator k = _matrix[i][j].begin(); k != _matrix[i][j].end(); ++k)
-                delete *k;
-            // remove all the cleared edge pointers from the matrix
-            _matrix[i][j].clear();
-        }
+    /* for efficiency (!!), removeEdge() isn't used here because that would require a lookup
+       for each edge that we would delete instead we delete the all the edges and clear the hashes*/
+    for (QHash<Cell, Edge*>::iterator i = _firstEdges.begin(); i != _firstEdges.end(); ++i)
+        destroyEdge(i.value());
+    for (QHash<Cell, list<Edge*> >::iterator i = _otherEdges.begin(); i != _otherEdges.end(); ++i)
+        for (list<Edge*>::iterator k = i.value().begin(); k != i.value().end(); ++k)
+            destroyEdge(*k);
+    _firstEdges.clear();
+    _otherEdges.clear();
+    _matrix.resetAll();
     // update the number of edges
     _numberOfEdges = 0;
     notifyObservers();
@@ -197,21 +222,49 @@ void MatrixGraph::removeEdge(unsigned sourceID, unsigned targetID, const Label&
 
 void MatrixGraph::removeEdge(Node * source, Node * target, const Label& label)
 {
-    _numberOfEdges--;
-    int sourceIndex = nodeToIndex(source);
-    int targetIndex = nodeToIndex(target);
-    assert(sourceIndex != -1 && targetIndex != -1);
+    int sourceSlot = nodeToSlot(source);
+    int targetSlot = nodeToSlot(target);
+    assert(sourceSlot != -1 && targetSlot != -1);
+    if (!_matrix.test(sourceSlot, targetSlot))
+        return ;
 
-    bool found = false;
-    // at this point we are dealing with valid source and target
-    for (list<Edge*>::iterator k = _matrix[sourceIndex][targetIndex].begin(); !found && k != _matrix[sourceIndex][targetIndex].end(); ++k)
+    Cell cell(source, target);
+    QHash<Cell, list<Edge*> >::iterator others = _otherEdges.find(cell);
+    Edge* first = _firstEdges.value(cell);
+    if (first->getLabel() == label)
     {
-        if ((found = ((*k)->getLabel() == label)))
+        destroyEdge(first);
+        _numberOfEdges--;
+        // the next edge of the cell becomes the first one, if there is none the cell is empty
+        if (others == _otherEdges.end())
+        {
+            _firstEdges.remove(cell);
+            _matrix.reset(sourceSlot, targetSlot);
+        }
+        else
         {
-            // free the memory allocated for that edge
-            delete *k;
-            // remove that element (= pointer in this case) from the list
-            _matrix[sourceIndex][targetIndex].erase(k);
+            _firstEdges.insert(cell, others.value().front());
+            others.value().pop_front();
+            if (others.value().empty())
+                _otherEdges.erase(others);
+        }
+    }
+    else if (others != _otherEdges.end())
+    {
+        // at this point we are dealing with valid source and target
+        for (list<Edge*>::iterator k = others.value().begin(); k != others.value().end(); ++k)
+        {
+            if ((*k)->getLabel() == label)
+            {
+                // free the memory allocated for that edge
+                destroyEdge(*k);
+                _numberOfEdges--;
+                // remove that element (= pointer in this case) from the list
+                others.value().erase(k);
+                if (others.value().empty())
+                    _otherEdges.erase(others);
+                break;
+            }
         }
     }
     notifyObservers();
@@ -228,11 +281,13 @@ void MatrixGraph::recreateFrom(const Graph& other)
     removeNodes();
     // copy the nodes
     vector<Node*> otherNodes = other.getNodes(); // the vector will be created only once
+    _matrix.reserve(otherNodes.size());
     for (unsigned i = 0; i < otherNodes.size(); ++i)
         /* add each node from the other graph to the graph,
            addNode(otherNodes[i]) will NOT allocate new node so we want to call the
            one with a const Node& as the parameter*/
         addNode(*otherNodes[i]);
+    copyDistances(other);
     // for each node
     for (unsigned i = 0; i < _numberOfNodes; ++i)
     {
@@ -244,137 +299,186 @@ void MatrixGraph::recreateFrom(const Graph& other)
             Edge tempEdge = **j;
             tempEdge.setSource(_nodes[(other.nodeToIndex((*j)->getSource()))]);
             tempEdge.setTarget(_nodes[(other.nodeToIndex((*j)->getTarget()))]);
-            addEdge(tempEdge);
+            // the other graph is valid already, checking each edge would refuse the edges of a multigraph
+            Edge* newEdge = createEdge(tempEdge);
+            insertEdge(nodeToSlot(tempEdge.getSource()), nodeToSlot(tempEdge.getTarget()), newEdge);
+            _numberOfEdges++;
+            _lastAddedEdges.push_back(newEdge);
         }
     }
+    notifyObservers();
 }
 
 list<Node*> MatrixGraph::getNeighbours(Node* node) const
 {
     list<Node*> neighbours;
-    int sourceIndex = Graph::nodeToIndex(node);
-    assert(sourceIndex != -1); // TODO: replace with exception
-    for(unsigned i = 0; i < _matrix[sourceIndex].size(); ++i)
-    {
-        if(!_matrix[sourceIndex][i].empty()) // if there is at least one edge from source to i
-            neighbours.push_back(_nodes[i]);
-    }
+    int sourceSlot = nodeToSlot(node);
+    assert(sourceSlot != -1); // TODO: replace with exception
+    // only the set bits are visited, a word without any edge is skipped at once
+    for (unsigned i = _matrix.nextInRow(sourceSlot, 0); i < _matrix.size(); i = _matrix.nextInRow(sourceSlot, i + 1))
+        neighbours.push_back(_slotNodes[i]);
     return neighbours;
 }
 
 list<Edge*> MatrixGraph::getOutgoingEdges(Node* node) const
 {
     list<Edge*> outgoingEdges;
-    int sourceIndex = Graph::nodeToIndex(node);
-    assert(sourceIndex != -1);
-    // save the size in a temporary variable so we don't have to get the size every time
-    unsigned size = _matrix[sourceIndex].size();
-    for (unsigned i = 0; i < size; ++i)
-    {
-        // in each cell in the matrix there can be more edges.
-        for (list<Edge*>::const_iterator k = _matrix[sourceIndex][i].begin(); k != _matrix[sourceIndex][i].end(); ++k)
-            outgoingEdges.push_back(*k);
-    }
-
+    AppendEdge append(outgoingEdges);
+    forEachOutgoingEdge(node, append);
     return outgoingEdges;
 }
 
 list<Edge*> MatrixGraph::getIncomingEdges(Node *node) const
 {
     list<Edge*> incomingEdges;
-    int sourceIndex = Graph::nodeToIndex(node);
-    assert(sourceIndex != -1);
-    // save the size in a temporary variable so we don't have to get the size every time
-    unsigned size = _matrix[sourceIndex].size();
-    for (unsigned j = 0; j < size; ++j)
-    {
-        // in each cell in the matrix there can be more edges.
-        for (list<Edge*>::const_iterator k = _matrix[j][sourceIndex].begin(); k != _matrix[j][sourceIndex].end(); ++k)
-            incomingEdges.push_back(*k);
-    }
-
+    AppendEdge append(incomingEdges);
+    forEachIncomingEdge(node, append);
     return incomingEdges;
 }
 
+void MatrixGraph::forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const
+{
+    int sourceSlot = nodeToSlot(node);
+    assert(sourceSlot != -1);
+    for (unsigned i = _matrix.nextInRow(sourceSlot, 0); i < _matrix.size(); i = _matrix.nextInRow(sourceSlot, i + 1))
+        if (!forEachInCell(sourceSlot, i, functor))
+            return ;
+}
 
-void MatrixGraph::deleteEdgesBetweenNodes(int i, int j)
+void MatrixGraph::forEachIncomingEdge(Node* node, EdgeFunctor& functor) const
 {
-    // update the number of edges;
-    _numberOfEdges -= _matrix[i][j].size();
+    int targetSlot = nodeToSlot(node);
+    assert(targetSlot != -1);
+    // the incoming edges are in the column of the node
+    for (unsigned j = 0; j < _matrix.size(); ++j)
+        if (_matrix.test(j, targetSlot) && !forEachInCell(j, targetSlot, functor))
+            return ;
+}
 
-    // delete all the edges from i to j
-    for (list<Edge*>::const_iterator k = _matrix[i][j].begin(); k != _matrix[i][j].end(); ++k)
-        delete *k;
-    // also remove all the pointers
-    _matrix[i][j].clear();
+void MatrixGraph::forEachNeighbour(Node* node, NodeFunctor& functor) const
+{
+    int sourceSlot = nodeToSlot(node);
+    assert(sourceSlot != -1);
+    for (unsigned i = _matrix.nextInRow(sourceSlot, 0); i < _matrix.size(); i = _matrix.nextInRow(sourceSlot, i + 1))
+        if (!functor(_slotNodes[i]))
+            return ;
 }
 
-// helpfunction to easely extend the matrix by n. using this function and this function only will ensure that the matrix stays a squar
-void MatrixGraph::extendMatrix(int n)
+void MatrixGraph::deleteEdgesBetweenNodes(int i, int j)
 {
-    vector<list<Edge*> > newLine;
-    list<Edge*> emptyList;
-    while(n > 0)
+    if (!_matrix.test(i, j))
+        return ;
+    Cell cell(_slotNodes[i], _slotNodes[j]);
+    // delete all the edges from i to j and update the number of edges
+    destroyEdge(_firstEdges.value(cell));
+    _firstEdges.remove(cell);
+    _numberOfEdges--;
+    QHash<Cell, list<Edge*> >::iterator others = _otherEdges.find(cell);
+    if (others != _otherEdges.end())
     {
-        // increase the size of the matrix, add one cell to each line
-        for(unsigned i = 0; i < _matrix.size(); ++i)
-        {
-            // add one element on each row
-            _matrix[i].push_back(emptyList);
-            // prepare to line to add
-            newLine.push_back(emptyList);
-        }
-        newLine.push_back(emptyList); // bottom right corner of the matrix
+        _numberOfEdges -= others.value().size();
+        for (list<Edge*>::const_iterator k = others.value().begin(); k != others.value().end(); ++k)
+            destroyEdge(*k);
+        _otherEdges.erase(others);
+    }
+    _matrix.reset(i, j);
+}
 
-        _matrix.push_back(newLine); // add the new line that we have created to the matrix
-        // one less to extend
-        newLine.clear();
-        emptyList.clear();
-        --n;
+void MatrixGraph::insertEdge(unsigned sourceSlot, unsigned targetSlot, Edge* edge)
+{
+    Cell cell(_slotNodes[sourceSlot], _slotNodes[targetSlot]);
+    if (_matrix.test(sourceSlot, targetSlot))
+        _otherEdges[cell].push_back(edge);
+    else
+    {
+        _matrix.set(sourceSlot, targetSlot);
+        _firstEdges.insert(cell, edge);
     }
-    assert(_matrix.size() == _matrix[0].size());
 }
 
-void MatrixGraph::retractMatrix(int index)
+unsigned MatrixGraph::cellSize(unsigned i, unsigned j) const
 {
-    assert(_matrix[0].size() == _matrix.size());
-    // remove that line and kolom of the matrix to update the matrix
-    for (unsigned i = 0; i < _matrix.size(); ++i)
-        _matrix[i].erase(_matrix[i].begin() + index); // remove colom in each line
-    _matrix.erase(_matrix.begin() + index); // remove line
-    assert(_matrix[0].size() == _matrix.size());
+    if (!_matrix.test(i, j))
+        return 0;
+    QHash<Cell, list<Edge*> >::const_iterator others = _otherEdges.constFind(Cell(_slotNodes[i], _slotNodes[j]));
+    return (others == _otherEdges.constEnd()) ? 1 : 1 + others.value().size();
+}
+
+Edge* MatrixGraph::edgeInCell(unsigned i, unsigned j, unsigned k) const
+{
+    assert(k < cellSize(i, j));
+    Cell cell(_slotNodes[i], _slotNodes[j]);
+    if (k == 0)
+        return _firstEdges.value(cell);
+    const list<Edge*>& others = _otherEdges.constFind(cell).value();
+    list<Edge*>::const_iterator edge = others.begin();
+    advance(edge, k - 1);
+    return *edge;
+}
+
+Edge* MatrixGraph::findInCell(unsigned i, unsigned j, const Label& label) const
+{
+    // if there are no edges from the source to the target
+    if (!_matrix.test(i, j))
+        return NULL;
+    Cell cell(_slotNodes[i], _slotNodes[j]);
+    Edge* first = _firstEdges.value(cell);
+    if (first->getLabel() == label)
+        return first;
+    QHash<Cell, list<Edge*> >::const_iterator others = _otherEdges.constFind(cell);
+    if (others != _otherEdges.constEnd())
+        for (list<Edge*>::const_iterator k = others.value().begin(); k != others.value().end(); ++k)
+            if ((*k)->getLabel() == label)
+                return *k;
+    return NULL;
+}
+
+bool MatrixGraph::forEachInCell(unsigned i, unsigned j, EdgeFunctor& functor) const
+{
+    if (!_matrix.test(i, j))
+        return true;
+    Cell cell(_slotNodes[i], _slotNodes[j]);
+    if (!functor(_firstEdges.value(cell)))
+        return false;
+    QHash<Cell, list<Edge*> >::const_iterator others = _otherEdges.constFind(cell);
+    if (others != _otherEdges.constEnd())
+        for (list<Edge*>::const_iterator k = others.value().begin(); k != others.value().end(); ++k)
+            if (!functor(*k))
+                return false;
+    return true;
 }
 
 bool MatrixGraph::isUniqueEdge(const Edge& edge) const
 {
-    int sourceIndex = nodeToIndex(edge.getSource());
-    int targetIndex = nodeToIndex(edge.getTarget());
+    int sourceSlot = nodeToSlot(edge.getSource());
+    int targetSlot = nodeToSlot(edge.getTarget());
     // this is a help function that is called only from other functions within MatrixGraph, a bad source/target is caused by errorneous programming
-    assert(sourceIndex != -1 && targetIndex != -1);
-    for (list<Edge*>::const_iterator k = _matrix[sourceIndex][targetIndex].begin(); k != _matrix[sourceIndex][targetIndex].end(); ++k)
-    {
-        if((*k)->getLabel() == edge.getLabel())
-            return false;
-    }
-    return true;
+    assert(sourceSlot != -1 && targetSlot != -1);
+    return !findInCell(sourceSlot, targetSlot, edge.getLabel());
 }
 
 bool MatrixGraph::edgeExists(Node* source, Node* target, const Label& label) const
 {
-    int sourceIndex = nodeToIndex(source);
-    int targetIndex = nodeToIndex(target);
-    assert(sourceIndex != -1 && targetIndex != -1);
-    // if there are no edges from the source to the target
-    if (_matrix[sourceIndex][targetIndex].empty())
-        return false;
-    else // do the real search
-        for (list<Edge*>::const_iterator k = _matrix[sourceIndex][targetIndex].begin(); k != _matrix[sourceIndex][targetIndex].end(); ++k)
-        {
-            if((*k)->getLabel() == label)
-                return true;
-        }
+    int sourceSlot = nodeToSlot(source);
+    int targetSlot = nodeToSlot(target);
+    assert(sourceSlot != -1 && targetSlot != -1);
+    return findInCell(sourceSlot, targetSlot, label);
+}
+
+int MatrixGraph::nodeToSlot(Node* node) const
+{
+    int index = nodeToIndex(node);
+    return (index == -1) ? -1 : static_cast<int>(_slots[index]);
+}
 
-    return false;
+void MatrixGraph::compactMatrix()
+{
+    // the slots of the nodes are sorted because a new node always gets the last slot
+    _matrix.compact(_slots);
+    _slotNodes = _nodes;
+    for (unsigned i = 0; i < _slots.size(); ++i)
+        _slots[i] = i;
+    _numberOfTombstones = 0;
 }
 
 string MatrixGraph::toStringID() const
@@ -390,31 +494,27 @@ string MatrixGraph::toStringID() const
 
     for (unsigned i = 0; i < _numberOfNodes; ++i)
         for (unsigned j = 0; j < _numberOfNodes; ++j)
-            if(maxDepth < _matrix[i][j].size())
-                maxDepth = _matrix[i][j].size();
+            if(maxDepth < cellSize(_slots[i], _slots[j]))
+                maxDepth = cellSize(_slots[i], _slots[j]);
 
     for(unsigned tempCounter = 0; tempCounter < maxDepth || tempCounter == 0; ++tempCounter)
     {
         resultString << "\nlayer " << tempCounter << ": \n";
-        for (unsigned i = 0; i < _matrix.size(); ++i)
+        for (unsigned i = 0; i < _numberOfNodes; ++i)
         {
-            for (unsigned j = 0 ; j < _matrix[i].size(); ++j)
+            for (unsigned j = 0 ; j < _numberOfNodes; ++j)
             {
                 // if tempCounter (current Layer) is more than the deepest index of a cell
-                if(_matrix[i][j].size() <= tempCounter)
+                if(cellSize(_slots[i], _slots[j]) <= tempCounter)
                     resultString << ".";
                 else
                 {
                     // go to the right layer
-
-                    list<Edge*>::const_iterator k = _matrix[i][j].begin();
-                    for (int temp = tempCounter; k != _matrix[i][j].end() && temp > 0; ++k)
-                        --temp;
-
-                    if ((*k)->getLabel().getLabelString() == "")
+                    Edge* edge = edgeInCell(_slots[i], _slots[j], tempCounter);
+                    if (edge->getLabel().getLabelString() == "")
                         resultString << " ";
                     else
-                        resultString << (*k)->getLabel();
+                        resultString << edge->getLabel();
                 }
             }
             resultString << "\n";
@@ -438,31 +538,27 @@ string MatrixGraph::toString() const
 
     for (unsigned i = 0; i < _numberOfNodes; ++i)
         for (unsigned j = 0; j < _numberOfNodes; ++j)
-            if(maxDepth < _matrix[i][j].size())
-                maxDepth = _matrix[i][j].size();
+            if(maxDepth < cellSize(_slots[i], _slots[j]))
+                maxDepth = cellSize(_slots[i], _slots[j]);
 
     for(unsigned tempCounter = 0; tempCounter < maxDepth || tempCounter == 0; ++tempCounter)
     {
         resultString << "\nlayer " << tempCounter << ": \n";
-        for (unsigned i = 0; i < _matrix.size(); ++i)
+        for (unsigned i = 0; i < _numberOfNodes; ++i)
         {
-            for (unsigned j = 0 ; j < _matrix[i].size(); ++j)
+            for (unsigned j = 0 ; j < _numberOfNodes; ++j)
             {
                 // if tempCounter (current Layer) is more than the deepest index of a cell
-                if(_matrix[i][j].size() <= tempCounter)
+                if(cellSize(_slots[i], _slots[j]) <= tempCounter)
                     resultString << ".";
                 else
                 {
                     // go to the right layer
-
-                    list<Edge*>::const_iterator k = _matrix[i][j].begin();
-                    for (int temp = tempCounter; k != _matrix[i][j].end() && temp > 0; ++k)
-                        --temp;
-
-                    if ((*k)->getLabel().getLabelString() == "")
+                    Edge* edge = edgeInCell(_slots[i], _slots[j], tempCounter);
+                    if (edge->getLabel().getLabelString() == "")
                         resultString << " ";
                     else
-                        resultString << (*k)->getLabel();
+                        resultString << edge->getLabel();
                 }
             }
             resultString << "\n";
@@ -1,16 +1,26 @@
 /*
  Author: Balazs Nemeth
  Description: implements an adjacencyList matrix
+              The matrix itself only holds one bit for each cell (see BitMatrix), the bit is set if there is at least one edge
+              between the two nodes. The edges are kept in a hash on (source, target): the first edge of a cell in _firstEdges,
+              the other edges of that cell (multigraphs or edges with different labels) in _otherEdges. A simple graph
+              never uses _otherEdges, so it costs one bit per cell and one hash entry per edge.
+              A node has a slot in the matrix (its row and column). Removing a node only clears it's row and column and leaves
+              the slot as a tombstone, the matrix is compacted when more than half of the slots are tombstones. The slots of
+              the nodes keep the order of the nodes, because a new node always gets a new slot at the end.
      */
 
 #ifndef MATRIXGRAPH_H
 #define MATRIXGRAPH_H
 
 #include <QDebug>
+#include <QHash>
+#include <QPair>
 #include <list>
 #include <vector>
 
 #include "graph.h"
+#include "bitmatrix.h"
 
 using namespace std;
 /* adjacencyList matrix looks like this:
@@ -37,7 +47,7 @@ public:
     // create a MatrixGrgaph using a graphtuple. The vectors are created by the superclass
     MatrixGraph(const IntegerMatrix& integerMatrix);
     // creates an empty MatrixGraph with a name, the baseclass handles this
-    MatrixGraph(string name) : Graph(name) {}
+    MatrixGraph(string name) : Graph(name), _numberOfTombstones(0) {}
     // clean up
     ~MatrixGraph();
     // returns this graph in the form of a graphTuple
@@ -57,10 +67,15 @@ public:
     void recreateFrom(const Graph& other);
     // recreates the graph form an integermatrix
     void recreateFrom(const IntegerMatrix& integerMatrix);
+    void recreateFrom(const SparseMatrix& sparseMatrix);
+    void addBatch(const GraphBuilder& builder);
     // returns the neighbours of node, an alternative version of this function is availible in the baseclass that calls this function
     list<Node*> getNeighbours(Node* node) const;
     list<Edge*> getOutgoingEdges(Node* node) const;
     list<Edge*> getIncomingEdges(Node* node)  const;
+    void forEachOutgoingEdge(Node* node, EdgeFunctor& functor) const;
+    void forEachIncomingEdge(Node* node, EdgeFunctor& functor) const;
+    void forEachNeighbour(Node* node, NodeFunctor& functor) const;
     void accept(Visitor& v) {v.visit(*this);}
     // use labels to create edges, calls the function from the baseclass after checking if the labels are valid
     void addEdge(unsigned sourceID, unsigned targetID, const Label& label);
@@ -85,15 +100,46 @@ public:
     string toStringID() const;
 protected:
 private:
+    // a cell of the matrix is found in the hashes by it's source and target
+    typedef QPair<Node*, Node*> Cell;
+    // returns the slot of the node in the matrix or -1 if the node isn't in this graph
+    int nodeToSlot(Node* node) const;
+    // removes the tombstones from the matrix, the nodes get the slots 0 to n-1 again
+    void compactMatrix();
+    // the functions below work on slots, not on node indices
     // delets ALL the edges between 2 nodes, this will also take care of memory management
     void deleteEdgesBetweenNodes(int i, int j);
-    // helpfunction that extends the matrix by n
-    void extendMatrix(int n = 1);
-    /* helpfunction that removes one colomn and one row from the matrix given by the index.
-       retractMatrix will only change the matrix strucurally. In other words edges wont be deleted*/
-    void retractMatrix(int index);
+    // puts an allocated edge in the cell from sourceSlot to targetSlot
+    void insertEdge(unsigned sourceSlot, unsigned targetSlot, Edge* edge);
+    // returns the number of edges from i to j
+    unsigned cellSize(unsigned i, unsigned j) const;
+    // returns the k-th edge from i to j, k has to be smaller than cellSize(i, j)
+    Edge* edgeInCell(unsigned i, unsigned j, unsigned k) const;
+    // returns the edge from i to j with the label or NULL if there is none
+    Edge* findInCell(unsigned i, unsigned j, const Label& label) const;
+    // calls the functor for each edge from i to j, returns false if the functor stopped the walk
+    bool forEachInCell(unsigned i, unsigned j, EdgeFunctor& functor) const;
+
+    // adds each edge to a list, used to build the lists that are returned by getOutgoingEdges and getIncomingEdges
+    class AppendEdge : public EdgeFunctor
+    {
+    public:
+        AppendEdge(list<Edge*>& edges) : _edges(edges) {}
+        bool operator()(Edge* edge) {_edges.push_back(edge); return true;}
+    private:
+        list<Edge*>& _edges;
+    };
 private:
-    vector<vector<list<Edge*> > > _matrix;
+    // bit (i, j) is set if there is at least one edge from the node in slot i to the node in slot j
+    BitMatrix _matrix;
+    // the slot of each node, _slots[i] is the slot of _nodes[i]
+    vector<unsigned> _slots;
+    // the node in each slot, NULL for a tombstone
+    vector<Node*> _slotNodes;
+    unsigned _numberOfTombstones;
+    QHash<Cell, Edge*> _firstEdges;
+    // only the cells with more than one edge are in here
+    QHash<Cell, list<Edge*> > _otherEdges;
 };
 
 #endif // MATRIXGRAPH_H
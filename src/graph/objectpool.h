@@ -0,0 +1,102 @@
+/*
+ Author: Balazs Nemeth
+ Description: ObjectPool hands out the memory for objects of one type from big slabs instead of allocating every object separately.
+              Each graph has a pool for it's nodes and one for it's edges, so loading a graph with a million edges
+              results in a few thousand allocations instead of a million. The memory of a destroyed object is reused by the next
+              object, all the slabs are freed at once when the pool is destroyed or releaseAll() is called.
+              The pool only manages memory: the objects are constructed with placement new and destroyed by calling the destructor.
+     */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <assert.h>
+
+using namespace std;
+
+template <class T>
+class ObjectPool
+{
+public:
+    ObjectPool(unsigned objectsPerSlab = 256) : _freeList(NULL), _next(NULL), _end(NULL), _objectsPerSlab(objectsPerSlab) {}
+    // frees the slabs, all the objects have to be destroyed at this point
+    ~ObjectPool() { releaseAll(); }
+
+    // returns the memory for one object, the object itself still has to be constructed
+    void* allocate()
+    {
+        // first reuse the memory of destroyed objects
+        if (_freeList)
+        {
+            Block* block = _freeList;
+            _freeList = block->next;
+            return block;
+        }
+        if (_next == _end)
+            addSlab();
+        return _next++;
+    }
+    // gives the memory of a destroyed object back to the pool
+    void deallocate(void* pointer)
+    {
+        assert(owns(pointer));
+        Block* block = static_cast<Block*>(pointer);
+        block->next = _freeList;
+        _freeList = block;
+    }
+    // returns true if the memory was handed out by this pool
+    bool owns(const void* pointer) const
+    {
+        const Block* block = static_cast<const Block*>(pointer);
+        // find the last slab that starts at or before the block, the slabs are sorted on their address
+        typename vector<Block*>::const_iterator slab = upper_bound(_slabs.begin(), _slabs.end(), block);
+        if (slab == _slabs.begin())
+            return false;
+        --slab;
+        return block < *slab + _objectsPerSlab;
+    }
+    // frees all the slabs at once, none of the objects may be used after this
+    void releaseAll()
+    {
+        for (typename vector<Block*>::iterator i = _slabs.begin(); i != _slabs.end(); ++i)
+            ::operator delete(*i);
+        _slabs.clear();
+        _freeList = _next = _end = NULL;
+    }
+
+private:
+    // a block holds an object or, when it's not used, a pointer to the next free block
+    union Block
+    {
+        Block* next;
+        char object[sizeof(T)];
+        // these members are never used, they make sure that the block is aligned for T
+        double alignDouble;
+        long alignLong;
+        void* alignPointer;
+    };
+
+    void addSlab()
+    {
+        Block* slab = static_cast<Block*>(::operator new(sizeof(Block) * _objectsPerSlab));
+        _slabs.insert(upper_bound(_slabs.begin(), _slabs.end(), slab), slab);
+        _next = slab;
+        _end = slab + _objectsPerSlab;
+    }
+
+    // a pool can't be copied, the objects belong to one graph
+    ObjectPool(const ObjectPool& other);
+    ObjectPool& operator=(const ObjectPool& other);
+
+    vector<Block*> _slabs;
+    Block* _freeList;
+    // the part of the last slab that hasn't been handed out yet
+    Block* _next;
+    Block* _end;
+    unsigned _objectsPerSlab;
+};
+
+#endif // OBJECTPOOL_H
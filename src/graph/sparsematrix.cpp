@@ -0,0 +1,142 @@
+#include <assert.h>
+#include <algorithm>
+
+#include "sparsematrix.h"
+
+SparseMatrix::SparseMatrix(unsigned numberOfNodes) : _numberOfNodes(numberOfNodes), _offsets(numberOfNodes + 1, 0)
+{
+
+}
+
+SparseMatrix::SparseMatrix(const IntegerMatrix& integerMatrix) : _numberOfNodes(0), _offsets(1, 0)
+{
+    const vector<vector<unsigned> >& integers = integerMatrix.getMatrix();
+    addNodes(integers.size());
+    for (unsigned i = 0; i < integers.size(); ++i)
+        for (unsigned j = 0; j < integers[i].size(); ++j)
+            if (integers[i][j])
+                addEdge(i, j, integers[i][j]);
+}
+
+unsigned SparseMatrix::addNodes(unsigned n)
+{
+    unsigned first = _numberOfNodes;
+    _numberOfNodes += n;
+    // the new rows are empty, they end where the last row ends
+    _offsets.resize(_numberOfNodes + 1, _offsets.back());
+    return first;
+}
+
+void SparseMatrix::addEdge(unsigned source, unsigned target, unsigned multiplicity)
+{
+    assert(source < _numberOfNodes && target < _numberOfNodes);
+    if (multiplicity)
+        _pending.push_back(Entry(source, target, multiplicity));
+}
+
+void SparseMatrix::toUndirected()
+{
+    compress();
+    // add the mirror of each cell, merging with the maximum keeps a cell that is already symmetric the same
+    _pending.reserve(_cells.size());
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        for (unsigned k = _offsets[i]; k < _offsets[i + 1]; ++k)
+            _pending.push_back(Entry(_cells[k].column, i, _cells[k].multiplicity));
+    compress(true);
+}
+
+unsigned SparseMatrix::getNumberOfEdges() const
+{
+    compress();
+    unsigned total = 0;
+    for (unsigned k = 0; k < _cells.size(); ++k)
+        total += _cells[k].multiplicity;
+    return total;
+}
+
+unsigned SparseMatrix::getNumberOfCells() const
+{
+    compress();
+    return _cells.size();
+}
+
+unsigned SparseMatrix::multiplicity(unsigned source, unsigned target) const
+{
+    assert(source < _numberOfNodes && target < _numberOfNodes);
+    compress();
+    vector<Cell>::const_iterator begin = _cells.begin() + _offsets[source];
+    vector<Cell>::const_iterator end = _cells.begin() + _offsets[source + 1];
+    vector<Cell>::const_iterator i = lower_bound(begin, end, Cell(target), CompareColumns());
+    if (i == end || i->column != target)
+        return 0;
+    return i->multiplicity;
+}
+
+bool SparseMatrix::nodeHasEdge(unsigned node) const
+{
+    assert(node < _numberOfNodes);
+    compress();
+    return _offsets[node] != _offsets[node + 1];
+}
+
+const vector<unsigned>& SparseMatrix::getOffsets() const
+{
+    compress();
+    return _offsets;
+}
+
+const vector<SparseMatrix::Cell>& SparseMatrix::getCells() const
+{
+    compress();
+    return _cells;
+}
+
+void SparseMatrix::compress(bool takeMaximum) const
+{
+    if (_pending.empty())
+        return ;
+    // counting sort on the row: first count the cells of each row, the old cells and the pending edges
+    vector<unsigned> offsets(_numberOfNodes + 1, 0);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        offsets[i + 1] = _offsets[i + 1] - _offsets[i];
+    for (unsigned k = 0; k < _pending.size(); ++k)
+        ++offsets[_pending[k].source + 1];
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        offsets[i + 1] += offsets[i];
+    // then put every cell at the next free place in it's row
+    vector<Cell> cells(offsets[_numberOfNodes]);
+    vector<unsigned> next(offsets.begin(), offsets.end() - 1);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        for (unsigned k = _offsets[i]; k < _offsets[i + 1]; ++k)
+            cells[next[i]++] = _cells[k];
+    for (unsigned k = 0; k < _pending.size(); ++k)
+        cells[next[_pending[k].source]++] = Cell(_pending[k].target, _pending[k].multiplicity);
+
+    // sort each row on the column and merge the cells with the same column, the rows only get shorter so this is done in place
+    unsigned size = 0;
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        unsigned begin = offsets[i];
+        unsigned end = offsets[i + 1];
+        offsets[i] = size;
+        sort(cells.begin() + begin, cells.begin() + end, CompareColumns());
+        for (unsigned k = begin; k < end; ++k)
+        {
+            if (size != offsets[i] && cells[size - 1].column == cells[k].column)
+            {
+                if (takeMaximum)
+                    cells[size - 1].multiplicity = max(cells[size - 1].multiplicity, cells[k].multiplicity);
+                else
+                    cells[size - 1].multiplicity += cells[k].multiplicity;
+            }
+            else
+                cells[size++] = cells[k];
+        }
+    }
+    offsets[_numberOfNodes] = size;
+    cells.resize(size);
+
+    _offsets.swap(offsets);
+    _cells.swap(cells);
+    vector<Entry>().swap(_pending);
+}
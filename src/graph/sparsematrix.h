@@ -0,0 +1,84 @@
+/*
+ Author: Balazs Nemeth
+ Description: SparseMatrix is the sparse counterpart of IntegerMatrix: it holds the multiplicity of the edges between the nodes,
+              but only the cells that aren't 0 are stored. The edges are added as (source, target) pairs in any order and
+              are compressed into rows (compressed sparse row) the first time the matrix is read, cells that are added more
+              than once are merged by adding their multiplicities. The nodes are only numbered, they have no labels.
+              Use this to pass a graph between the file formats and the graphs, a graph with 100000 nodes and a few edges
+              needs a few hundred KB instead of the 10^10 cells of an IntegerMatrix.
+     */
+
+#ifndef SPARSEMATRIX_H
+#define SPARSEMATRIX_H
+
+#include <vector>
+
+#include "integermatrix.h"
+
+using namespace std;
+
+class SparseMatrix
+{
+public:
+    // a non zero cell in a row, the row is given by the offsets
+    struct Cell
+    {
+        Cell(unsigned column = 0, unsigned multiplicity = 0) : column(column), multiplicity(multiplicity) {}
+        unsigned column;
+        unsigned multiplicity;
+    };
+
+    SparseMatrix(unsigned numberOfNodes = 0);
+    // the dense matrix is converted, this is the fallback for code that still builds an IntegerMatrix
+    SparseMatrix(const IntegerMatrix& integerMatrix);
+
+    // adds n nodes without edges, returns the index of the first new node
+    unsigned addNodes(unsigned n = 1);
+    // adds multiplicity edges from source to target, both have to be smaller than getNumberOfNodes()
+    void addEdge(unsigned source, unsigned target, unsigned multiplicity = 1);
+    // makes room for the edges if the number is known in advance
+    void reserveEdges(unsigned n) {_pending.reserve(n);}
+    // makes the matrix symmetric, both (i, j) and (j, i) get the largest multiplicity of the two (like IntegerMatrix::toUndirected)
+    void toUndirected();
+
+    unsigned getNumberOfNodes() const {return _numberOfNodes;}
+    // the sum of all multiplicities
+    unsigned getNumberOfEdges() const;
+    // the number of cells that aren't 0
+    unsigned getNumberOfCells() const;
+    // the number of edges from source to target, the row is searched with a binary search
+    unsigned multiplicity(unsigned source, unsigned target) const;
+    // returns true if the node has at least one outgoing edge (any edge after toUndirected)
+    bool nodeHasEdge(unsigned node) const;
+
+    /* the compressed rows: the cells of row i are getCells()[getOffsets()[i]] up to getCells()[getOffsets()[i + 1]],
+       sorted on their column. getOffsets() has getNumberOfNodes() + 1 elements */
+    const vector<unsigned>& getOffsets() const;
+    const vector<Cell>& getCells() const;
+
+private:
+    // an edge that has been added but isn't in the compressed rows yet
+    struct Entry
+    {
+        Entry(unsigned source, unsigned target, unsigned multiplicity) : source(source), target(target), multiplicity(multiplicity) {}
+        unsigned source;
+        unsigned target;
+        unsigned multiplicity;
+    };
+    class CompareColumns
+    {
+    public:
+        bool operator()(const Cell& first, const Cell& second) const {return first.column < second.column;}
+    };
+
+    // moves the pending edges into the compressed rows, a cell that occurs more than once gets the sum (or the maximum) of the multiplicities
+    void compress(bool takeMaximum = false) const;
+
+    unsigned _numberOfNodes;
+    // the compressed rows and the edges that are waiting to be compressed, mutable because reading compresses the matrix
+    mutable vector<unsigned> _offsets;
+    mutable vector<Cell> _cells;
+    mutable vector<Entry> _pending;
+};
+
+#endif // SPARSEMATRIX_H
@@ -1,4 +1,7 @@
 #include <assert.h>
+#include <sstream>
+#include <algorithm>
+#include <QFileInfo>
 
 #include "graphtoolkit.h"
 
@@ -6,6 +9,7 @@
 #include "graph/listgraph.h"
 #include "graph/matrixgraph.h"
 #include "graph/hybridgraph.h"
+#include "graph/csrgraph.h"
 
 // tools
 #include "tools/addedgetool.h"
@@ -24,6 +28,8 @@
 #include "fileIO/formats/sparse6writer.h"
 #include "fileIO/formats/dotwriter.h"
 #include "fileIO/formats/dotreader.h"
+#include "fileIO/formats/binarygraphreader.h"
+#include "fileIO/formats/binarygraphwriter.h"
 
 // graph drawing algorithms
 #include "visitor/graphdrawingvisitors/standardlayoutvisitor.h"
@@ -37,6 +43,7 @@
 #include "visitor/graphtheoryvisitors/hamcyclevisitor.h"
 #include "visitor/graphtheoryvisitors/hampathvisitor.h"
 #include "visitor/graphtheoryvisitors/kruskalvisitor.h"
+#include "visitor/graphtheoryvisitors/tspheuristicvisitor.h"
 
 // property visitors
 #include "visitor/propertyvisitors/connectedvisitor.h"
@@ -44,6 +51,9 @@
 #include "visitor/propertyvisitors/cyclevisitor.h"
 #include "visitor/propertyvisitors/weightedvisitor.h"
 #include "visitor/propertyvisitors/completevisitor.h"
+#include "visitor/visitorbatchhandler.h"
+#include "fileIO/graphbatchreader.h"
+#include "exception/fileioex.h"
 
 
 #ifdef WIN32
@@ -138,6 +148,12 @@ Graph* GraphToolKit::createGraph(GraphType type, string name, Graph* other)
         else
             newGraph = new MatrixGraph(name);
         break;
+    case CSR:
+        if(other) // if the other parameter has been set
+            newGraph = new CSRGraph(*other);
+        else
+            newGraph = new CSRGraph(name);
+        break;
     default:
         assert(NULL); // can never be this, and can only be caused by programming error
     }
@@ -153,6 +169,8 @@ void GraphToolKit::removeGraph(unsigned id)
     _tool.clearActionsForGraph(_workingGraphs[id]);
     // notify propertyPM that the graph is removed
     _propertyPrototypeManager.notifyGraphRemoved(_workingGraphs[id]);
+    _graphTheoryPrototypeManager.notifyGraphRemoved(_workingGraphs[id]);
+    _graphDrawingPrototypeManger.notifyGraphRemoved(_workingGraphs[id]);
     // free up the memory allocated by the graph
     delete _workingGraphs[id];
     // erase that element from the working graphs
@@ -235,16 +253,29 @@ int GraphToolKit::getFocusID() const
 
 void GraphToolKit::openGraph(string fileName)
 {
-    // set the right state (the reader to read the file
-    _fileHandler.setState(_formatPrototypeManager.getReader(getExt(fileName) + "reader"));
+    /* set the right state, a new reader for the content of the file. the handler and the reader are only used for this
+       load, so loads don't share their state */
+    FormatHandlerState* reader = _formatPrototypeManager.createReader(fileName);
+    FormatHandler fileHandler;
+    fileHandler.setState(reader);
     // this is the graph that will be loaded
     Graph* newGraph = new HybridGraph();
     // set the file that we want to read
-    _fileHandler.setFileName(fileName);
+    fileHandler.setFileName(fileName);
     // we will load the graph in the newGraph pointer
-    _fileHandler.setGraphPointer(newGraph);
+    fileHandler.setGraphPointer(newGraph);
     // start the load
-    _fileHandler.doIO();
+    try
+    {
+        fileHandler.doIO();
+    }
+    catch (...)
+    {
+        delete reader;
+        delete newGraph;
+        throw;
+    }
+    delete reader;
     // add it to the working graphs
     _workingGraphs.push_back(newGraph);
     _workingGraphTypes.push_back(HYBRID);
@@ -259,10 +290,21 @@ void GraphToolKit::openGraph(string fileName)
 void GraphToolKit::saveGraph(string fileName)
 {
     assert(_focusGraph);
-    _fileHandler.setState(_formatPrototypeManager.getWriter(getExt(fileName) + "writer"));
-    _fileHandler.setFileName(fileName);
-    _fileHandler.setGraphPointer(_focusGraph);
-    _fileHandler.doIO();
+    FormatHandlerState* writer = _formatPrototypeManager.createWriter(fileName);
+    FormatHandler fileHandler;
+    fileHandler.setState(writer);
+    fileHandler.setFileName(fileName);
+    fileHandler.setGraphPointer(_focusGraph);
+    try
+    {
+        fileHandler.doIO();
+    }
+    catch (...)
+    {
+        delete writer;
+        throw;
+    }
+    delete writer;
 }
 
 void GraphToolKit::makeComplete(Graph* graph)
@@ -325,6 +367,7 @@ void GraphToolKit::setupGraphTheoryVisitors()
     _graphTheoryPrototypeManager.addVisitor(new HamCycleVisitor);
     _graphTheoryPrototypeManager.addVisitor(new HamPathVisitor);
     _graphTheoryPrototypeManager.addVisitor(new KruskalVisitor);
+    _graphTheoryPrototypeManager.addVisitor(new TSPHeuristicVisitor);
 }
 
 void GraphToolKit::setupFileFormats()
@@ -339,6 +382,8 @@ void GraphToolKit::setupFileFormats()
     _formatPrototypeManager.addFormatReader(new Sparse6Reader(), Sparse6Reader::extention() + "reader");
     _formatPrototypeManager.addFormatWriter(new DotWriter(), DotWriter::extention() + "writer");
     _formatPrototypeManager.addFormatReader(new DotReader(), DotReader::extention() + "reader");
+    _formatPrototypeManager.addFormatWriter(new BinaryGraphWriter(), BinaryGraphWriter::extention() + "writer");
+    _formatPrototypeManager.addFormatReader(new BinaryGraphReader(), BinaryGraphReader::extention() + "reader");
 }
 
 void GraphToolKit::setupPropertyVisitors()
@@ -387,22 +432,76 @@ void GraphToolKit::checkProperty(int property)
     _focusGraph->accept(*(_propertyPrototypeManager.getVisitor(property)));
 }
 
-void GraphToolKit::resetGraphDrawingAlgorithms()
+string GraphToolKit::checkPropertyBatch(const string& fileName, const string& propertyName, unsigned numberOfThreads)
 {
-    _graphDrawingPrototypeManger.resetAll();
+    const vector<PropertyVisitor*>& visitors = _propertyPrototypeManager.getPropertyVisitors();
+    PropertyVisitor* visitor = NULL;
+    for (unsigned i = 0; i < visitors.size() && !visitor; ++i)
+        if (visitors[i]->getName() == propertyName)
+            visitor = visitors[i];
+    if (!visitor)
+        throw FileIOEx(fileName, "there is no property with the name " + propertyName);
+
+    PropertyBatchHandler handler(*visitor);
+    GraphBatchReader reader;
+    reader.setNumberOfThreads(numberOfThreads);
+    unsigned long numberOfGraphs = reader.read(fileName, handler);
+    return propertyName + ": " + Label(numberOfGraphs).getLabelString() + " graphs, "
+            + Label(handler.getNumberOfGraphs(PropertyVisitor::TRUEVAL)).getLabelString() + " true, "
+            + Label(handler.getNumberOfGraphs(PropertyVisitor::FALSEVAL)).getLabelString() + " false, "
+            + Label(handler.getNumberOfGraphs(PropertyVisitor::UNDEFINED)).getLabelString() + " undefined";
+}
+
+string GraphToolKit::convertGraphs(const string& input, const string& outputDirectory, const string& extension, unsigned numberOfThreads)
+{
+    BatchConverter converter(_formatPrototypeManager);
+    converter.setNumberOfThreads(numberOfThreads);
+    if (QFileInfo(QString::fromStdString(input)).isDir())
+        converter.addDirectory(input, outputDirectory, extension);
+    else
+        converter.addManifest(input, outputDirectory, extension);
+    converter.convert();
+    return getConversionReport(converter);
 }
 
-string GraphToolKit::getExt(string inputString)
+string GraphToolKit::convertGraph(const string& input, const string& output)
 {
-    string ext;
-    unsigned i = 0;
-    while (i < inputString.size())
+    BatchConverter converter(_formatPrototypeManager);
+    converter.setNumberOfThreads(1);
+    converter.addConversion(input, output);
+    converter.convert();
+    return getConversionReport(converter);
+}
+
+string GraphToolKit::getConversionReport(const BatchConverter& converter)
+{
+    const vector<BatchConverter::Conversion>& conversions = converter.getConversions();
+    ostringstream report;
+    report.setf(ios::fixed);
+    report.precision(1);
+    unsigned numberOfConverted = 0;
+    long long bytes = 0;
+    for (unsigned i = 0; i < conversions.size(); ++i)
     {
-        if (inputString[i] == '.')
-            ext = ""; // reset the extentionstring
-        else
-            ext += inputString[i];
-        ++i;
+        const BatchConverter::Conversion& conversion = conversions[i];
+        if (!conversion.succeeded)
+        {
+            report << conversion.input << ": failed, " << conversion.error << "\n";
+            continue;
+        }
+        ++numberOfConverted;
+        bytes += conversion.inputBytes;
+        report << conversion.input << " -> " << conversion.output << ": " << conversion.numberOfNodes << " nodes, "
+               << conversion.numberOfEdges << " edges, " << conversion.milliseconds << " ms, "
+               << conversion.inputBytes / 1000.0 / max(conversion.milliseconds, 0.001) << " MB/s\n";
     }
-    return ext;
+    double seconds = max(converter.getMilliseconds(), 0.001) / 1000.0;
+    report << "converted " << numberOfConverted << " of " << conversions.size() << " files in " << seconds * 1000 << " ms, "
+           << numberOfConverted / seconds << " files/s, " << bytes / 1000000.0 / seconds << " MB/s";
+    return report.str();
+}
+
+void GraphToolKit::resetGraphDrawingAlgorithms()
+{
+    _graphDrawingPrototypeManger.resetAll();
 }
@@ -11,6 +11,7 @@
 #include "tools/toolhandler.h"
 #include "fileIO/formathandler.h"
 #include "fileIO/formatprototypemanager.h"
+#include "fileIO/batchconverter.h"
 #include "fileIO/formats/formathandlerstate.h"
 #include "tools/toolstate.h"
 #include "tools/toolpm.h"
@@ -23,7 +24,7 @@ using namespace std;
 
 /* GraphType enumeration used to determin the type of the graph,
     this information is only used to show to the user, interaction happens with a _graphpointer, no casting to actual graphs happens*/
-enum GraphType { HYBRID, LIST, MATRIX, INVALIDGRAPHTYPE };
+enum GraphType { HYBRID, LIST, MATRIX, CSR, INVALIDGRAPHTYPE };
 
 class GraphToolKit : public Subject
 {
@@ -44,7 +45,7 @@ public:
     Graph* getFocusGraph() const;
     // returns the id of the graph that has focus in the vector of graphs
     int getFocusID() const;
-    // opens the file in a new graph, it sets the right state for the format handler
+    // opens the file in a new graph, the format is recognized by the content of the file (or it's extension)
     void openGraph(string fileName);
     ToolPM& getToolPM() {return _tools;}
     // returns a pointer to the ToolHandler so that it can be linked with the right observer
@@ -62,8 +63,6 @@ public:
     void makeComplete(Graph* graph);
     // writes the focusGraph to the file given by fileName, the extention determines the encoding type
     void saveGraph(string fileName);
-    // returns a string that is the substring starting from the last dot (.) in the string
-    static string getExt(string inputString);
     // executes the algorithm with the type given by the name
     void doDrawingNormal(int algorithm);
     // will delegate one iteration call to the algorithms
@@ -75,6 +74,14 @@ public:
     AlgorithmVisitor* doTheoryIterative(int algorithm);
     // check for a property
     void checkProperty(int property);
+    /* checks the property with the given name for all the graphs in a graph6/sparse6 file with one graph on each line,
+       returns a summary of the results. numberOfThreads 0 uses one thread for each core, throws FileIOEx */
+    string checkPropertyBatch(const string& fileName, const string& propertyName, unsigned numberOfThreads = 0);
+    /* converts the graph files of input (a directory or a manifest, see BatchConverter) to the format of the extension in
+       outputDirectory, returns a report with a line for each file. numberOfThreads 0 uses one thread for each core, throws FileIOEx */
+    string convertGraphs(const string& input, const string& outputDirectory, const string& extension, unsigned numberOfThreads = 0);
+    // converts one file without opening it as a working graph, returns the same report as convertGraphs
+    string convertGraph(const string& input, const string& output);
     // returns a pointer to the propertyvistor
     const PropertyVisitorPM* getPropertyVisitorPM() const {return &_propertyPrototypeManager;}
     // returns a pointer to the algorithmvisitor
@@ -104,13 +111,14 @@ private:
     void setupPropertyVisitors();
     // sets up the nodes
     void setUpTools();
+    // the report of convertGraphs and convertGraph: the time and throughput of each file and in total
+    static string getConversionReport(const BatchConverter& converter);
 private:
     vector<Graph*> _workingGraphs;
     // the graphTypes are saved in a seperate vector because we wan't to prevent typechecking, we can this way tell the user what structure the graph is using
     vector<GraphType> _workingGraphTypes;
     Graph* _focusGraph;
     ToolHandler _tool;
-    FormatHandler _fileHandler;
     // keep track of what graphs have been removed last, when getLastRemovedGraphs is called, this list is cleared
     vector<Graph*> _lastRemovedGraphs;
     // keep track of what graphs have been added last, when getLastAddedGraphs is called, this list is cleared
@@ -2,6 +2,7 @@
 #include <QDebug>
 #include <string>
 #include <vector>
+#include <cstdlib>
 
 #include "graphtoolkit.h"
 #include "graph/matrixgraph.h"
@@ -9,6 +10,7 @@
 #include "graph/hybridgraph.h"
 #include "graph/graphComp/node.h"
 #include "exception/invalidformatex.h"
+#include "exception/fileioex.h"
 #include "observer/commandline/commandline.h"
 #include "exception/uniqueedgeex.h"
 #include "exception/uniquenodeex.h"
@@ -93,15 +95,36 @@ int main(int argc, char* argv[])
         CommandLine c;
         c.start();
     }
+    // -c input output: converts one file, the extensions determine the formats
     else if(argc == 4 && arguments[1] == string("-c"))
+    {
+        GraphToolKit graphToolKit;
+        cout << graphToolKit.convertGraph(arguments[2], arguments[3]) << "\n";
+    }
+    // -c directory|manifest outputDirectory extension [threads]: converts all the files on a pool of threads
+    else if ((argc == 5 || argc == 6) && arguments[1] == string("-c"))
+    {
+        GraphToolKit graphToolKit;
+        try
+        {
+            unsigned numberOfThreads = argc == 6 ? atoi(argv[5]) : 0;
+            cout << graphToolKit.convertGraphs(arguments[2], arguments[3], arguments[4], numberOfThreads) << "\n";
+        }
+        catch(FileIOEx e)
+        {
+            cout << e.getMessage() << "\n";
+        }
+    }
+    // -batch file property [threads]: checks the property for each graph in a graph6/sparse6 file with one graph on each line
+    else if ((argc == 4 || argc == 5) && arguments[1] == string("-batch"))
     {
         GraphToolKit graphToolKit;
         try
         {
-        graphToolKit.openGraph(arguments[2]);
-        graphToolKit.saveGraph(arguments[3]);
+            unsigned numberOfThreads = argc == 5 ? atoi(argv[4]) : 0;
+            cout << graphToolKit.checkPropertyBatch(arguments[2], arguments[3], numberOfThreads) << "\n";
         }
-        catch(InvalidFormatEx e)
+        catch(FileIOEx e)
         {
             cout << e.getMessage() << "\n";
         }
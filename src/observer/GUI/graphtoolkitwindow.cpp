@@ -29,6 +29,7 @@
 #include "propertyobserver/propertyobserver.h"
 #include "settingswindow.h"
 #include "exception/invalidgraph.h"
+#include "graph/hybridgraph.h"
 
 GraphToolKitWindow::GraphToolKitWindow(QWidget *parent) : QMainWindow(parent)
 {
@@ -104,7 +105,12 @@ void GraphToolKitWindow::stopAlgorithm()
     {
         _theoryRunning = false;
         _algorithmRan = QDateTime::currentMSecsSinceEpoch() - _algorithmRan;
-        statusBar()->showMessage("Algorithm Halted ran " + QString::number(_algorithmRan) + "msecs");
+        QString message = "Algorithm Halted ran " + QString::number(_algorithmRan) + "msecs";
+        // a hybrid graph can have switched (or been frozen) for the algorithm, the time it took to copy is shown too
+        HybridGraph* hybridGraph = dynamic_cast<HybridGraph*>(_graphToolKit->getFocusGraph());
+        if (hybridGraph)
+            message += ", " + QString::fromStdString(hybridGraph->getCostModel().toString());
+        statusBar()->showMessage(message);
         _tools->unlockTools();
         _algorithmTimer->deleteLater();
         _algorithmTimer = NULL;
@@ -188,10 +194,13 @@ void GraphToolKitWindow::createActions()
     _setMatrixAct->setCheckable(true);
     _setHybridAct = new QAction("&Hybrid Graph", this);
     _setHybridAct->setCheckable(true);
+    _setCSRAct = new QAction("&CSR Graph", this);
+    _setCSRAct->setCheckable(true);
 
     _structureGroup->addAction(_setListAct);
     _structureGroup->addAction(_setMatrixAct);
     _structureGroup->addAction(_setHybridAct);
+    _structureGroup->addAction(_setCSRAct);
 
     _makeComplete = new QAction("Make Complete", this);
 
@@ -208,6 +217,7 @@ void GraphToolKitWindow::createActions()
     connect(_setListAct, SIGNAL(triggered()), this, SLOT(changeFocusGraphType()));
     connect(_setMatrixAct, SIGNAL(triggered()), this, SLOT(changeFocusGraphType()));
     connect(_setHybridAct, SIGNAL(triggered()), this, SLOT(changeFocusGraphType()));
+    connect(_setCSRAct, SIGNAL(triggered()), this, SLOT(changeFocusGraphType()));
     connect(_openAct, SIGNAL(triggered()), this, SLOT(openGraph()));
     connect(_undoAct, SIGNAL(triggered()), this, SLOT(undoAction()));
     // close the graph that has focus and is visible to the user
@@ -466,6 +476,7 @@ void GraphToolKitWindow::createMenu()
     _graphStructureSubMenu->addAction(_setHybridAct);
     _graphStructureSubMenu->addAction(_setListAct);
     _graphStructureSubMenu->addAction(_setMatrixAct);
+    _graphStructureSubMenu->addAction(_setCSRAct);
     // add the toolsMenu, for now there are no actions
     _toolsMenu = menuBar()->addMenu("&Tools");
     // adds the algorithm menu
@@ -490,6 +501,8 @@ void GraphToolKitWindow::changeFocusGraphType()
         _graphToolKit->changeFocusGraphStructure(LIST);
     else if (_setMatrixAct->isChecked())
         _graphToolKit->changeFocusGraphStructure(MATRIX);
+    else if (_setCSRAct->isChecked())
+        _graphToolKit->changeFocusGraphStructure(CSR);
     else
         _graphToolKit->changeFocusGraphStructure(HYBRID);
 }
@@ -709,10 +722,14 @@ void GraphToolKitWindow::updateGraphStructureMenu()
     case MATRIX:
         _setMatrixAct->setChecked(true);
         break;
+    case CSR:
+        _setCSRAct->setChecked(true);
+        break;
     default:
         _setHybridAct->setChecked(false);
         _setMatrixAct->setChecked(false);
         _setListAct->setChecked(false);
+        _setCSRAct->setChecked(false);
         break;
     }
 }
@@ -161,6 +161,7 @@ private: // member variables
     QAction* _setHybridAct;
     QAction* _setMatrixAct;
     QAction* _setListAct;
+    QAction* _setCSRAct;
     qint64 _algorithmRan;
     QActionGroup* _structureGroup;
     // this is the subject that we will be observing, and will be set after the first notification
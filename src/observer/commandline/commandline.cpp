@@ -3,6 +3,7 @@
 #include "graph/listgraph.h"
 #include "graph/matrixgraph.h"
 #include "graph/hybridgraph.h"
+#include "graph/csrgraph.h"
 #include "exception/unexistingedgeex.h"
 #include "exception/unexistingnodeex.h"
 #include "exception/uniqueedgeex.h"
@@ -38,13 +39,13 @@ int CommandLine::determineOperation()
 {
     int operation;
     showOperationMenu();
-    operation = getInput(0,6);
+    operation = getInput(0,7);
     while (operation == -1)
     {
         clear();
         cout << "\nInvalid choice, please try again...\n";
         showOperationMenu();
-        operation = getInput(0,6);
+        operation = getInput(0,7);
     }
     return operation;
 }
@@ -60,6 +61,7 @@ void CommandLine::showOperationMenu()
     cout << "4. Remove an edge\n";
     cout << "5. Print graph\n";
     cout << "6. Print graph with node ID's instead of labels\n";
+    cout << "7. Print the state switches of a hybrid graph\n";
     cout << "0. Exit\n";
     cout << "\nChoose one of the previous options by inserting the corresponding number.\n";
     cout << "\nChoice: ";
@@ -69,13 +71,13 @@ int CommandLine::determineGraphType()
 {
     int type;
     showGraphMenu();
-    type = getInput(1,3);
+    type = getInput(1,4);
     while (type == -1)
     {
         clear();
         cout << "\nInvalid choice, please try again...\n";
         showGraphMenu();
-        type = getInput(1,3);
+        type = getInput(1,4);
     }
     return type;
 }
@@ -119,6 +121,7 @@ void CommandLine::showGraphMenu()
     cout << "1. Adjacency list implementation\n";
     cout << "2. Adjacency matrix implementation\n";
     cout << "3. Hybrid implementation\n";
+    cout << "4. Compressed sparse row implementation\n";
     cout << "\nChoose one of the previous options by inserting the corresponding number.\n";
     cout << "\nChoice: ";
 }
@@ -147,6 +150,13 @@ void CommandLine::createGraph(int type)
         _workingGraph->registerObserver(this);
         break;
 
+        // compressed sparse row
+    case 4:
+        _workingGraph = new CSRGraph();
+        _workingGraph->registerObserver(this);
+        cout << "\nGraph (compressed sparse row implementation) was created!\n";
+        break;
+
         // invalid, should never get here because of getInput()
     default:
         cout << "Invalid graph type!\n Exiting program...\n";
@@ -196,6 +206,11 @@ void CommandLine::doOperation(int operation)
         printGraphID();
         break;
 
+        // the statistics of the cost model
+    case 7:
+        printStateSwitches();
+        break;
+
         // invalid, should never get here because of getInput()
     default:
         cout << "Invalid operation!\n Exiting program...\n";
@@ -335,6 +350,16 @@ void CommandLine::printGraphID()
     cout << _workingGraph->toStringID();
 }
 
+void CommandLine::printStateSwitches()
+{
+    cout << endl;
+    HybridGraph* hybridGraph = dynamic_cast<HybridGraph*>(_workingGraph);
+    if (hybridGraph)
+        cout << hybridGraph->getCostModel().toString() << endl;
+    else
+        cout << "Only a hybrid graph switches between states" << endl;
+}
+
 void CommandLine::clear() const
 {
     for (unsigned i = 0; i < 100; ++i)
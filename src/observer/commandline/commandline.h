@@ -56,6 +56,7 @@ private:
     void removeEdgeOperation();
     void printGraph();
     void printGraphID();
+    void printStateSwitches();
 };
 
 #endif // COMMANDLINE_H
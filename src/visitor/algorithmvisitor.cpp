@@ -5,3 +5,12 @@ AlgorithmVisitor::AlgorithmVisitor()
     _graph = NULL;
     _finished = false;
 }
+
+void AlgorithmVisitor::graphRemoved(Graph* graph)
+{
+    if (graph != _graph)
+        return;
+    cleanUp();
+    _graph = NULL;
+    _finished = true;
+}
@@ -22,7 +22,15 @@ public:
     virtual void iterationStep(Graph& graph) = 0;
     virtual bool isFinished() const { return _finished; }
     virtual string getName() const = 0;
+    // returns a new visitor of the same type, used when the visitor has to run on several graphs at the same time (see GraphBatchReader)
+    virtual AlgorithmVisitor* clone() const = 0;
     void setFinished(bool val) { _finished = val; }
+    // removes what the visitor added to the graph only to show it's result (like the edges of a route)
+    virtual void cleanUp() {}
+    // an algorithm looks at the whole graph at once without adding or removing anything, the frozen graph is faster for that
+    virtual bool freezesGraph() const {return true;}
+    // called before graph is deleted, if it's the graph of the visitor it's cleaned up and forgotten
+    void graphRemoved(Graph* graph);
 
 protected:
     // a reference that is kept to the graph that is being worked on
@@ -43,3 +43,9 @@ void AlgorithmVisitorPM::resetAll()
     for (unsigned i = 0; i < _visitors.size(); ++i)
         _visitors[i]->setFinished(true);
 }
+
+void AlgorithmVisitorPM::notifyGraphRemoved(Graph* graph)
+{
+    for (unsigned i = 0; i < _visitors.size(); ++i)
+        _visitors[i]->graphRemoved(graph);
+}
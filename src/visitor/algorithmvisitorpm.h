@@ -32,6 +32,8 @@ public:
     list<string> getNames() const;
     // resets all values of the visitors, used when we stop the algo to reset
     void resetAll();
+    // tells the visitors that the graph will be deleted, so they can remove what they added to it
+    void notifyGraphRemoved(Graph* graph);
 
 private:
     vector<AlgorithmVisitor*> _visitors;
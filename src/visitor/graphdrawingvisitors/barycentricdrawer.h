@@ -17,6 +17,7 @@ public:
     // do one iteration of the aglorithm
     void iterationStep(Graph& graph);
     string getName() const { return "Barycentric -  William T. Tutte";}
+    AlgorithmVisitor* clone() const {return new BarycentricDrawer();}
 private:
     void init(Graph &graph);
     bool isLocked(Node* node) const;
@@ -174,19 +174,19 @@ float ForceDirectedVisitor::calcHeight(const vector<Node*>& nodes)
 list<Edge*> ForceDirectedVisitor::getEdgesFromNodes(Graph *graph, const vector<Node *>& nodes)
 {
     list<Edge*> edgeList;
-    list<Edge*> tempList;
-    for (unsigned i = 0; i < nodes.size() && edgeList.size() != graph->getNumberOfEdges(); ++i)
-    {
-        tempList = graph->getOutgoingEdges(nodes[i]);
-        for (list<Edge*>::const_iterator j = tempList.begin(); j != tempList.end(); ++j)
-        {
-            if (!((*j)->isSelfEdge()) && !(alreadyHaveEdge(edgeList, *j)))
-                edgeList.push_back(*j);
-        }
-    }
+    CollectEdge collectEdge(this, edgeList);
+    for (unsigned i = 0; i < nodes.size(); ++i)
+        graph->forEachOutgoingEdge(nodes[i], collectEdge);
     return edgeList;
 }
 
+bool ForceDirectedVisitor::CollectEdge::operator()(Edge* edge)
+{
+    if (!(edge->isSelfEdge()) && !(_visitor->alreadyHaveEdge(_edgeList, edge)))
+        _edgeList.push_back(edge);
+    return true;
+}
+
 bool ForceDirectedVisitor::alreadyHaveEdge(const list<Edge*>& edgeList, Edge* edge)
 {
     for (list<Edge*>::const_iterator j = edgeList.begin(); j != edgeList.end(); ++j)
@@ -5,6 +5,7 @@
 #define FORCEDIRECTEDVISITOR_H
 
 #include "visitor/algorithmvisitor.h"
+#include "graph/edgefunctor.h"
 #include <vector>
 #include <list>
 #include "graph/graphComp/point.h"
@@ -21,6 +22,7 @@ public:
     // do one iteration of the aglorithm
     void iterationStep(Graph& graph);
     string getName() const { return "Force Directed Algorithm - Fruchterman and Reingold";}
+    AlgorithmVisitor* clone() const {return new ForceDirectedVisitor();}
 
 private:
     // calculates the area that is occupied by the nodes
@@ -31,6 +33,16 @@ private:
     // will return a list containing ALL the edges in the graph, calling this function is very expensive, should be done only when REALLY needed
     list<Edge*> getEdgesFromNodes(Graph* graph, const vector<Node*>& nodes);
     bool alreadyHaveEdge(const list<Edge*>& edgeList, Edge* edge);
+    // edge functor used by getEdgesFromNodes, collects the edges that aren't self edges and that we don't have yet
+    class CollectEdge : public EdgeFunctor
+    {
+    public:
+        CollectEdge(ForceDirectedVisitor* visitor, list<Edge*>& edgeList) : _visitor(visitor), _edgeList(edgeList) {}
+        bool operator()(Edge* edge);
+    private:
+        ForceDirectedVisitor* _visitor;
+        list<Edge*>& _edgeList;
+    };
     Graph* _graph;
     double _width;
     double _height;
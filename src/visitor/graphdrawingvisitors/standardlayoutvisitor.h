@@ -23,6 +23,7 @@ public:
     // do one iteration of the aglorithm
     void iterationStep(Graph& graph);
     string getName() const { return "Standard Layout Algorithm - Balazs Nemeth";}
+    AlgorithmVisitor* clone() const {return new StandardLayoutVisitor();}
 protected:
     /* making the actual layout algorithm protected will allow any
         algorithmen that needs the standard layout algorithm to have a starting point to use it if it is deriven from this class*/
@@ -46,18 +46,11 @@ void BreadthFirstSearchVisitor::next()
     if (_workingNode == NULL)
         return;
 
-    list<Edge*> currentOutgoing = _workingGraph->getOutgoingEdges(_workingNode);
-
-    // var used to check whether some node has been chosen as the new current
-    int lowID = -1;
-
     // ga alle edges af en als ge er gene kunt currenten de volgende in de queue pakken en deleten
-    for (list<Edge*>::iterator it = currentOutgoing.begin(); it != currentOutgoing.end(); ++it)
-    {
-        // if we have not visited the edge yet AND there was no good previous edge to a node or this node has a smaller id
-        if (!_visited[_workingGraph->nodeToIndex((*it)->getTarget())] && (lowID == -1 || _workingGraph->nodeToIndex( (*it)->getTarget()) < lowID ))
-            lowID = _workingGraph->nodeToIndex( (*it)->getTarget());
-    }
+    LowestUnvisitedTarget lowest(_workingGraph, _visited);
+    _workingGraph->forEachOutgoingEdge(_workingNode, lowest);
+    // var used to check whether some node has been chosen as the new current
+    int lowID = lowest.lowID();
 
     // node has no edges or no correct (unseen) edges
     if (lowID == -1)
@@ -70,6 +63,9 @@ void BreadthFirstSearchVisitor::next()
         {
             // there is an item waiting in the queue -- change the working node
             _breadthQueue.pop();
+            // the working node was the last one in the queue, there is no next
+            if (end())
+                return;
             _workingNode = _breadthQueue.front();
             next();
         }
@@ -22,6 +22,7 @@ public:
     void iterationStep(Graph& graph);
     bool isFinished() const { return end(); }
     string getName() const;
+    AlgorithmVisitor* clone() const {return new BreadthFirstSearchVisitor();}
 
     // iterate one step ahead
     void next();
@@ -35,63 +35,31 @@ void DepthFirstSearchVisitor::next()
         return;
     }
 
-    // get all outgoing from our current
-    list<Edge*> currentOutgoing = _workingGraph->getOutgoingEdges(_current);
-    unsigned size = currentOutgoing.size();
+    // run through the outgoing edges of our current to find the edge to the lowest node id, this is going to be the next item we visit
+    LowestUnvisitedTarget lowest(_workingGraph, _visited);
+    _workingGraph->forEachOutgoingEdge(_current, lowest);
+    int lowID = lowest.lowID();
 
-    // if there is no outgoing edge, pop current from stack and check if there is an element left
-    if (size == 0)
+    // there is no outgoing edge or all edges have already been visited!
+    if (lowID == -1)
     {
+        // go back again
         _depthStack.pop();
-        // if we are finished, there is no next
+        // no more elements to visit
         if (end())
             _current = NULL;
-        // else we continue with the previous element
+        // continue with next
         else
         {
             _current = _depthStack.top();
             next();
         }
-
     }
     else
     {
-
-        // unique init
-        int lowID = -1;
-
-        // we know that size > 0 so we can init the lowID with the first edge of the list if it has not been visited already
-        if (!_visited[_workingGraph->nodeToIndex((*currentOutgoing.begin())->getTarget())])
-            lowID = _workingGraph->nodeToIndex((*currentOutgoing.begin())->getTarget());
-        // run through the list of edges to find the edge to the lowest node id, this is going to be the next item we visit
-        for (list<Edge*>::iterator it = ++currentOutgoing.begin(); it != currentOutgoing.end(); ++it)
-        {
-            // if we have not visited this node yet AND if the id has not been changed yet or the id is lower than the current id
-            if (!_visited[_workingGraph->nodeToIndex((*it)->getTarget())] && (lowID == -1 || _workingGraph->nodeToIndex( (*it)->getTarget()) < lowID ))
-                lowID = _workingGraph->nodeToIndex( (*it)->getTarget());
-        }
-
-        // we have not changed lowID -> all edges have already been visited!
-        if (lowID == -1)
-        {
-            // go back again
-            _depthStack.pop();
-            // no more elements to visit
-            if (end())
-                _current = NULL;
-            // continue with next
-            else
-            {
-                _current = _depthStack.top();
-                next();
-            }
-        }
-        else
-        {
-            _visited[lowID] = true;
-            _depthStack.push(_graphNodes[lowID]);
-            _current = _graphNodes[lowID];
-        }
+        _visited[lowID] = true;
+        _depthStack.push(_graphNodes[lowID]);
+        _current = _graphNodes[lowID];
     }
 
     if (_current != NULL)
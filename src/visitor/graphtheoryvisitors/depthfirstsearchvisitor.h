@@ -22,6 +22,7 @@ public:
     void iterationStep(Graph& graph);
     bool isFinished() const { return end(); }
     string getName() const;
+    AlgorithmVisitor* clone() const {return new DepthFirstSearchVisitor();}
 
     // iterate one step ahead
     void next();
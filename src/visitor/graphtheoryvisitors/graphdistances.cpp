@@ -0,0 +1,36 @@
+#include "graphdistances.h"
+#include "graph/graphComp/edge.h"
+
+bool GraphDistances::compute(const Graph& graph, DistanceMatrix& distances)
+{
+    const vector<Node*>& nodes = graph.getNodes();
+    if (graph.getNumberOfEdges() == 0 && graph.getDistances())
+    {
+        distances = *graph.getDistances();
+        return true;
+    }
+
+    // the matrix is built once, the solvers only use the matrix
+    distances = DistanceMatrix(nodes.size());
+    AddEdge addEdge(graph, distances);
+    for (unsigned i = 0; i < nodes.size() && addEdge.weighted(); ++i)
+    {
+        addEdge.setSource(i);
+        // the walk stops at the first edge that is no cost
+        graph.forEachOutgoingEdge(nodes[i], addEdge);
+    }
+    return addEdge.weighted();
+}
+
+bool GraphDistances::AddEdge::operator()(Edge* edge)
+{
+    _weighted = edge->getLabel().isCost();
+    if (!_weighted)
+        return false;
+    unsigned target = _graph.nodeToIndex(edge->getTarget());
+    float cost = edge->getLabel().getCost();
+    // a loop is never part of a route, of more edges between the same nodes the cheapest one is taken
+    if (target != _source && cost < _distances.distance(_source, target))
+        _distances.setDistance(_source, target, cost);
+    return true;
+}
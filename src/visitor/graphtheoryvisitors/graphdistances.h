@@ -0,0 +1,40 @@
+/*
+ Author: Balazs Nemeth
+ Description: GraphDistances gives the distances between the nodes of a graph as a DistanceMatrix for the TSP visitors
+              (TSPVisitor and TSPHeuristicVisitor). A graph with edges uses the costs in the labels of it's edges (the cheapest
+              edge if there are more between two nodes, no edge is an infinite distance). A graph without edges uses the
+              distances it was read with (see Graph::getDistances()), that's how large TSPLIB instances keep their distances.
+     */
+
+#ifndef GRAPHDISTANCES_H
+#define GRAPHDISTANCES_H
+
+#include "graph/graph.h"
+#include "graph/distancematrix.h"
+#include "graph/edgefunctor.h"
+
+class GraphDistances
+{
+public:
+    /* puts the distances of the graph in distances, returns false if an edge has no cost. A graph without edges and without
+       distances gets a matrix without any edge */
+    static bool compute(const Graph& graph, DistanceMatrix& distances);
+
+private:
+    // edge functor that puts the cost of the edges of a node in the matrix, it stops at the first edge that has no cost
+    class AddEdge : public EdgeFunctor
+    {
+    public:
+        AddEdge(const Graph& graph, DistanceMatrix& distances) : _graph(graph), _distances(distances), _source(0), _weighted(true) {}
+        void setSource(unsigned source) {_source = source;}
+        bool operator()(Edge* edge);
+        bool weighted() const {return _weighted;}
+    private:
+        const Graph& _graph;
+        DistanceMatrix& _distances;
+        unsigned _source;
+        bool _weighted;
+    };
+};
+
+#endif // GRAPHDISTANCES_H
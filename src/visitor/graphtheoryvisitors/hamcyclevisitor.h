@@ -1,6 +1,9 @@
 /*
    Author: Jeroen Vaelen
-   Description: This visitors calculates if the graph has a Hamiltonian cycle and shows it
+   Description: This visitors calculates if the graph has a Hamiltonian cycle and shows it. The cycle is searched with a
+                HamiltonianSolver (dynamic programming for small graphs, backtracking for larger ones, see setMethod()),
+                the animation then walks along the cycle: each iterationStep() colors the next node and edge orange,
+                the last step colors the whole cycle green.
    */
 
 #ifndef HAMCYCLEVISITOR_H
@@ -10,6 +13,7 @@
 #include <vector>
 #include <list>
 #include "graph/graphComp/rgb.h"
+#include "hamiltoniansolver.h"
 
 class Node;
 class Edge;
@@ -17,39 +21,29 @@ class Edge;
 class HamCycleVisitor : public AlgorithmVisitor
 {
 public:
-    HamCycleVisitor();
+    HamCycleVisitor(HamiltonianSolver::Method method = HamiltonianSolver::AUTOMATIC);
     ~HamCycleVisitor();
     void visit(Graph& graph);
-    // do one iteration of the algorithm -- check if one path is hamiltonian
+    // do one iteration of the algorithm -- color the next node of the cycle
     void iterationStep(Graph& graph);
     string getName() const { return "Hamiltonian Cycle"; }
+    AlgorithmVisitor* clone() const {return new HamCycleVisitor(_method);}
     bool isFinished() const;
+    // the method of the solver, the next graph that is visited uses it
+    void setMethod(HamiltonianSolver::Method method) {_method = method;}
 
 private:
     // check whether there is an edge between source and target, edge is set to this edge if there is one, else NULL
     // the reason we do not use Graph::edgeExists() is because the label does not matter now
     bool isEdge( Node* source, Node* target, Edge** edge);
-    // edges that have been colored in the proces of computing a cycle
-    vector<Edge*> _coloredEdges;
-    // bool to indicate that a cycle has been found
-    bool _cycleFound;
-    // init function
+    // init function, searches the cycle and throws InvalidGraph if there is none
     void initialise(Graph& graph);
-    // current permutation, to make sure we don't get out of bounds
-    vector<Node*> _permutation;
-    // calculates next permutation and returns true if it's a hamiltonian cycle
-    bool permutateAndValidate();
-    // vector that holds the indices of the current permutation's nodes in the graph.nodes vector
-    vector<int> _positions;
-    // vector that holds the original node's colors, used if we reset the colors
-    vector<RGB> _nodeColors;
-    // vector that holds the original edge's colors, used if we reset the colors
-    vector<RGB> _edgeColors;
-    // checks if the permutation has doubles
-    bool doubles(vector<int>& perm);
-    // bool that checks if any drawing action has been done, if not we iterate again so it does not look like the application might be freezing
-    bool _drew;
-
+    // the method that is used to search the cycle
+    HamiltonianSolver::Method _method;
+    // the nodes of the cycle in order, the first node isn't repeated at the end
+    vector<Node*> _cycle;
+    // the node of the cycle that the next iteration colors
+    unsigned _next;
 };
 
 #endif // HAMCYCLEVISITOR_H
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <assert.h>
+
+#include "hamiltoniansolver.h"
+#include "graph/graphComp/edge.h"
+
+HamiltonianSolver::HamiltonianSolver(const Graph& graph) : _numberOfNodes(graph.getNumberOfNodes()), _hasLoop(false), _cycle(false), _deadEnds(0)
+{
+    _outgoing.resize(_numberOfNodes);
+    _incoming.resize(_numberOfNodes);
+    const vector<Node*>& nodes = graph.getNodes();
+    AddEdge addEdge(graph, *this);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        addEdge.setSource(i);
+        graph.forEachOutgoingEdge(nodes[i], addEdge);
+    }
+    // edges with different labels between the same nodes are one edge here
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        sort(_outgoing[i].begin(), _outgoing[i].end());
+        _outgoing[i].erase(unique(_outgoing[i].begin(), _outgoing[i].end()), _outgoing[i].end());
+        sort(_incoming[i].begin(), _incoming[i].end());
+        _incoming[i].erase(unique(_incoming[i].begin(), _incoming[i].end()), _incoming[i].end());
+    }
+}
+
+bool HamiltonianSolver::AddEdge::operator()(Edge* edge)
+{
+    unsigned target = _graph.nodeToIndex(edge->getTarget());
+    if (target == _source)
+        _solver._hasLoop = true;
+    else
+    {
+        _solver._outgoing[_source].push_back(target);
+        _solver._incoming[target].push_back(_source);
+    }
+    return true;
+}
+
+bool HamiltonianSolver::findCycle(Method method)
+{
+    return find(true, method);
+}
+
+bool HamiltonianSolver::findPath(Method method)
+{
+    return find(false, method);
+}
+
+bool HamiltonianSolver::find(bool cycle, Method method)
+{
+    _path.clear();
+    if (_numberOfNodes == 0)
+        return false;
+    if (_numberOfNodes == 1)
+    {
+        if (cycle && !_hasLoop)
+            return false;
+        _path.push_back(0);
+        return true;
+    }
+    // the bitmasks of a larger graph don't fit in memory
+    if (method == AUTOMATIC || _numberOfNodes > MAXIMUMDYNAMICPROGRAMMINGNODES)
+        method = _numberOfNodes <= MAXIMUMDYNAMICPROGRAMMINGNODES ? DYNAMICPROGRAMMING : BACKTRACKING;
+    return method == DYNAMICPROGRAMMING ? findDynamicProgramming(cycle) : findBacktracking(cycle);
+}
+
+bool HamiltonianSolver::findDynamicProgramming(bool cycle)
+{
+    const unsigned all = (1u << _numberOfNodes) - 1;
+    // the nodes with an edge to each node as a bitmask
+    vector<unsigned> incoming(_numberOfNodes, 0);
+    for (unsigned v = 0; v < _numberOfNodes; ++v)
+        for (unsigned i = 0; i < _incoming[v].size(); ++i)
+            incoming[v] |= 1u << _incoming[v][i];
+
+    /* ends[set] is the set of nodes where a path through exactly the nodes of set can end. a path through set can end in v
+       if a path through set without v ends in a node with an edge to v. a cycle can start anywhere, so it's paths start in
+       node 0 and only the sets with node 0 are used */
+    vector<unsigned> ends(all + 1, 0);
+    if (cycle)
+        ends[1] = 1;
+    else
+        for (unsigned v = 0; v < _numberOfNodes; ++v)
+            ends[1u << v] = 1u << v;
+    for (unsigned set = 1; set <= all; ++set)
+    {
+        if (cycle && !(set & 1))
+            continue;
+        for (unsigned v = cycle ? 1 : 0; v < _numberOfNodes; ++v)
+        {
+            unsigned rest = set & ~(1u << v);
+            if (rest != set && rest && (ends[rest] & incoming[v]))
+                ends[set] |= 1u << v;
+        }
+    }
+
+    // the last node of a cycle needs an edge back to node 0
+    unsigned last = cycle ? ends[all] & incoming[0] : ends[all];
+    if (!last)
+        return false;
+    // walk back from the last node, each time to a node where the path through the other nodes can end
+    unsigned set = all;
+    unsigned v = 0;
+    while (!(last & (1u << v)))
+        ++v;
+    _path.push_back(v);
+    while (set & (set - 1))
+    {
+        set &= ~(1u << v);
+        unsigned previous = ends[set] & incoming[v];
+        assert(previous);
+        v = 0;
+        while (!(previous & (1u << v)))
+            ++v;
+        _path.push_back(v);
+    }
+    reverse(_path.begin(), _path.end());
+    return true;
+}
+
+bool HamiltonianSolver::findBacktracking(bool cycle)
+{
+    _cycle = cycle;
+    _visited.assign(_numberOfNodes, false);
+    _freeIncoming.resize(_numberOfNodes);
+    _freeOutgoing.resize(_numberOfNodes);
+    _deadEnds = 0;
+    unsigned sources = 0;
+    for (unsigned v = 0; v < _numberOfNodes; ++v)
+    {
+        _freeIncoming[v] = _incoming[v].size();
+        _freeOutgoing[v] = _outgoing[v].size();
+        if (!_freeOutgoing[v])
+            ++_deadEnds;
+        if (!_freeIncoming[v])
+            ++sources;
+    }
+    // a cycle goes in and out of every node, a path can only start in one node without edges in and end in one without edges out
+    if ((cycle && (sources || _deadEnds)) || sources > 1 || _deadEnds > 1)
+        return false;
+
+    /* a cycle can start in any node, the node with the fewest ways out gives the fewest branches. a path has to start in the
+       node without edges in if there is one, otherwise each node is tried, the ones with the fewest ways in first */
+    vector<pair<unsigned, unsigned> > starts;
+    for (unsigned v = 0; v < _numberOfNodes; ++v)
+        starts.push_back(make_pair(cycle ? _outgoing[v].size() : _incoming[v].size(), v));
+    sort(starts.begin(), starts.end());
+    if (cycle || sources)
+        starts.resize(1);
+
+    // the candidates for the next node at each position of the path and the index of the next candidate to try
+    vector<vector<unsigned> > candidates;
+    vector<unsigned> next;
+    for (unsigned s = 0; s < starts.size(); ++s)
+    {
+        unsigned node = starts[s].second;
+        while (true)
+        {
+            if (visitNode(node))
+            {
+                if (_path.size() == _numberOfNodes)
+                    return true;
+                // the free neighbours, a node that can only be reached from here has to be next
+                vector<pair<unsigned, unsigned> > neighbours;
+                for (unsigned i = 0; i < _outgoing[node].size(); ++i)
+                {
+                    unsigned neighbour = _outgoing[node][i];
+                    if (_visited[neighbour])
+                        continue;
+                    if (!_freeIncoming[neighbour])
+                    {
+                        neighbours.clear();
+                        neighbours.push_back(make_pair(0, neighbour));
+                        break;
+                    }
+                    neighbours.push_back(make_pair(_freeOutgoing[neighbour], neighbour));
+                }
+                // the neighbours with the fewest ways out first, they are the hardest to visit later
+                sort(neighbours.begin(), neighbours.end());
+                candidates.push_back(vector<unsigned>());
+                for (unsigned i = 0; i < neighbours.size(); ++i)
+                    candidates.back().push_back(neighbours[i].second);
+                next.push_back(0);
+            }
+            else
+                unvisitNode();
+
+            // backtrack to the last position that has a candidate left
+            while (!candidates.empty() && next.back() == candidates.back().size())
+            {
+                candidates.pop_back();
+                next.pop_back();
+                unvisitNode();
+            }
+            if (candidates.empty())
+                break;
+            node = candidates.back()[next.back()++];
+        }
+    }
+    return false;
+}
+
+bool HamiltonianSolver::visitNode(unsigned node)
+{
+    unsigned previous = _path.empty() ? node : _path.back();
+    _visited[node] = true;
+    _path.push_back(node);
+    if (!_freeOutgoing[node])
+        --_deadEnds;
+    // the first node of a cycle stays a way out for the others, it's where the cycle ends
+    if (!(_cycle && _path.size() == 1))
+        for (unsigned i = 0; i < _incoming[node].size(); ++i)
+            if (--_freeOutgoing[_incoming[node][i]] == 0 && !_visited[_incoming[node][i]])
+                ++_deadEnds;
+    for (unsigned i = 0; i < _outgoing[node].size(); ++i)
+        --_freeIncoming[_outgoing[node][i]];
+
+    if (_path.size() == _numberOfNodes)
+        return !_cycle || hasEdge(node, _path[0]);
+    // degree pruning: every free node needs a way out, except the last node of a path
+    if (_deadEnds > (_cycle ? 0u : 1u))
+        return false;
+    // a free node without free nodes to come from has to be entered from the end of the path, the next node
+    for (unsigned i = 0; i < _outgoing[previous].size(); ++i)
+    {
+        unsigned neighbour = _outgoing[previous][i];
+        if (!_visited[neighbour] && !_freeIncoming[neighbour] && !hasEdge(node, neighbour))
+            return false;
+    }
+    unsigned forced = 0;
+    for (unsigned i = 0; i < _outgoing[node].size(); ++i)
+        if (!_visited[_outgoing[node][i]] && !_freeIncoming[_outgoing[node][i]])
+            ++forced;
+    if (forced > 1)
+        return false;
+    // a cycle has to get back to the first node from one of the free nodes
+    if (_cycle && !_freeIncoming[_path[0]])
+        return false;
+    // connectivity cut: the free nodes have to be reachable from the end of the path, for a cycle they have to reach the first node
+    return freeNodesReachable(_path.back(), _outgoing) && (!_cycle || freeNodesReachable(_path[0], _incoming));
+}
+
+void HamiltonianSolver::unvisitNode()
+{
+    unsigned node = _path.back();
+    for (unsigned i = 0; i < _outgoing[node].size(); ++i)
+        ++_freeIncoming[_outgoing[node][i]];
+    if (!(_cycle && _path.size() == 1))
+        for (unsigned i = 0; i < _incoming[node].size(); ++i)
+            if (_freeOutgoing[_incoming[node][i]]++ == 0 && !_visited[_incoming[node][i]])
+                --_deadEnds;
+    if (!_freeOutgoing[node])
+        ++_deadEnds;
+    _visited[node] = false;
+    _path.pop_back();
+}
+
+bool HamiltonianSolver::freeNodesReachable(unsigned node, const vector<vector<unsigned> >& edges)
+{
+    _reached.assign(_numberOfNodes, false);
+    _stack.clear();
+    _stack.push_back(node);
+    unsigned numberOfReached = 0;
+    while (!_stack.empty())
+    {
+        node = _stack.back();
+        _stack.pop_back();
+        for (unsigned i = 0; i < edges[node].size(); ++i)
+        {
+            unsigned neighbour = edges[node][i];
+            if (_visited[neighbour] || _reached[neighbour])
+                continue;
+            _reached[neighbour] = true;
+            ++numberOfReached;
+            _stack.push_back(neighbour);
+        }
+    }
+    return numberOfReached == _numberOfNodes - _path.size();
+}
+
+bool HamiltonianSolver::hasEdge(unsigned source, unsigned target) const
+{
+    return binary_search(_outgoing[source].begin(), _outgoing[source].end(), target);
+}
@@ -0,0 +1,86 @@
+/*
+ Author: Balazs Nemeth
+ Description: HamiltonianSolver finds a Hamiltonian cycle or path (following the direction of the edges) in a graph, it's the
+              engine of HamCycleVisitor and HamPathVisitor. There are two methods:
+              - DYNAMICPROGRAMMING (Held-Karp): for each set of nodes the set of nodes where a path through exactly those
+                nodes can end is computed with bitmasks, O(2^n * n) time and 2^n words of memory, so only for small graphs.
+              - BACKTRACKING: a depth first search that extends the path with the free neighbour that has the fewest free
+                neighbours itself. A branch is cut as soon as a free node has no way in or out left (degree pruning) or
+                the free nodes can't all be reached from the end of the path anymore (connectivity cut). This is
+                exponential in the worst case, but fast for larger sparse graphs.
+              AUTOMATIC uses dynamic programming up to MAXIMUMDYNAMICPROGRAMMINGNODES nodes and backtracking otherwise.
+     */
+
+#ifndef HAMILTONIANSOLVER_H
+#define HAMILTONIANSOLVER_H
+
+#include <vector>
+
+#include "graph/graph.h"
+#include "graph/edgefunctor.h"
+
+using namespace std;
+
+class HamiltonianSolver
+{
+public:
+    enum Method { AUTOMATIC, DYNAMICPROGRAMMING, BACKTRACKING };
+    // the bitmasks of the dynamic programming take 2^n words
+    static const unsigned MAXIMUMDYNAMICPROGRAMMINGNODES = 20;
+
+    // the edges of the graph are copied as lists of node indices, the graph isn't used afterwards
+    HamiltonianSolver(const Graph& graph);
+    // returns true if there is a Hamiltonian cycle, getPath() is the cycle then (without the first node repeated)
+    bool findCycle(Method method = AUTOMATIC);
+    // returns true if there is a Hamiltonian path, getPath() is the path then
+    bool findPath(Method method = AUTOMATIC);
+    // the indices of the nodes of the last cycle or path that was found, in order
+    const vector<unsigned>& getPath() const {return _path;}
+
+private:
+    // edge functor that adds the index of the target to the lists of the source and the target
+    class AddEdge : public EdgeFunctor
+    {
+    public:
+        AddEdge(const Graph& graph, HamiltonianSolver& solver) : _graph(graph), _solver(solver), _source(0) {}
+        void setSource(unsigned source) {_source = source;}
+        bool operator()(Edge* edge);
+    private:
+        const Graph& _graph;
+        HamiltonianSolver& _solver;
+        unsigned _source;
+    };
+
+    bool find(bool cycle, Method method);
+    bool findDynamicProgramming(bool cycle);
+    bool findBacktracking(bool cycle);
+    // backtracking: adds the node to the end of the path and updates the free degrees, returns false if a branch has to be cut
+    bool visitNode(unsigned node);
+    // backtracking: removes the last node of the path and restores the free degrees
+    void unvisitNode();
+    // backtracking: true if all the free nodes can be reached from node through free nodes, following edges (_outgoing or _incoming)
+    bool freeNodesReachable(unsigned node, const vector<vector<unsigned> >& edges);
+    bool hasEdge(unsigned source, unsigned target) const;
+
+    unsigned _numberOfNodes;
+    // the sorted neighbours of each node, without loops and without duplicates
+    vector<vector<unsigned> > _outgoing;
+    vector<vector<unsigned> > _incoming;
+    // a loop on a graph with one node is it's Hamiltonian cycle
+    bool _hasLoop;
+    vector<unsigned> _path;
+
+    // the state of the backtracking
+    bool _cycle;
+    vector<bool> _visited;
+    // the number of free (not visited) nodes that have an edge to or from each node, for a cycle the first node counts as free
+    vector<unsigned> _freeIncoming;
+    vector<unsigned> _freeOutgoing;
+    // the number of free nodes that have no free node to go to, only the last node of a path can be one
+    unsigned _deadEnds;
+    // the stack and marks of freeNodesReachable()
+    vector<unsigned> _stack;
+    vector<bool> _reached;
+};
+
+#endif // HAMILTONIANSOLVER_H
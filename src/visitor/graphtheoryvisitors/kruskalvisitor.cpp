@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "kruskalvisitor.h"
 #include "graph/graphComp/node.h"
 #include "graph/graphComp/edge.h"
@@ -6,21 +8,17 @@
 KruskalVisitor::KruskalVisitor()
 {
     // seed
+    _graph = NULL;
+    _next = 0;
+    _numberOfNodes = 0;
     initialised = false;
     rejected = NULL;
 }
 
 void KruskalVisitor::visit(Graph &graph)
 {
-    // check if graph is weighted and init _graph
-    init (graph);
-
-    // init cluster
-    initCluster();
-
-    // init prio queue with all weights
-    initQueue(Q);
-
+    // check if graph is weighted, sort the edges and init the clusters
+    init(graph);
     initialised = true;
 
     while ( !isFinished() )
@@ -31,15 +29,8 @@ void KruskalVisitor::iterationStep(Graph &graph)
 {
     if (!initialised)
     {
-        // check if graph is weighted and init _graph
-        init (graph);
-
-        // init cluster
-        initCluster();
-
-        // init prio queue with all weights
-        initQueue(Q);
-
+        // check if graph is weighted, sort the edges and init the clusters
+        init(graph);
         initialised = true;
     }
 
@@ -51,176 +42,107 @@ void KruskalVisitor::iterationStep(Graph &graph)
             rejected = NULL;
         }
         // catch the edge that currently has the lowest weight
-        Edge* current = Q.top();
-        // remove that edge from the queue
-        Q.pop();
+        const CostEdge& current = _edges[_next++];
 
-        // value that sameCluster sets to the cluster the vertices are in
-        unsigned cluster1, cluster2;
-        if (!sameCluster(current->getSource(), current->getTarget(), cluster1, cluster2))
+        unsigned root1 = findCluster(current.source);
+        unsigned root2 = findCluster(current.target);
+        if (root1 != root2)
         {
-            _forest.push_back(current);
-            clusterUnion(cluster1, cluster2);
-            current->setColor(RGB::colorGreen());
+            _forest.push_back(current.edge);
+            clusterUnion(root1, root2);
+            current.edge->setColor(RGB::colorGreen());
         }
         else
         {
-            rejcolor = current->getColor();
-            current->setColor(RGB::colorOrange());
-            rejected = current;
+            rejcolor = current.edge->getColor();
+            current.edge->setColor(RGB::colorOrange());
+            rejected = current.edge;
         }
     }
     // re-init
     else
-    {
-        // check if graph is weighted and init _graph
-        init (graph);
-
-        // init cluster
-        initCluster();
-
-        // init prio queue with all weights
-        initQueue(Q);
-
-    }
-
+        init(graph);
 }
 
 bool KruskalVisitor::isFinished() const
 {
-    return (_forest.size() >= _graph->getNumberOfNodes()-1);
-}
-
-QString KruskalVisitor::printClusters()
-{
-    QString result = "{ ";
-    for (unsigned i = 0; i < _cluster.size(); ++i)
-    {
-        result += "{ ";
-        for (unsigned j = 0; j < _cluster[i].size(); ++j)
-        {
-            result.append(_cluster[i][j]->getLabel().getLabelString().c_str()).append(" ");
-
-        }
-        result += "} ";
-
-    }
-    result += "}";
-    return result;
-
+    // a spanning tree has n - 1 edges, if the graph isn't connected the edges run out first
+    return initialised && (_forest.size() + 1 >= _numberOfNodes || _next == _edges.size());
 }
 
-bool KruskalVisitor::sameCluster(Node* v1, Node* v2, unsigned & cluster1, unsigned & cluster2)
+unsigned KruskalVisitor::findCluster(unsigned node)
 {
-    bool seenv1 = false;
-    bool seenv2 = false;
-    // run through all clusters and check if the two nodes are in the same one
-    for (unsigned i = 0; i < _cluster.size(); ++i)
+    unsigned root = node;
+    while (_parent[root] != root)
+        root = _parent[root];
+    // path compression: all the nodes on the way get the root as parent
+    while (_parent[node] != root)
     {
-        for (unsigned j = 0; j < _cluster[i].size(); ++j)
-        {
-            if (_cluster[i][j] == v1)
-            {
-                // v1 is in cluster i
-                cluster1 = i;
-                seenv1 = true;
-            }
-            else if (_cluster[i][j] == v2)
-            {
-                // v2 is in cluster i
-                cluster2 = i;
-                seenv2 = true;
-            }
-            // if we see both v1 and v2 in one cluster, return true
-            if (seenv1 && seenv2)
-                return true;
-        }
-        // reset bool values
-        seenv1 = seenv2 = false;
+        unsigned parent = _parent[node];
+        _parent[node] = root;
+        node = parent;
     }
-    // if we get here, the nodes are not in the same cluster
-    return false;
+    return root;
 }
 
-void KruskalVisitor::clusterUnion(unsigned cluster1, unsigned cluster2)
+void KruskalVisitor::clusterUnion(unsigned root1, unsigned root2)
 {
-    vector<Node*> newCluster;
-    // add contents of cluster1 and cluster2 to new vector
-    newCluster.insert(newCluster.end(), _cluster[cluster1].begin(), _cluster[cluster1].end());
-    newCluster.insert(newCluster.end(), _cluster[cluster2].begin(), _cluster[cluster2].end());
-    // add the new vector
-    _cluster.push_back(newCluster);
-    // remove the old clusters
-    _cluster.erase(_cluster.begin() + cluster1);
-    if (cluster1 < cluster2)
-        _cluster.erase(_cluster.begin() + (cluster2-1));
+    // union by rank: the lower tree is hung under the root of the higher one
+    if (_rank[root1] < _rank[root2])
+        _parent[root1] = root2;
+    else if (_rank[root1] > _rank[root2])
+        _parent[root2] = root1;
     else
-        _cluster.erase(_cluster.begin() + cluster2);
-}
-
-void KruskalVisitor::initQueue(priority_queue<Edge*, vector<Edge*>, compare>& Q)
-{
-    // run through all edges and add labels
-    vector<Node*> nodes = _graph->getNodes();
-    unsigned size = nodes.size();
-    for (unsigned i = 0; i < size; ++i)
     {
-        Node* current = nodes[i];
-        list<Edge*> outgoing = _graph->getOutgoingEdges(current);
-        for (list<Edge*>::iterator it = outgoing.begin(); it != outgoing.end(); ++it)
-            Q.push(*it);
+        _parent[root2] = root1;
+        ++_rank[root1];
     }
-
 }
 
-void KruskalVisitor::initCluster()
+bool KruskalVisitor::AddEdge::operator()(Edge* edge)
 {
-    vector<Node*> nodes = _graph->getNodes();
-    unsigned size = nodes.size();
-    for (unsigned i = 0; i < size; ++i)
-    {
-        vector<Node*> currCluster;
-        currCluster.push_back(nodes[i]);
-        _cluster.push_back(currCluster);
-    }
+    _weighted = edge->getLabel().isCost();
+    if (!_weighted)
+        return false;
+    CostEdge costEdge;
+    costEdge.cost = edge->getLabel().getCost();
+    costEdge.source = _graph.nodeToIndex(edge->getSource());
+    costEdge.target = _graph.nodeToIndex(edge->getTarget());
+    costEdge.edge = edge;
+    _edges.push_back(costEdge);
+    return true;
 }
 
 void KruskalVisitor::init(Graph &graph)
 {
-    // graph has to be weighted
-    if (!isWeighted(graph))
-        throw (InvalidGraph("Graph is not weighted",2));
-    // graph has to have nodes
-    if (graph.getNumberOfNodes() < 1)
-        return;
-
-    clearQueue();
-    _cluster.clear();
-    _forest.clear();
+    // the edge that was rejected last in the previous run gets it's color back
+    if (rejected != NULL && _graph == &graph)
+        rejected->setColor(rejcolor);
+    rejected = NULL;
     _graph = &graph;
-
-}
-
-void KruskalVisitor::clearQueue()
-{
-    while (!Q.empty())
-        Q.pop();
-}
-
-bool KruskalVisitor::isWeighted(Graph &graph)
-{
-    // visit all nodes from the graph and check if their outgoing edges all have number labels
-    vector<Node*> nodes = graph.getNodes();
-    unsigned size = nodes.size();
-    for (unsigned i = 0; i < size; ++i)
+    _forest.clear();
+    _edges.clear();
+    _next = 0;
+    _numberOfNodes = graph.getNumberOfNodes();
+
+    // visit all nodes from the graph, their outgoing edges all have to have number labels
+    const vector<Node*>& nodes = graph.getNodes();
+    _edges.reserve(graph.getNumberOfEdges());
+    AddEdge addEdge(graph, _edges);
+    for (unsigned i = 0; i < nodes.size() && addEdge.weighted(); ++i)
+        // the walk stops at the first edge that is no cost
+        graph.forEachOutgoingEdge(nodes[i], addEdge);
+    if (!addEdge.weighted())
     {
-        list<Edge*> outgoing = graph.getOutgoingEdges(nodes[i]);
-        for (list<Edge*>::iterator it = outgoing.begin(); it != outgoing.end(); ++it)
-        {
-            // if this edge is no cost, the property is false
-            if (!(*it)->getLabel().isCost())
-                return false;
-        }
+        _edges.clear();
+        throw (InvalidGraph("Graph is not weighted",2));
     }
-    return true;
+    // edges with the same cost keep the order of the graph, so the result doesn't depend on the sort
+    stable_sort(_edges.begin(), _edges.end());
+
+    // each node starts in it's own cluster
+    _parent.resize(_numberOfNodes);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        _parent[i] = i;
+    _rank.assign(_numberOfNodes, 0);
 }
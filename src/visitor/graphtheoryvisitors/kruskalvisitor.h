@@ -1,13 +1,16 @@
 /*
   Author: Jeroen Vaelen
-  Description: Visitor that computes the minimal spanning tree for a weighted graph using Kruskal's algorithm
+  Description: Visitor that computes the minimal spanning tree for a weighted graph using Kruskal's algorithm.
+  The costs of the edges are read from their labels once and the edges are sorted on them, the clusters are a disjoint-set
+  forest (union by rank and path compression), so the MST takes O(m log m). If the graph isn't connected, the result is a
+  minimal spanning forest. Each iterationStep() handles one edge: green if it's added to the forest, orange if it's rejected.
   */
 
 #ifndef KRUSKALVISITOR_H
 #define KRUSKALVISITOR_H
 
 #include "visitor/algorithmvisitor.h"
-#include <queue>
+#include <vector>
 #include "graph/graphComp/edge.h"
 #include "graph/graph.h"
 
@@ -27,50 +30,59 @@ public:
     // does one iteration in Kruskal's algorithm
     void iterationStep(Graph& graph);
 
-    // returns true if we have computed the minimal spanning tree
+    // returns true if we have computed the minimal spanning tree (or forest if the graph isn't connected)
     bool isFinished() const;
 
     string getName() const { return "Kruskal's Algorithm"; }
+    AlgorithmVisitor* clone() const {return new KruskalVisitor();}
 
 private:
-    // comparision functor that compares two edges' their label and sorts them so that the lowest weight is first in the prio queue
-    class compare
+    // an edge with the cost and the indices of it's nodes, so the costs are only parsed once and the nodes only looked up once
+    struct CostEdge
+    {
+        int cost;
+        unsigned source;
+        unsigned target;
+        Edge* edge;
+        // the edges are sorted so that the lowest cost is first
+        bool operator<(const CostEdge& other) const {return cost < other.cost;}
+    };
+    // edge functor that adds the edges of a node with their costs, it stops at the first edge that has no cost
+    class AddEdge : public EdgeFunctor
     {
     public:
-      bool operator() (const Edge* e1, const Edge* e2) const
-      {
-          return atoi(e1->getLabel().getLabelString().c_str()) > atoi(e2->getLabel().getLabelString().c_str());
-      }
+        AddEdge(const Graph& graph, vector<CostEdge>& edges) : _graph(graph), _edges(edges), _weighted(true) {}
+        bool operator()(Edge* edge);
+        bool weighted() const {return _weighted;}
+    private:
+        const Graph& _graph;
+        vector<CostEdge>& _edges;
+        bool _weighted;
     };
+
+    // gets the costs of the edges, sorts them and makes a cluster of each node, throws InvalidGraph if the graph isn't weighted
+    void init(Graph& graph);
+    // returns the root of the cluster of the node, the nodes on the way point to the root afterwards
+    unsigned findCluster(unsigned node);
+    // combines two clusters (given by their roots) to one bigger cluster
+    void clusterUnion(unsigned root1, unsigned root2);
+
     // forest, will ultimately contain the edges of the MST
     vector<Edge*> _forest;
-    // cluster that is initialised as { {v1}, {v2}, ... } with vi a vertex of the graph
-    vector<vector<Node*> > _cluster;
-    // initializes the graph
-    void init(Graph& graph);
-    // graph has to be weighted
-    bool isWeighted(Graph &graph);
-    // priority queue that holds all weights with the lowest weight the highest priority element
-    priority_queue<Edge*, vector<Edge*>, compare> Q;
-    // inits the priority queue with the weights of the edges so that the top is the edge with the lowest weight
-    void initQueue(priority_queue<Edge*, vector<Edge*>, compare>& Q);
-    // removes all elements from the queue
-    void clearQueue();
-    // inits the cluster
-    void initCluster();
-    // checks if two vertices are in the same cluster, also sets cluster1 and cluster2 to the clusters where v1 and v2 are in
-    bool sameCluster(Node* v1, Node* v2, unsigned & cluster1, unsigned & cluster2);
-    // combines two clusters to one bigger cluster
-    void clusterUnion(unsigned cluster1, unsigned cluster2);
+    // the edges of the graph sorted on their cost, _next is the edge that the next iteration handles
+    vector<CostEdge> _edges;
+    unsigned _next;
+    // the disjoint-set forest of the clusters: the parent of each node (a root is it's own parent) and the rank of the roots
+    vector<unsigned> _parent;
+    vector<unsigned char> _rank;
+    // the number of nodes of the graph when init() was called
+    unsigned _numberOfNodes;
     // boolean that tells us if we have initialised our environement yet
     bool initialised;
     // holds the Edge that has been rejected, so that we can deselect it
     Edge* rejected;
     // holds the color of the rejected Edge before we make it orange
     RGB rejcolor;
-
-    QString printClusters();
-
 };
 
 #endif // KRUSKALVISITOR_H
@@ -1,6 +1,7 @@
 #include "searchvisitor.h"
 #include <assert.h>
 #include "graph/hybridgraph.h"
+#include "graph/graphComp/edge.h"
 
 SearchVisitor::SearchVisitor()
 {
@@ -11,7 +12,7 @@ SearchVisitor::SearchVisitor()
 
 SearchVisitor::~SearchVisitor()
 {
-    delete _visited;
+    delete[] _visited;
 }
 
 void SearchVisitor::setUpGraph(Graph *graph)
@@ -21,9 +22,23 @@ void SearchVisitor::setUpGraph(Graph *graph)
     assert(graph->getNumberOfNodes() > 0); // REPLACE WITH THROW(Valid graph but no nodes, cannot iterate)
     _workingGraph = graph;
     _graphNodes = graph->getNodes();
+    // the visitor can be set up more than once (iterationStep starts over when it's finished)
+    delete[] _visited;
     _visited = new bool[_graphNodes.size()];
+    for (unsigned i = 0; i < _graphNodes.size(); ++i)
+        _visited[i] = false;
     // we have asserted that numberOfNodes > 0
     // node we start with is the first node that has been added
     _current = _graphNodes[0];
     _visited[0] = true;
 }
+
+bool SearchVisitor::LowestUnvisitedTarget::operator()(Edge* edge)
+{
+    int index = _graph->nodeToIndex(edge->getTarget());
+    // if we have not visited the target yet AND there was no good previous target or this target has a smaller id
+    if (!_visited[index] && (_lowID == -1 || index < _lowID))
+        _lowID = index;
+    // keep going, all the edges have to be seen
+    return true;
+}
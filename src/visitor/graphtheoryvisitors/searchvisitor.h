@@ -8,6 +8,8 @@
 
 #include <vector>
 
+#include "graph/edgefunctor.h"
+
 class Node;
 class Graph;
 
@@ -34,6 +36,19 @@ public:
     void setUpGraph(Graph* graph);
 
 protected:
+    // edge functor that finds the unvisited target with the lowest index between the outgoing edges of a node
+    class LowestUnvisitedTarget : public EdgeFunctor
+    {
+    public:
+        LowestUnvisitedTarget(Graph* graph, bool* visited) : _lowID(-1), _graph(graph), _visited(visited) {}
+        bool operator()(Edge* edge);
+        // -1 if all the targets have been visited
+        int lowID() const {return _lowID;}
+    private:
+        int _lowID;
+        Graph* _graph;
+        bool* _visited;
+    };
 
     Graph* _workingGraph;
     Node* _current;
@@ -0,0 +1,102 @@
+#include <algorithm>
+
+#include "stronglyconnectedcomponents.h"
+#include "graph/graphComp/edge.h"
+
+StronglyConnectedComponents::StronglyConnectedComponents(const Graph& graph) : _numberOfNodes(graph.getNumberOfNodes())
+{
+    _firstEdge.reserve(_numberOfNodes + 1);
+    _targets.reserve(graph.getNumberOfEdges());
+    const vector<Node*>& nodes = graph.getNodes();
+    AddEdge addEdge(graph, _targets);
+    // the nodes are handled in order, so the edges of each node end up after each other
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        _firstEdge.push_back(_targets.size());
+        graph.forEachOutgoingEdge(nodes[i], addEdge);
+    }
+    _firstEdge.push_back(_targets.size());
+    _componentStart.push_back(0);
+}
+
+bool StronglyConnectedComponents::AddEdge::operator()(Edge* edge)
+{
+    _targets.push_back(_graph.nodeToIndex(edge->getTarget()));
+    return true;
+}
+
+unsigned StronglyConnectedComponents::compute()
+{
+    const unsigned NOINDEX = unsigned(-1);
+
+    _components.assign(_numberOfNodes, 0);
+    _componentNodes.clear();
+    _componentNodes.reserve(_numberOfNodes);
+    _componentStart.assign(1, 0);
+
+    // the order in which the nodes were visited and the lowest index that can be reached from each node
+    vector<unsigned> index(_numberOfNodes, NOINDEX);
+    vector<unsigned> lowlink(_numberOfNodes, 0);
+    // the stack of Tarjan's algorithm, the nodes that don't have a component yet
+    vector<unsigned> stack;
+    vector<bool> onStack(_numberOfNodes, false);
+    // the depth first search path: each node with the next of it's edges to follow
+    vector<pair<unsigned, unsigned> > path;
+    unsigned nextIndex = 0;
+
+    for (unsigned root = 0; root < _numberOfNodes; ++root)
+    {
+        if (index[root] != NOINDEX)
+            continue;
+
+        index[root] = lowlink[root] = nextIndex++;
+        stack.push_back(root);
+        onStack[root] = true;
+        path.push_back(make_pair(root, _firstEdge[root]));
+
+        while (!path.empty())
+        {
+            unsigned node = path.back().first;
+            unsigned edge = path.back().second;
+            if (edge < _firstEdge[node + 1])
+            {
+                ++path.back().second;
+                unsigned target = _targets[edge];
+                if (index[target] == NOINDEX)
+                {
+                    // target hasn't been visited yet, go deeper
+                    index[target] = lowlink[target] = nextIndex++;
+                    stack.push_back(target);
+                    onStack[target] = true;
+                    path.push_back(make_pair(target, _firstEdge[target]));
+                }
+                else if (onStack[target])
+                    // target is in the component of node
+                    lowlink[node] = min(lowlink[node], index[target]);
+                continue;
+            }
+
+            // all the edges of node are done, go back to the node before it
+            path.pop_back();
+            if (!path.empty())
+                lowlink[path.back().first] = min(lowlink[path.back().first], lowlink[node]);
+
+            // if node is the root of a component, the component is node and all nodes above it on the stack
+            if (lowlink[node] == index[node])
+            {
+                unsigned component = _componentStart.size() - 1;
+                unsigned member;
+                do
+                {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = false;
+                    _components[member] = component;
+                    _componentNodes.push_back(member);
+                } while (member != node);
+                _componentStart.push_back(_componentNodes.size());
+            }
+        }
+    }
+    return getNumberOfComponents();
+}
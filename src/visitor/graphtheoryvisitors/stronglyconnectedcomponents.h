@@ -0,0 +1,59 @@
+/*
+ Author: Balazs Nemeth
+ Description: StronglyConnectedComponents computes the strongly connected components of a graph with Tarjan's algorithm,
+              it's the engine of StronglyConnectedComponentsVisitor and CycleVisitor. The edges are copied once into flat
+              arrays of node indices (the outgoing edges of node i are _targets[_firstEdge[i]] to _targets[_firstEdge[i+1]-1]).
+              The depth first search doesn't recurse, it keeps an explicit stack with the node and the next edge to follow,
+              so a long path doesn't overflow the call stack. Whether a node is on the stack of the algorithm is a bit per
+              node instead of a search through the stack. Complexity: O(|V| + |E|) time and memory.
+     */
+
+#ifndef STRONGLYCONNECTEDCOMPONENTS_H
+#define STRONGLYCONNECTEDCOMPONENTS_H
+
+#include <vector>
+
+#include "graph/graph.h"
+#include "graph/edgefunctor.h"
+
+using namespace std;
+
+class StronglyConnectedComponents
+{
+public:
+    // the edges of the graph are copied as node indices, the graph isn't used afterwards
+    StronglyConnectedComponents(const Graph& graph);
+    // computes the components, returns the number of components
+    unsigned compute();
+
+    unsigned getNumberOfComponents() const {return _componentStart.size() - 1;}
+    // the component of each node (by node index), a component only has edges to components with a lower number
+    const vector<unsigned>& getComponents() const {return _components;}
+    // the node indices grouped by component, component c is _componentNodes[_componentStart[c]] to _componentNodes[_componentStart[c+1]-1]
+    const vector<unsigned>& getComponentNodes() const {return _componentNodes;}
+    const vector<unsigned>& getComponentStart() const {return _componentStart;}
+    unsigned getComponentSize(unsigned component) const {return _componentStart[component + 1] - _componentStart[component];}
+
+private:
+    // edge functor that adds the index of the target to _targets
+    class AddEdge : public EdgeFunctor
+    {
+    public:
+        AddEdge(const Graph& graph, vector<unsigned>& targets) : _graph(graph), _targets(targets) {}
+        bool operator()(Edge* edge);
+    private:
+        const Graph& _graph;
+        vector<unsigned>& _targets;
+    };
+
+    unsigned _numberOfNodes;
+    // the outgoing edges of all nodes after each other, _firstEdge has one more entry than there are nodes
+    vector<unsigned> _firstEdge;
+    vector<unsigned> _targets;
+
+    vector<unsigned> _components;
+    vector<unsigned> _componentNodes;
+    vector<unsigned> _componentStart;
+};
+
+#endif // STRONGLYCONNECTEDCOMPONENTS_H
@@ -1,25 +1,19 @@
 #include "stronglyconnectedcomponentsvisitor.h"
+#include "stronglyconnectedcomponents.h"
 #include "graph/graphComp/edge.h"
 #include "graph/graphComp/node.h"
 #include "graph/graph.h"
 // includes needed to generate random RGB values
 #include <ctime>
 #include <cstdlib>
-#include <QVector>
 
 StronglyConnectedComponentsVisitor::StronglyConnectedComponentsVisitor() : AlgorithmVisitor()
 {
     // seed
     srand ((unsigned)time(0));
     _currentSCCToColor = 0;
-    _index = 0;
     _initDone = false;
-}
-
-StronglyConnectedComponentsVisitor::~StronglyConnectedComponentsVisitor()
-{
-    delete _indexTable;
-    delete _lowlinkTable;
+    _numberOfSCC = 0;
 }
 
 void StronglyConnectedComponentsVisitor::iterationStep(Graph& graph)
@@ -35,6 +29,10 @@ void StronglyConnectedComponentsVisitor::iterationStep(Graph& graph)
     // computes components (without coloring them) and sets how many SCC the graph has -- this should only be done ONCE
     initForIterations();
 
+    // an empty graph has no components to color
+    if (_numberOfSCC == 0)
+        return;
+
     // color one component
     colorComponent( _currentSCCToColor++ );
 
@@ -46,14 +44,15 @@ void StronglyConnectedComponentsVisitor::initForIterations()
     if (!_initDone)
     {
         computeComponents(*_graph, false);
-        _numberOfSCC = _SCC.size();
+        _numberOfSCC = _componentStart.size() - 1;
+        _currentSCCToColor = 0;
         _initDone = true;
     }
 }
 
 void StronglyConnectedComponentsVisitor::colorComponent( int comp )
 {
-    if ( comp > static_cast<int>(_numberOfSCC-1) )
+    if ( comp >= static_cast<int>(_numberOfSCC) )
     {
         // start over again
         _currentSCCToColor = 1;
@@ -62,16 +61,14 @@ void StronglyConnectedComponentsVisitor::colorComponent( int comp )
 
     unsigned char r = (rand()%256), g = (rand()%256), b = (rand()%256);
 
-    for (unsigned i = 0; i < _SCC[comp].size() ; ++i)
+    const vector<Node*>& nodes = _graph->getNodes();
+    ColorInComponent colorEdges(*_graph, _components, comp, RGB(r,g,b));
+    for (unsigned i = _componentStart[comp]; i < _componentStart[comp+1] ; ++i)
     {
-        _SCC[comp][i]->setColor(RGB(r,g,b));
-        // current node's outgoing edges
-        list<Edge*> currentOutgoing = _graph->getOutgoingEdges(_SCC[comp][i]);
+        Node* node = nodes[_componentNodes[i]];
+        node->setColor(RGB(r,g,b));
         // color current node's outgoing edge if it is going to a node that is in the same strongly connected component
-        for (list<Edge*>::iterator it = currentOutgoing.begin(); it != currentOutgoing.end(); ++it)
-            for ( unsigned k = 0; k < _SCC[comp].size(); ++k )
-                if ( (*it)->getTarget() ==  _SCC[comp][k])
-                    (*it)->setColor(RGB(r,g,b));
+        _graph->forEachOutgoingEdge(node, colorEdges);
     }
 }
 
@@ -91,121 +88,41 @@ void StronglyConnectedComponentsVisitor::visit(Graph& graph)
 
 void StronglyConnectedComponentsVisitor::computeComponents(Graph & graph, bool color)
 {
-    // reset _SCC
-    _SCC.clear();
+    StronglyConnectedComponents scc(graph);
+    scc.compute();
 
-    vector<Node*> nodes = graph.getNodes();
-    int size = nodes.size();
-
-    initTables(size);
-
-    for ( int i = 0; i < size; ++i )
-    {
-        // if nodes[i] has no index
-        if ( _indexTable[i] == -1 )
-            strongconnect( &graph, nodes[i], i );
-    }
+    // keep the result, the engine holds a copy of the edges that we don't need anymore
+    _components = scc.getComponents();
+    _componentNodes = scc.getComponentNodes();
+    _componentStart = scc.getComponentStart();
 
     if ( color )
     // color the different strongly connected components to distinguish them
         colorComponents();
 }
 
-
-// Node v is the i-the node
-// Graph is passed to use getOutgoingEdges
-void StronglyConnectedComponentsVisitor::strongconnect(Graph* g, Node *v, int i)
+bool StronglyConnectedComponentsVisitor::ColorInComponent::operator()(Edge* edge)
 {
-    // Set the depth index for v to the smallest unused index
-    _indexTable[i] = _index;
-    _lowlinkTable[i] = _index;
-    _index = _index +1;
-    S.push_front(v);
-
-    list<Edge*> outgoing = g->getOutgoingEdges(v);
-    // Consider successors of v
-    // For each (v, w) in E
-    for (list<Edge*>::iterator it = outgoing.begin() ; it != outgoing.end(); ++it)
-    {
-        // current w
-        Node* w = (*it)->getTarget();
-        // if w's index is undefined
-        if ( _indexTable[g->nodeToIndex(w)] == -1)
-        {
-            // Successor w has not yet been visited; recurse on it
-            strongconnect(g, w, g->nodeToIndex(w));
-            // v.lowlink := min(v.lowlink, w.lowlink)
-            _lowlinkTable[g->nodeToIndex(v)] = min( _lowlinkTable[g->nodeToIndex(v)], _lowlinkTable[g->nodeToIndex(w)] );
-        }
-        // else if ( w is in S )
-        else if ( isInStack(w) )
-        {
-            // Successor w is in stack S and hence in the current SCC
-            // v.lowlink := min(v.lowlink, w.index)
-            _lowlinkTable[g->nodeToIndex(v)] = min(_lowlinkTable[g->nodeToIndex(v)], _indexTable[g->nodeToIndex(w)] );
-        }
-    }
-
-    // If v is a root node, pop the stack and generate a SCC
-    if (_lowlinkTable[g->nodeToIndex(v)] == _indexTable[g->nodeToIndex(v)])
-    {
-        Node * w;
-        // start a new strongly connected component
-        vector<Node*> scc;
-        do
-        {
-            w = S.front();
-            S.pop_front();
-            // add w to current strongly connected component
-            scc.push_back(w);
-        } while (!(w==v));
-
-        // add the current strongly connected component to the vector of strongly connected component
-        _SCC.push_back(scc);
-    }
-
-}
-
-void StronglyConnectedComponentsVisitor::initTables( int size )
-{
-    _indexTable = new int[size];
-    _lowlinkTable = new int[size];
-
-    // set default values to -1 (no index/lowlink yet)
-    for ( int i = 0 ; i < size ; ++i)
-    {
-        _indexTable[i] = -1;
-        _lowlinkTable[i] = -1;
-    }
-}
-
-bool StronglyConnectedComponentsVisitor::isInStack(Node* w) const
-{
-    for ( deque<Node*>::const_iterator it = S.begin(); it != S.end(); ++it)
-    {
-        if ( (*it) == w )
-            return true;
-    }
-    return false;
+    if ( _components[_graph.nodeToIndex(edge->getTarget())] == _component )
+        edge->setColor(_color);
+    return true;
 }
 
 void StronglyConnectedComponentsVisitor::colorComponents()
 {
     unsigned char r = (rand()%256), g = (rand()%256), b = (rand()%256);
 
-    // run through all vectors in _SCC vector and give components different colors
-    for ( unsigned i = 0 ; i < _SCC.size(); ++i )
+    const vector<Node*>& nodes = _graph->getNodes();
+    // run through all components and give them different colors
+    for ( unsigned i = 0 ; i + 1 < _componentStart.size(); ++i )
     {
-        for ( unsigned j = 0; j < _SCC[i].size(); ++j )
+        ColorInComponent colorEdges(*_graph, _components, i, RGB(r,g,b));
+        for ( unsigned j = _componentStart[i]; j < _componentStart[i+1]; ++j )
         {
-            _SCC[i][j]->setColor(RGB(r,g,b));
-            // current node's outgoing edges
-            list<Edge*> currentOutgoing = _graph->getOutgoingEdges(_SCC[i][j]);
+            Node* node = nodes[_componentNodes[j]];
+            node->setColor(RGB(r,g,b));
             // color current node's outgoing edge if it is going to a node that is in the same strongly connected component
-            for (list<Edge*>::iterator it = currentOutgoing.begin(); it != currentOutgoing.end(); ++it)
-                for ( unsigned k = 0; k < _SCC[i].size(); ++k )
-                    if ( (*it)->getTarget() ==  _SCC[i][k])
-                        (*it)->setColor(RGB(r,g,b));
+            _graph->forEachOutgoingEdge(node, colorEdges);
         }
         r = (rand()%256);
         g = (rand()%256);
@@ -1,6 +1,6 @@
 /*
   Author: Jeroen Vaelen
-  Description: This visitor determines all strongly connected components of a graph using Tarjan's algorithm.
+  Description: This visitor determines all strongly connected components of a graph using Tarjan's algorithm (see StronglyConnectedComponents).
                Complexity: O(|V| + |E|)
                */
 
@@ -8,19 +8,17 @@
 #define STRONGLYCONNECTEDCOMPONENTSVISITOR_H
 
 #include "visitor/algorithmvisitor.h"
-#include <deque>
+#include "graph/edgefunctor.h"
+#include "graph/graphComp/rgb.h"
 #include <vector>
 
-class Node;
-
 class StronglyConnectedComponentsVisitor : public AlgorithmVisitor
 {
 
 public:
 
-    // constructor & destructor
+    // constructor
     StronglyConnectedComponentsVisitor();
-    ~StronglyConnectedComponentsVisitor();
 
     // computes the SCC and colors them
     void visit(Graph& graph);
@@ -32,55 +30,51 @@ public:
     bool isFinished() const;
 
     string getName() const { return "Strongly Connected Components"; }
+    AlgorithmVisitor* clone() const {return new StronglyConnectedComponentsVisitor();}
 
 
 private:
 
-    // this function calls strongconnect for every unvisited node
+    // computes the components with StronglyConnectedComponents
     // if color is passed as true, it will also do the coloring, otherwise not
     void computeComponents(Graph & graph, bool color);
 
-    // recursive function used to build the stack and determine the strongly connected components
-    void strongconnect(Graph* g, Node* v, int i);
-
-
-    /*** used in strongconnect */
-
-    // index used to determine when a node was visited
-    int _index;
-    // table that holds the index for every node
-    int *_indexTable;
-    // table that holds the lowlink for every node
-    int *_lowlinkTable;
-    // init the tables according to the graph nodes size
-    void initTables( int size );
-    // the normal algorithm uses a stack that holds DFS paths, but we use a deque because we need a isInStack(Node*) function
-    // we threat the deque as a stack
-    deque<Node*> S;
-    // help method used by strongconnect to check if a node is in S
-    bool isInStack(Node* node) const;
+    // edge functor that colors the edges whose target is in the given component
+    class ColorInComponent : public EdgeFunctor
+    {
+    public:
+        ColorInComponent(const Graph& graph, const vector<unsigned>& components, unsigned component, const RGB& color)
+            : _graph(graph), _components(components), _component(component), _color(color) {}
+        bool operator()(Edge* edge);
+    private:
+        const Graph& _graph;
+        const vector<unsigned>& _components;
+        unsigned _component;
+        RGB _color;
+    };
+
     // colors all the SCC sets in a unique color
     void colorComponents();
 
 
-    /*** build in strongconnect, result of algorithm */
+    /*** result of the algorithm */
 
-    // vector containing vectors of SCC
-    // { {1,2} , {3,5,6}  } would mean that {1,2} and {3,5,6} form SCC
-    vector<vector<Node*> > _SCC;
-    // frees components before we start again
-    void freeComponents();
+    // the SCC of every node (by node index)
+    vector<unsigned> _components;
+    // the node indices grouped by SCC, SCC c are the nodes _componentNodes[_componentStart[c]] to _componentNodes[_componentStart[c+1]-1]
+    vector<unsigned> _componentNodes;
+    vector<unsigned> _componentStart;
 
 
     /*** used in iterationstep */
 
-    // what element of _SCC do we have to color now
+    // what SCC do we have to color now
     int _currentSCCToColor;
     // bool to make sure we don't compute the SCC again every iteration!
     bool _initDone;
     // computes SCC
     void initForIterations();
-    // |_SCC|
+    // number of SCC
     unsigned _numberOfSCC;
     // colors a particular SCC
     void colorComponent( int comp );
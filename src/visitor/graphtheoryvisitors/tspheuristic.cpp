@@ -0,0 +1,448 @@
+#include <algorithm>
+#include <cmath>
+#include <assert.h>
+#include <QElapsedTimer>
+
+#include "tspheuristic.h"
+
+// a move has to make the tour at least this much shorter, so rounding errors don't make moves go back and forth
+static const double EPSILON = 1e-7;
+
+TSPHeuristic::TSPHeuristic(const DistanceMatrix& distances) : _distances(distances), _symmetric(true),
+    _numberOfNodes(distances.getNumberOfNodes()), _cost(DistanceMatrix::infinity())
+{
+    // the coordinate metrics are symmetric, an explicit matrix has to be checked
+    if (_distances.getMetric() == DistanceMatrix::EXPLICIT)
+        for (unsigned i = 0; i < _numberOfNodes && _symmetric; ++i)
+            for (unsigned j = 0; j < i && _symmetric; ++j)
+                _symmetric = _distances.distance(i, j) == _distances.distance(j, i);
+    computeNeighbours();
+}
+
+void TSPHeuristic::computeNeighbours()
+{
+    _neighbours.assign(_numberOfNodes, vector<unsigned>());
+    if (_numberOfNodes == 0)
+        return;
+    if (_distances.getMetric() != DistanceMatrix::EXPLICIT)
+    {
+        computeNeighboursGrid();
+        return;
+    }
+    // the matrix already takes n^2 memory, all the distances are looked at
+    vector<pair<double, unsigned> > nearest;
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        nearest.clear();
+        for (unsigned j = 0; j < _numberOfNodes; ++j)
+            addNeighbour(nearest, i, j);
+        for (unsigned k = 0; k < nearest.size(); ++k)
+            _neighbours[i].push_back(nearest[k].second);
+    }
+}
+
+void TSPHeuristic::computeNeighboursGrid()
+{
+    // the grid covers the coordinates of the nodes with square cells of about two nodes each, GEO only has columns (latitudes)
+    const bool geo = _distances.getMetric() == DistanceMatrix::GEO;
+    double minX = _distances.getX(0), maxX = minX, minY = _distances.getY(0), maxY = minY;
+    for (unsigned i = 1; i < _numberOfNodes; ++i)
+    {
+        minX = min(minX, _distances.getX(i));
+        maxX = max(maxX, _distances.getX(i));
+        minY = min(minY, _distances.getY(i));
+        maxY = max(maxY, _distances.getY(i));
+    }
+    double width = maxX - minX;
+    double height = geo ? 0 : maxY - minY;
+    // the cells aren't smaller than a line of n/2 cells along the longest side, so there are O(n) cells when the nodes are on a line
+    double cellSize = max(sqrt(width * height * 2 / _numberOfNodes), max(width, height) * 2 / _numberOfNodes);
+    if (cellSize == 0)
+        cellSize = 1;
+    const unsigned columns = unsigned(width / cellSize) + 1;
+    const unsigned rows = unsigned(height / cellSize) + 1;
+
+    // the nodes sorted on their cell, the nodes of cell c are cellNodes[cellStart[c]] to cellNodes[cellStart[c+1]-1]
+    vector<unsigned> cells(_numberOfNodes);
+    vector<unsigned> cellStart(columns * rows + 1, 0);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        unsigned column = min(unsigned((_distances.getX(i) - minX) / cellSize), columns - 1);
+        unsigned row = geo ? 0 : min(unsigned((_distances.getY(i) - minY) / cellSize), rows - 1);
+        cells[i] = row * columns + column;
+        ++cellStart[cells[i] + 1];
+    }
+    for (unsigned c = 0; c < columns * rows; ++c)
+        cellStart[c + 1] += cellStart[c];
+    vector<unsigned> cellNodes(_numberOfNodes);
+    vector<unsigned> fill(cellStart.begin(), cellStart.end() - 1);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        cellNodes[fill[cells[i]]++] = i;
+
+    /* the cells are searched in rings around the cell of the node. after ring r the nodes that are left are more than r cells
+       away in x or y, so they are at least r * cellSize away in that coordinate and the search stops when the nearest nodes
+       are nearer than that */
+    const unsigned wanted = _numberOfNodes - 1 < NUMBEROFNEIGHBOURS ? _numberOfNodes - 1 : NUMBEROFNEIGHBOURS;
+    vector<pair<double, unsigned> > nearest;
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        nearest.clear();
+        const int column = cells[i] % columns;
+        const int row = cells[i] / columns;
+        for (int ring = 0; ring <= int(max(columns, rows)); ++ring)
+        {
+            for (int y = max(row - ring, 0); y <= min(row + ring, int(rows) - 1); ++y)
+            {
+                // the cells in the middle of the ring were searched by the rings before, only the left and right side are left
+                int step = y == row - ring || y == row + ring ? 1 : 2 * ring;
+                for (int x = column - ring; x <= column + ring; x += max(step, 1))
+                {
+                    if (x < 0 || x >= int(columns))
+                        continue;
+                    unsigned cell = y * columns + x;
+                    for (unsigned k = cellStart[cell]; k < cellStart[cell + 1]; ++k)
+                        addNeighbour(nearest, i, cellNodes[k]);
+                }
+            }
+            if (nearest.size() == wanted && wanted > 0 && nearest.back().first <= _distances.lowerBound(ring * cellSize))
+                break;
+        }
+        for (unsigned k = 0; k < nearest.size(); ++k)
+            _neighbours[i].push_back(nearest[k].second);
+    }
+}
+
+void TSPHeuristic::addNeighbour(vector<pair<double, unsigned> >& nearest, unsigned node, unsigned neighbour) const
+{
+    // the nearest nodes found so far sorted on their distance, a nearer node is inserted at it's place
+    double d = distance(node, neighbour);
+    if (node == neighbour || d == DistanceMatrix::infinity() || (nearest.size() == NUMBEROFNEIGHBOURS && d >= nearest.back().first))
+        return;
+    if (nearest.size() == NUMBEROFNEIGHBOURS)
+        nearest.pop_back();
+    nearest.insert(upper_bound(nearest.begin(), nearest.end(), make_pair(d, neighbour)), make_pair(d, neighbour));
+}
+
+bool TSPHeuristic::construct(Construction construction)
+{
+    _tour.clear();
+    _positions.clear();
+    _cost = DistanceMatrix::infinity();
+    _removedEdges.clear();
+    _addedEdges.clear();
+    if (_numberOfNodes == 0)
+        return false;
+    bool constructed = construction == GREEDY && _symmetric ? constructGreedy() : constructNearestNeighbour();
+    // all the nodes have to be looked at by the first moves
+    _queue.clear();
+    _dontLook.assign(_numberOfNodes, !constructed);
+    if (constructed)
+        for (unsigned i = 0; i < _numberOfNodes; ++i)
+            _queue.push_back(_tour[i]);
+    return constructed;
+}
+
+bool TSPHeuristic::constructNearestNeighbour()
+{
+    vector<bool> visited(_numberOfNodes, false);
+    vector<unsigned char> degrees(_numberOfNodes, 0);
+    vector<unsigned> tour(1, 0);
+    visited[0] = true;
+    while (tour.size() < _numberOfNodes)
+    {
+        unsigned nearest = nearestFree(tour.back(), visited, degrees);
+        // stuck, the missing edges don't allow to go on
+        if (nearest == _numberOfNodes)
+            return false;
+        visited[nearest] = true;
+        tour.push_back(nearest);
+    }
+    return setTour(tour);
+}
+
+bool TSPHeuristic::constructGreedy()
+{
+    // the edges to the nearest neighbours from short to long, each edge once
+    vector<pair<double, pair<unsigned, unsigned> > > edges;
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        for (unsigned k = 0; k < _neighbours[i].size(); ++k)
+        {
+            unsigned j = _neighbours[i][k];
+            edges.push_back(make_pair(distance(i, j), make_pair(min(i, j), max(i, j))));
+        }
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+    /* an edge is added if both nodes have less than two edges and it doesn't close a cycle, so the edges form paths
+       (fragments). the fragments are kept in a disjoint-set forest */
+    const unsigned none = _numberOfNodes;
+    vector<unsigned> links(2 * _numberOfNodes, none);
+    vector<unsigned char> degrees(_numberOfNodes, 0);
+    vector<unsigned> fragments(_numberOfNodes);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        fragments[i] = i;
+    for (unsigned e = 0; e < edges.size(); ++e)
+    {
+        unsigned i = edges[e].second.first;
+        unsigned j = edges[e].second.second;
+        if (degrees[i] == 2 || degrees[j] == 2)
+            continue;
+        unsigned rootI = i;
+        while (fragments[rootI] != rootI)
+            rootI = fragments[rootI] = fragments[fragments[rootI]];
+        unsigned rootJ = j;
+        while (fragments[rootJ] != rootJ)
+            rootJ = fragments[rootJ] = fragments[fragments[rootJ]];
+        if (rootI == rootJ)
+            continue;
+        fragments[rootI] = rootJ;
+        links[2 * i + degrees[i]++] = j;
+        links[2 * j + degrees[j]++] = i;
+    }
+
+    // the fragments are walked one after the other, from the end of a fragment to the nearest end of a fragment that is left
+    vector<bool> visited(_numberOfNodes, false);
+    vector<unsigned> tour;
+    unsigned node = 0;
+    while (degrees[node] == 2)
+        ++node;
+    while (true)
+    {
+        unsigned previous = none;
+        while (node != none)
+        {
+            visited[node] = true;
+            tour.push_back(node);
+            unsigned next = links[2 * node] != previous ? links[2 * node] : links[2 * node + 1];
+            previous = node;
+            node = next;
+        }
+        if (tour.size() == _numberOfNodes)
+            break;
+        node = nearestFree(tour.back(), visited, degrees);
+        if (node == _numberOfNodes)
+            return false;
+    }
+    return setTour(tour);
+}
+
+unsigned TSPHeuristic::nearestFree(unsigned node, const vector<bool>& visited, const vector<unsigned char>& degrees) const
+{
+    for (unsigned k = 0; k < _neighbours[node].size(); ++k)
+        if (!visited[_neighbours[node][k]] && degrees[_neighbours[node][k]] < 2)
+            return _neighbours[node][k];
+    unsigned nearest = _numberOfNodes;
+    double nearestDistance = DistanceMatrix::infinity();
+    for (unsigned v = 0; v < _numberOfNodes; ++v)
+        if (!visited[v] && degrees[v] < 2 && distance(node, v) < nearestDistance)
+        {
+            nearest = v;
+            nearestDistance = distance(node, v);
+        }
+    return nearest;
+}
+
+bool TSPHeuristic::setTour(const vector<unsigned>& tour)
+{
+    assert(tour.size() == _numberOfNodes);
+    _tour = tour;
+    _positions.resize(_numberOfNodes);
+    _cost = 0;
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+    {
+        _positions[_tour[i]] = i;
+        _cost += distance(_tour[i], _tour[(i + 1) % _numberOfNodes]);
+    }
+    // the tour of one node has no edges
+    if (_numberOfNodes == 1)
+        _cost = 0;
+    return _cost != DistanceMatrix::infinity();
+}
+
+bool TSPHeuristic::improve()
+{
+    _removedEdges.clear();
+    _addedEdges.clear();
+    while (!_queue.empty())
+    {
+        unsigned node = _queue.front();
+        _queue.pop_front();
+        _dontLook[node] = true;
+        if ((_symmetric && twoOpt(node)) || orOpt(node))
+        {
+            activateEdges();
+            return true;
+        }
+    }
+    return false;
+}
+
+unsigned TSPHeuristic::optimise(double milliseconds)
+{
+    QElapsedTimer timer;
+    timer.start();
+    unsigned moves = 0;
+    while ((milliseconds <= 0 || timer.nsecsElapsed() / 1000000.0 < milliseconds) && improve())
+        ++moves;
+    return moves;
+}
+
+bool TSPHeuristic::twoOpt(unsigned a)
+{
+    if (_numberOfNodes < 4)
+        return false;
+    /* the edge (a, b) with b after (or before) a and the edge (c, d) with d after (or before) c are replaced by (a, c) and
+       (b, d). c has to be nearer to a than b, otherwise the move can't make the tour shorter */
+    for (unsigned direction = 0; direction < 2; ++direction)
+    {
+        unsigned b = direction == 0 ? next(a) : previous(a);
+        double ab = distance(a, b);
+        for (unsigned k = 0; k < _neighbours[a].size(); ++k)
+        {
+            unsigned c = _neighbours[a][k];
+            double ac = distance(a, c);
+            if (ac >= ab)
+                break;
+            unsigned d = direction == 0 ? next(c) : previous(c);
+            if (c == b || d == a)
+                continue;
+            double delta = ac + distance(b, d) - ab - distance(c, d);
+            if (delta > -EPSILON)
+                continue;
+            _removedEdges.push_back(make_pair(a, b));
+            _removedEdges.push_back(make_pair(c, d));
+            _addedEdges.push_back(make_pair(a, c));
+            _addedEdges.push_back(make_pair(b, d));
+            // a b ... c d becomes a c ... b d, b a ... d c becomes b d ... a c
+            if (direction == 0)
+                reverseTour(_positions[b], _positions[c]);
+            else
+                reverseTour(_positions[a], _positions[d]);
+            _cost += delta;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TSPHeuristic::orOpt(unsigned a)
+{
+    const unsigned n = _numberOfNodes;
+    // the part of the tour from first to last is moved between insert and the node after it
+    for (unsigned length = 1; length <= 3 && length + 3 <= n; ++length)
+    {
+        unsigned start = _positions[a];
+        unsigned first = a;
+        unsigned last = _tour[(start + length - 1) % n];
+        unsigned before = previous(first);
+        unsigned after = next(last);
+        double removed = distance(before, first) + distance(last, after) - distance(before, after);
+        if (removed <= EPSILON)
+            continue;
+        // a new place next to a neighbour of one of the ends, the neighbour can be before or after the part
+        for (unsigned end = 0; end < 2; ++end)
+        {
+            unsigned node = end == 0 ? first : last;
+            for (unsigned k = 0; k < _neighbours[node].size(); ++k)
+            {
+                unsigned c = _neighbours[node][k];
+                if (distance(node, c) >= removed)
+                    break;
+                if ((_positions[c] + n - start) % n < length)
+                    continue;
+                // the part keeps it's direction or, with symmetric distances, is reversed
+                for (unsigned reversed = 0; reversed < (_symmetric ? 2u : 1u); ++reversed)
+                {
+                    unsigned insert = (end == 0) == (reversed == 0) ? c : previous(c);
+                    unsigned insertNext = next(insert);
+                    if ((_positions[insert] + n - start) % n < length || (_positions[insertNext] + n - start) % n < length)
+                        continue;
+                    unsigned newFirst = reversed ? last : first;
+                    unsigned newLast = reversed ? first : last;
+                    double delta = distance(insert, newFirst) + distance(newLast, insertNext) - distance(insert, insertNext) - removed;
+                    if (delta > -EPSILON)
+                        continue;
+
+                    _removedEdges.push_back(make_pair(before, first));
+                    _removedEdges.push_back(make_pair(last, after));
+                    _removedEdges.push_back(make_pair(insert, insertNext));
+                    _addedEdges.push_back(make_pair(before, after));
+                    _addedEdges.push_back(make_pair(insert, newFirst));
+                    _addedEdges.push_back(make_pair(newLast, insertNext));
+                    /* the tour is the part, the nodes from after to insert and the nodes from insertNext to before. the part
+                       changes places with the shortest of the two others, three reversals swap two blocks */
+                    unsigned afterLength = (_positions[insert] + n - _positions[after]) % n + 1;
+                    unsigned beforeLength = n - length - afterLength;
+                    unsigned newStart;
+                    if (afterLength <= beforeLength)
+                    {
+                        reversePositions(start, length);
+                        reversePositions((start + length) % n, afterLength);
+                        reversePositions(start, length + afterLength);
+                        newStart = (start + afterLength) % n;
+                    }
+                    else
+                    {
+                        newStart = (start + n - beforeLength) % n;
+                        reversePositions(newStart, beforeLength);
+                        reversePositions(start, length);
+                        reversePositions(newStart, beforeLength + length);
+                    }
+                    if (reversed)
+                        reversePositions(newStart, length);
+                    _cost += delta;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void TSPHeuristic::reverseTour(unsigned first, unsigned last)
+{
+    // with symmetric distances reversing the rest of the tour gives the same tour in the other direction
+    unsigned length = (last + _numberOfNodes - first) % _numberOfNodes + 1;
+    if (2 * length > _numberOfNodes)
+        reversePositions((last + 1) % _numberOfNodes, _numberOfNodes - length);
+    else
+        reversePositions(first, length);
+}
+
+void TSPHeuristic::reversePositions(unsigned first, unsigned length)
+{
+    if (length < 2)
+        return;
+    unsigned i = first;
+    unsigned j = (first + length - 1) % _numberOfNodes;
+    for (unsigned k = 0; k < length / 2; ++k)
+    {
+        swap(_tour[i], _tour[j]);
+        _positions[_tour[i]] = i;
+        _positions[_tour[j]] = j;
+        i = i + 1 == _numberOfNodes ? 0 : i + 1;
+        j = j == 0 ? _numberOfNodes - 1 : j - 1;
+    }
+}
+
+void TSPHeuristic::activate(unsigned node)
+{
+    if (!_dontLook[node])
+        return;
+    _dontLook[node] = false;
+    _queue.push_back(node);
+}
+
+void TSPHeuristic::activateEdges()
+{
+    for (unsigned i = 0; i < _removedEdges.size(); ++i)
+    {
+        activate(_removedEdges[i].first);
+        activate(_removedEdges[i].second);
+    }
+    for (unsigned i = 0; i < _addedEdges.size(); ++i)
+    {
+        activate(_addedEdges[i].first);
+        activate(_addedEdges[i].second);
+    }
+}
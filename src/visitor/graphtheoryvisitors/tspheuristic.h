@@ -0,0 +1,97 @@
+/*
+ Author: Balazs Nemeth
+ Description: TSPHeuristic finds a short tour through all the nodes of a DistanceMatrix fast, without the guarantee of
+              TSPSolver that it's the shortest one. It's the engine of TSPHeuristicVisitor. A first tour is constructed with
+              the nearest neighbour or the greedy heuristic and then improved with local search moves until no move makes it
+              shorter:
+              - 2-opt: two edges of the tour are replaced by two others, the part between them is reversed. Only when the
+                distances are symmetric, a reversed part has another length otherwise.
+              - Or-opt: a part of 1 to 3 nodes is moved to another place in the tour (reversed too if the distances are
+                symmetric).
+              The moves only look at the NUMBEROFNEIGHBOURS nearest neighbours of each node. A node that has no improving
+              move anymore isn't looked at again until one of it's edges changes (don't look bits), so the search only
+              works where the tour changed. The neighbour lists of the coordinate metrics are found with a grid of cells
+              of about two nodes, the cells around a node are searched until no node can be nearer (about O(n) in total).
+              An explicit matrix takes O(n^2) time to compute them, which is the size of the matrix itself. A move takes
+              O(n) for the reversal.
+     */
+
+#ifndef TSPHEURISTIC_H
+#define TSPHEURISTIC_H
+
+#include <vector>
+#include <deque>
+
+#include "graph/distancematrix.h"
+
+using namespace std;
+
+class TSPHeuristic
+{
+public:
+    enum Construction { NEARESTNEIGHBOUR, GREEDY };
+    static const unsigned NUMBEROFNEIGHBOURS = 10;
+
+    // the distances are copied, an infinite distance is a missing edge
+    TSPHeuristic(const DistanceMatrix& distances);
+    /* constructs the first tour, returns false if the construction got stuck on missing edges. the greedy heuristic needs
+       symmetric distances, the nearest neighbour heuristic is used otherwise */
+    bool construct(Construction construction = GREEDY);
+    // does one move that makes the tour shorter, returns false if there is none (the tour is a local optimum)
+    bool improve();
+    // improves the tour until it's a local optimum or the time limit (in milliseconds, 0 is no limit) is reached, returns the number of moves
+    unsigned optimise(double milliseconds = 0);
+
+    // the nodes of the tour in order, the first node isn't repeated at the end
+    const vector<unsigned>& getTour() const {return _tour;}
+    double getCost() const {return _cost;}
+    // true if the distance from i to j is always the distance from j to i
+    bool isSymmetric() const {return _symmetric;}
+    // the edges (source, target in the direction of the tour) that the last move removed from and added to the tour
+    const vector<pair<unsigned, unsigned> >& getRemovedEdges() const {return _removedEdges;}
+    const vector<pair<unsigned, unsigned> >& getAddedEdges() const {return _addedEdges;}
+
+private:
+    double distance(unsigned source, unsigned target) const {return _distances.distance(source, target);}
+    unsigned next(unsigned node) const {return _tour[_positions[node] + 1 == _tour.size() ? 0 : _positions[node] + 1];}
+    unsigned previous(unsigned node) const {return _tour[_positions[node] == 0 ? _tour.size() - 1 : _positions[node] - 1];}
+
+    void computeNeighbours();
+    void computeNeighboursGrid();
+    // inserts neighbour in the sorted nearest nodes of node if it's one of the NUMBEROFNEIGHBOURS nearest
+    void addNeighbour(vector<pair<double, unsigned> >& nearest, unsigned node, unsigned neighbour) const;
+    bool constructNearestNeighbour();
+    bool constructGreedy();
+    // the nearest node that isn't visited (and for the greedy heuristic the end of a fragment), the neighbours first
+    unsigned nearestFree(unsigned node, const vector<bool>& visited, const vector<unsigned char>& degrees) const;
+    // sets the tour and the positions, returns false if an edge of the tour is missing
+    bool setTour(const vector<unsigned>& tour);
+
+    // the moves of improve() that start at node, they change the tour and return true if they found one
+    bool twoOpt(unsigned node);
+    bool orOpt(unsigned node);
+    // reverses the part of the tour from position first to position last, or the rest of the tour if that is shorter
+    void reverseTour(unsigned first, unsigned last);
+    // reverses length nodes of the tour from position first on, going round at the end
+    void reversePositions(unsigned first, unsigned length);
+    // the nodes of the removed and added edges are looked at again
+    void activate(unsigned node);
+    void activateEdges();
+
+    DistanceMatrix _distances;
+    bool _symmetric;
+    unsigned _numberOfNodes;
+    // the nearest neighbours of each node, the nearest first
+    vector<vector<unsigned> > _neighbours;
+    vector<unsigned> _tour;
+    // the position of each node in the tour
+    vector<unsigned> _positions;
+    double _cost;
+    // the nodes that still have to be looked at, a node without it's bit set is in the queue
+    deque<unsigned> _queue;
+    vector<bool> _dontLook;
+    vector<pair<unsigned, unsigned> > _removedEdges;
+    vector<pair<unsigned, unsigned> > _addedEdges;
+};
+
+#endif // TSPHEURISTIC_H
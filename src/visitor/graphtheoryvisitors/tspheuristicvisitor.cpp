@@ -0,0 +1,238 @@
+#include "tspheuristicvisitor.h"
+#include "graph/graphComp/node.h"
+#include "graph/graphComp/edge.h"
+#include "graph/graph.h"
+#include <vector>
+#include <list>
+#include <QElapsedTimer>
+#include "exception/invalidgraph.h"
+#include "graphdistances.h"
+
+TSPHeuristicVisitor::TSPHeuristicVisitor(TSPHeuristic::Construction construction, unsigned timeLimit) : AlgorithmVisitor()
+{
+    _construction = construction;
+    _timeLimit = timeLimit;
+    _heuristic = NULL;
+    _milliseconds = 0;
+    _routeEdges = false;
+    _finished = false;
+}
+
+TSPHeuristicVisitor::~TSPHeuristicVisitor()
+{
+    delete _heuristic;
+}
+
+bool TSPHeuristicVisitor::isFinished() const
+{
+    return _finished;
+}
+
+void TSPHeuristicVisitor::visit(Graph &graph)
+{
+    initialise(graph);
+    if (!_finished)
+    {
+        // the neighbours and the construction count for the time limit too, optimise(0) would be without limit
+        if (!_timeLimit || _milliseconds < _timeLimit)
+            _heuristic->optimise(_timeLimit ? _timeLimit - _milliseconds : 0);
+        finish();
+    }
+}
+
+void TSPHeuristicVisitor::iterationStep(Graph &graph)
+{
+    // new graph, the first step is the construction of the route
+    if (&graph != _graph || _finished)
+    {
+        initialise(graph);
+        if (!_finished)
+            colorRoute(RGB::colorOrange());
+        return;
+    }
+
+    if (_timeLimit && _milliseconds >= _timeLimit)
+    {
+        finish();
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    bool improved = _heuristic->improve();
+    _milliseconds += timer.nsecsElapsed() / 1000000.0;
+    if (!improved)
+    {
+        finish();
+        return;
+    }
+
+    // show the move: the removed edges get their color back, the added edges and their nodes become orange
+    const vector<Node*>& nodes = graph.getNodes();
+    const vector<pair<unsigned, unsigned> >& removed = _heuristic->getRemovedEdges();
+    for (unsigned i = 0; i < removed.size(); ++i)
+    {
+        if (_routeEdges)
+            removeRouteEdge(removed[i].first, removed[i].second);
+        else
+            restoreEdge(removed[i].first, removed[i].second);
+    }
+    const vector<pair<unsigned, unsigned> >& added = _heuristic->getAddedEdges();
+    for (unsigned i = 0; i < added.size(); ++i)
+    {
+        if (_routeEdges)
+            addRouteEdge(added[i].first, added[i].second);
+        colorEdge(added[i].first, added[i].second, RGB::colorOrange());
+        nodes[added[i].first]->setColor(RGB::colorOrange());
+        nodes[added[i].second]->setColor(RGB::colorOrange());
+    }
+}
+
+void TSPHeuristicVisitor::initialise(Graph& graph)
+{
+    QElapsedTimer timer;
+    timer.start();
+    // the edges of the route on the graph before are removed, this graph could have them too
+    cleanUp();
+    _graph = &graph;
+    delete _heuristic;
+    _heuristic = NULL;
+    _milliseconds = 0;
+    _edgeColors.clear();
+    _finished = false;
+
+    // input graph has no nodes
+    const vector<Node*>& nodes = graph.getNodes();
+    if (nodes.empty())
+    {
+        _finished = true;
+        return;
+    }
+    // a graph without edges (like a large TSPLIB instance) gets the edges of the route, otherwise the route can't be seen
+    _routeEdges = graph.getNumberOfEdges() == 0;
+
+    DistanceMatrix distances;
+    if (graph.getNumberOfEdges() == 0 && !graph.getDistances())
+    {
+        // a drawn graph without edges, the distances are computed from the positions of the nodes when they are needed
+        vector<double> x(nodes.size());
+        vector<double> y(nodes.size());
+        for (unsigned i = 0; i < nodes.size(); ++i)
+        {
+            x[i] = nodes[i]->getCoords().getX();
+            y[i] = nodes[i]->getCoords().getY();
+        }
+        distances.setCoordinates(DistanceMatrix::EUC_2D, x, y);
+    }
+    else if (!GraphDistances::compute(graph, distances))
+    {
+        _finished = true;
+        throw (InvalidGraph("Graph is not weighted",2));
+    }
+
+    _heuristic = new TSPHeuristic(distances);
+    if (!_heuristic->construct(_construction))
+    {
+        _finished = true;
+        throw InvalidGraph("The heuristic did not find a route through all the nodes", 1);
+    }
+    _milliseconds = timer.nsecsElapsed() / 1000000.0;
+}
+
+void TSPHeuristicVisitor::finish()
+{
+    // the edges that were part of the route at some time get their color back, the final route becomes green
+    for (map<Edge*, RGB>::iterator it = _edgeColors.begin(); it != _edgeColors.end(); ++it)
+        it->first->setColor(it->second);
+    const vector<Node*>& nodes = _graph->getNodes();
+    const vector<unsigned>& tour = _heuristic->getTour();
+    for (unsigned i = 0; i < tour.size(); ++i)
+        nodes[tour[i]]->setColor(RGB::colorGreen());
+    colorRoute(RGB::colorGreen());
+    _finished = true;
+}
+
+void TSPHeuristicVisitor::cleanUp()
+{
+    // the user can have removed some of the edges (or their nodes) in the mean time, those are skipped
+    for (unsigned i = 0; i < _routeEdgeIDs.size(); ++i)
+    {
+        Node* source = _graph->idToNode(_routeEdgeIDs[i].first);
+        Node* target = _graph->idToNode(_routeEdgeIDs[i].second);
+        if (source && target && _graph->edgeExists(source, target, Label()))
+            _graph->removeEdge(source, target, Label());
+    }
+    _routeEdgeIDs.clear();
+    _edgeColors.clear();
+}
+
+void TSPHeuristicVisitor::colorRoute(const RGB& color)
+{
+    const vector<unsigned>& tour = _heuristic->getTour();
+    // a single node has no route to show
+    for (unsigned i = 0; i < tour.size() && tour.size() > 1; ++i)
+    {
+        unsigned next = tour[(i+1) % tour.size()];
+        // visit() doesn't add the edges while the route changes, only the final route gets them
+        if (_routeEdges && getEdges(tour[i], next).empty())
+            addRouteEdge(tour[i], next);
+        colorEdge(tour[i], next, color);
+    }
+}
+
+void TSPHeuristicVisitor::addRouteEdge(unsigned source, unsigned target)
+{
+    const vector<Node*>& nodes = _graph->getNodes();
+    _graph->addEdge(Edge(nodes[source], nodes[target]));
+    _routeEdgeIDs.push_back(make_pair(nodes[source]->getID(), nodes[target]->getID()));
+}
+
+void TSPHeuristicVisitor::removeRouteEdge(unsigned source, unsigned target)
+{
+    // the route can go through the edge the other way if it was reversed
+    vector<Edge*> edges = getEdges(source, target);
+    for (unsigned i = 0; i < edges.size(); ++i)
+    {
+        _edgeColors.erase(edges[i]);
+        _graph->removeEdge(edges[i]->getSource(), edges[i]->getTarget(), Label());
+    }
+}
+
+void TSPHeuristicVisitor::colorEdge(unsigned source, unsigned target, const RGB& color)
+{
+    vector<Edge*> edges = getEdges(source, target);
+    for (unsigned i = 0; i < edges.size(); ++i)
+    {
+        /* the route edges are removed again, their color doesn't have to come back. adding them can also move the
+           edges of a hybrid graph to another state, a pointer kept here would then point to a deleted edge */
+        if (!_routeEdges && _edgeColors.find(edges[i]) == _edgeColors.end())
+            _edgeColors[edges[i]] = edges[i]->getColor();
+        edges[i]->setColor(color);
+    }
+}
+
+void TSPHeuristicVisitor::restoreEdge(unsigned source, unsigned target)
+{
+    vector<Edge*> edges = getEdges(source, target);
+    for (unsigned i = 0; i < edges.size(); ++i)
+    {
+        map<Edge*, RGB>::iterator it = _edgeColors.find(edges[i]);
+        if (it != _edgeColors.end())
+            edges[i]->setColor(it->second);
+    }
+}
+
+vector<Edge*> TSPHeuristicVisitor::getEdges(unsigned source, unsigned target) const
+{
+    vector<Edge*> result;
+    const vector<Node*>& nodes = _graph->getNodes();
+    for (unsigned direction = 0; direction < (_heuristic->isSymmetric() ? 2u : 1u); ++direction)
+    {
+        Node* from = nodes[direction == 0 ? source : target];
+        Node* to = nodes[direction == 0 ? target : source];
+        list<Edge*> edges = _graph->getOutgoingEdges(from);
+        for (list<Edge*>::iterator it = edges.begin(); it != edges.end(); ++it)
+            if ((*it)->getTarget() == to)
+                result.push_back(*it);
+    }
+    return result;
+}
@@ -0,0 +1,80 @@
+/*
+  Author: Balazs Nemeth
+  Description: Visitor that finds a short route through all the nodes of a graph fast with a TSPHeuristic, for graphs that
+  are too large for the exact TSPVisitor. The distances come from GraphDistances: the costs in the labels of the edges, or
+  for a graph without edges the distances it was read with (large TSPLIB instances). A drawn graph without edges and
+  without distances is seen as a complete graph with the euclidean distances between the positions of the nodes. The
+  first iterationStep() constructs a route and colors it orange, each next step does one improving move: the removed edges
+  get their color back, the added edges and their nodes become orange. When no move is left or the time limit is used up,
+  the route is colored green. The time limit includes the distances, the neighbour lists and the construction. A graph
+  without edges gets the edges of the route (the moves add and remove them) so the route can be seen, cleanUp() removes
+  them again: at the next run or when the graph is closed.
+  */
+
+#ifndef TSPHEURISTICVISITOR_H
+#define TSPHEURISTICVISITOR_H
+
+#include "visitor/algorithmvisitor.h"
+#include <vector>
+#include <map>
+#include "graph/graphComp/rgb.h"
+#include "graph/graph.h"
+#include "tspheuristic.h"
+
+class Node;
+class Edge;
+
+class TSPHeuristicVisitor : public AlgorithmVisitor
+{
+public:
+    // the default time limit of the improvements in milliseconds
+    static const unsigned DEFAULTTIMELIMIT = 10000;
+
+    TSPHeuristicVisitor(TSPHeuristic::Construction construction = TSPHeuristic::GREEDY, unsigned timeLimit = DEFAULTTIMELIMIT);
+    ~TSPHeuristicVisitor();
+    // computes the route without animating the moves
+    void visit(Graph& graph);
+    // do one iteration of the algorithm -- construct the route or do one improving move
+    void iterationStep(Graph& graph);
+    string getName() const { return "Traveling Salesman Heuristic"; }
+    AlgorithmVisitor* clone() const {return new TSPHeuristicVisitor(_construction, _timeLimit);}
+    bool isFinished() const;
+    // the construction and the time limit (in milliseconds, 0 is no limit) of the next graph that is visited
+    void setConstruction(TSPHeuristic::Construction construction) {_construction = construction;}
+    void setTimeLimit(unsigned timeLimit) {_timeLimit = timeLimit;}
+    // removes the edges that were added to show the route
+    void cleanUp();
+    // the route can get edges of it's own, the graph isn't frozen for this visitor
+    bool freezesGraph() const {return false;}
+
+private:
+    // init function, constructs the route and throws InvalidGraph if the graph isn't weighted or there is no route
+    void initialise(Graph& graph);
+    // colors the route green
+    void finish();
+    // colors the edges of the route, a graph without edges gets them first
+    void colorRoute(const RGB& color);
+    // add or remove an edge of the route of a graph without edges
+    void addRouteEdge(unsigned source, unsigned target);
+    void removeRouteEdge(unsigned source, unsigned target);
+    // colors the edge (both directions if the distances are symmetric), the first color of each edge is remembered
+    void colorEdge(unsigned source, unsigned target, const RGB& color);
+    // gives the edge it's first color back
+    void restoreEdge(unsigned source, unsigned target);
+    // the edges from source to target, and the other way if the distances are symmetric
+    vector<Edge*> getEdges(unsigned source, unsigned target) const;
+
+    TSPHeuristic::Construction _construction;
+    unsigned _timeLimit;
+    TSPHeuristic* _heuristic;
+    // the time the construction and the improvements took so far in milliseconds
+    double _milliseconds;
+    // the colors of the edges before they were colored
+    map<Edge*, RGB> _edgeColors;
+    // true if the route is shown with edges that are added for it
+    bool _routeEdges;
+    // the IDs of the source and target of the added edges, the nodes could be gone when they are removed
+    vector<pair<unsigned long, unsigned long> > _routeEdgeIDs;
+};
+
+#endif // TSPHEURISTICVISITOR_H
@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <assert.h>
+
+#include "tspsolver.h"
+
+TSPSolver::TSPSolver(const DistanceMatrix& distances) : _numberOfNodes(distances.getNumberOfNodes()), _cost(DistanceMatrix::infinity()),
+    _optimal(true), _timeLimit(0)
+{
+    assert(_numberOfNodes <= MAXIMUMNODES);
+    // the coordinate metrics compute each distance when it's asked, the search asks them many times
+    _distances.resize(size_t(_numberOfNodes) * _numberOfNodes);
+    for (unsigned i = 0; i < _numberOfNodes; ++i)
+        for (unsigned j = 0; j < _numberOfNodes; ++j)
+            _distances[size_t(i) * _numberOfNodes + j] = i == j ? DistanceMatrix::infinity() : distances.distance(i, j);
+    _symmetric = true;
+    for (unsigned i = 0; i < _numberOfNodes && _symmetric; ++i)
+        for (unsigned j = 0; j < i && _symmetric; ++j)
+            _symmetric = distance(i, j) == distance(j, i);
+}
+
+bool TSPSolver::solve(Method method, double milliseconds)
+{
+    _tour.clear();
+    _cost = DistanceMatrix::infinity();
+    _optimal = true;
+    _timeLimit = milliseconds;
+    _timer.start();
+    if (_numberOfNodes == 0)
+        return false;
+    if (_numberOfNodes == 1)
+    {
+        _tour.push_back(0);
+        _cost = 0;
+        return true;
+    }
+    // the dynamic programming of a larger graph doesn't fit in memory
+    if (method == AUTOMATIC || _numberOfNodes > MAXIMUMDYNAMICPROGRAMMINGNODES)
+        method = _numberOfNodes <= MAXIMUMDYNAMICPROGRAMMINGNODES ? DYNAMICPROGRAMMING : BRANCHANDBOUND;
+    return method == DYNAMICPROGRAMMING ? solveDynamicProgramming() : solveBranchAndBound();
+}
+
+bool TSPSolver::timeUsedUp()
+{
+    if (_optimal && _timeLimit > 0 && _timer.nsecsElapsed() / 1000000.0 >= _timeLimit)
+        _optimal = false;
+    return !_optimal;
+}
+
+bool TSPSolver::solveDynamicProgramming()
+{
+    /* the tour starts in node 0, the sets are the other nodes as bitmasks (bit j is node j + 1). lengths[set * m + j] is the
+       length of the shortest path from node 0 through exactly the nodes of set that ends in node j + 1 */
+    const unsigned m = _numberOfNodes - 1;
+    const size_t all = (size_t(1) << m) - 1;
+    const float infinity = DistanceMatrix::infinity();
+    vector<float> lengths((all + 1) * m, infinity);
+    for (unsigned j = 0; j < m; ++j)
+        lengths[(size_t(1) << j) * m + j] = distance(0, j + 1);
+    // each path is extended with each node that isn't in it's set yet, the sets only grow so they are handled in order
+    for (size_t set = 1; set < all; ++set)
+        for (unsigned j = 0; j < m; ++j)
+        {
+            float length = lengths[set * m + j];
+            if (!(set & (size_t(1) << j)) || length == infinity)
+                continue;
+            for (unsigned k = 0; k < m; ++k)
+            {
+                if (set & (size_t(1) << k))
+                    continue;
+                float extended = length + distance(j + 1, k + 1);
+                float& next = lengths[(set | (size_t(1) << k)) * m + k];
+                if (extended < next)
+                    next = extended;
+            }
+        }
+
+    // the path through all the nodes that is the shortest with the edge back to node 0
+    unsigned last = 0;
+    float best = infinity;
+    for (unsigned j = 0; j < m; ++j)
+    {
+        float length = lengths[all * m + j] + distance(j + 1, 0);
+        if (length < best)
+        {
+            best = length;
+            last = j;
+        }
+    }
+    if (best == infinity)
+        return false;
+    _cost = best;
+
+    // walk back from the last node, each time to a node whose path gives exactly the length of the current one
+    size_t set = all;
+    _tour.push_back(last + 1);
+    while (set & (set - 1))
+    {
+        float length = lengths[set * m + last];
+        set &= ~(size_t(1) << last);
+        unsigned previous = 0;
+        while (!(set & (size_t(1) << previous)) || lengths[set * m + previous] + distance(previous + 1, last + 1) != length)
+        {
+            ++previous;
+            assert(previous < m);
+        }
+        last = previous;
+        _tour.push_back(last + 1);
+    }
+    _tour.push_back(0);
+    reverse(_tour.begin(), _tour.end());
+    return true;
+}
+
+bool TSPSolver::solveBranchAndBound()
+{
+    _penalties.assign(_numberOfNodes, 0);
+    nearestNeighbourTour();
+    improveTour();
+    computePenalties();
+
+    _visited.assign(_numberOfNodes, false);
+    _visited[0] = true;
+    _path.clear();
+    _path.push_back(0);
+    branch(0, 0);
+    return !_tour.empty();
+}
+
+void TSPSolver::nearestNeighbourTour()
+{
+    vector<bool> visited(_numberOfNodes, false);
+    vector<unsigned> tour(1, 0);
+    visited[0] = true;
+    double cost = 0;
+    for (unsigned step = 1; step < _numberOfNodes; ++step)
+    {
+        unsigned last = tour.back();
+        unsigned nearest = _numberOfNodes;
+        for (unsigned v = 0; v < _numberOfNodes; ++v)
+            if (!visited[v] && distance(last, v) != DistanceMatrix::infinity() && (nearest == _numberOfNodes || distance(last, v) < distance(last, nearest)))
+                nearest = v;
+        // stuck, the missing edges don't allow to go on
+        if (nearest == _numberOfNodes)
+            return;
+        visited[nearest] = true;
+        tour.push_back(nearest);
+        cost += distance(last, nearest);
+    }
+    if (distance(tour.back(), 0) == DistanceMatrix::infinity())
+        return;
+    _tour = tour;
+    _cost = cost + distance(tour.back(), 0);
+}
+
+void TSPSolver::improveTour()
+{
+    if (_tour.empty())
+        return;
+    /* 2-opt: the part of the tour from i to j is reversed if that makes the tour shorter. the distances don't have to be
+       symmetric, so the reversed part is summed in both directions while j moves on */
+    bool improved = true;
+    while (improved && !timeUsedUp())
+    {
+        improved = false;
+        for (unsigned i = 1; i + 1 < _numberOfNodes; ++i)
+        {
+            double forward = 0;
+            double backward = 0;
+            for (unsigned j = i + 1; j < _numberOfNodes; ++j)
+            {
+                forward += distance(_tour[j-1], _tour[j]);
+                backward += distance(_tour[j], _tour[j-1]);
+                unsigned before = _tour[i-1];
+                unsigned after = _tour[(j + 1) % _numberOfNodes];
+                double oldLength = distance(before, _tour[i]) + forward + distance(_tour[j], after);
+                double newLength = distance(before, _tour[j]) + backward + distance(_tour[i], after);
+                if (newLength < oldLength - 1e-9)
+                {
+                    reverse(_tour.begin() + i, _tour.begin() + j + 1);
+                    _cost -= oldLength - newLength;
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void TSPSolver::computePenalties()
+{
+    // without a tour there is no target for the step size, the bound works without penalties too
+    if (_tour.empty() || _numberOfNodes < 3)
+        return;
+    vector<unsigned> degrees;
+    vector<double> best(_penalties);
+    double bestBound = -DistanceMatrix::infinity();
+    double step = 2;
+    // the penalties move each node to degree 2: a node with more edges in the 1-tree gets more expensive, a leaf cheaper
+    for (unsigned iteration = 0; iteration < 100 + 10 * _numberOfNodes && step > 1e-6 && !timeUsedUp(); ++iteration)
+    {
+        double penaltySum = 0;
+        for (unsigned i = 0; i < _numberOfNodes; ++i)
+            penaltySum += _penalties[i];
+        double bound = oneTree(degrees) - 2 * penaltySum;
+        // there is no 1-tree, so there is no tour either
+        if (bound == DistanceMatrix::infinity())
+            break;
+        if (bound > bestBound)
+        {
+            bestBound = bound;
+            best = _penalties;
+        }
+        else
+            step *= 0.95;
+        double norm = 0;
+        for (unsigned i = 0; i < _numberOfNodes; ++i)
+            norm += (int(degrees[i]) - 2) * (int(degrees[i]) - 2);
+        // the 1-tree is a tour, the bound can't get better
+        if (norm == 0 || bound >= _cost)
+            break;
+        double length = step * (_cost - bound) / norm;
+        for (unsigned i = 0; i < _numberOfNodes; ++i)
+            _penalties[i] += length * (int(degrees[i]) - 2);
+    }
+    _penalties = best;
+}
+
+double TSPSolver::oneTree(vector<unsigned>& degrees)
+{
+    // Prim's algorithm on the nodes except node 0, with the distances of the nodes to the tree
+    degrees.assign(_numberOfNodes, 0);
+    vector<double> distances(_numberOfNodes, DistanceMatrix::infinity());
+    vector<unsigned> parents(_numberOfNodes, 0);
+    vector<bool> inTree(_numberOfNodes, false);
+    double cost = 0;
+    unsigned node = 1;
+    inTree[1] = true;
+    for (unsigned added = 2; added < _numberOfNodes; ++added)
+    {
+        unsigned nearest = 0;
+        for (unsigned v = 2; v < _numberOfNodes; ++v)
+        {
+            if (inTree[v])
+                continue;
+            double d = penalisedDistance(node, v);
+            if (d < distances[v])
+            {
+                distances[v] = d;
+                parents[v] = node;
+            }
+            if (nearest == 0 || distances[v] < distances[nearest])
+                nearest = v;
+        }
+        if (distances[nearest] == DistanceMatrix::infinity())
+            return DistanceMatrix::infinity();
+        cost += distances[nearest];
+        ++degrees[nearest];
+        ++degrees[parents[nearest]];
+        inTree[nearest] = true;
+        node = nearest;
+    }
+    // node 0 is connected with it's two cheapest edges
+    unsigned first = 1;
+    unsigned second = 2;
+    if (penalisedDistance(0, second) < penalisedDistance(0, first))
+        swap(first, second);
+    for (unsigned v = 3; v < _numberOfNodes; ++v)
+    {
+        double d = penalisedDistance(0, v);
+        if (d < penalisedDistance(0, first))
+        {
+            second = first;
+            first = v;
+        }
+        else if (d < penalisedDistance(0, second))
+            second = v;
+    }
+    degrees[0] = 2;
+    ++degrees[first];
+    ++degrees[second];
+    return cost + penalisedDistance(0, first) + penalisedDistance(0, second);
+}
+
+void TSPSolver::branch(unsigned last, double cost)
+{
+    // out of time, the best tour so far is the result
+    if (timeUsedUp())
+        return;
+    if (_path.size() == _numberOfNodes)
+    {
+        double total = cost + distance(last, 0);
+        if (total < _cost)
+        {
+            _cost = total;
+            _tour = _path;
+        }
+        return;
+    }
+    // each free node with the lower bound of the tours that go there next, the ones with the lowest bound are tried first
+    vector<pair<double, unsigned> > children;
+    for (unsigned v = 0; v < _numberOfNodes; ++v)
+        if (!_visited[v] && distance(last, v) != DistanceMatrix::infinity())
+        {
+            _visited[v] = true;
+            double bound = _path.size() + 1 == _numberOfNodes ? distance(v, 0) : completionBound(v);
+            bound += cost + distance(last, v);
+            _visited[v] = false;
+            if (bound < _cost)
+                children.push_back(make_pair(bound, v));
+        }
+    sort(children.begin(), children.end());
+    // a shorter tour can be found in the branch of a child, the bounds that aren't better anymore are cut
+    for (unsigned i = 0; i < children.size() && children[i].first < _cost; ++i)
+    {
+        unsigned child = children[i].second;
+        _visited[child] = true;
+        _path.push_back(child);
+        branch(child, cost + distance(last, child));
+        _path.pop_back();
+        _visited[child] = false;
+    }
+}
+
+double TSPSolver::completionBound(unsigned last)
+{
+    /* the rest of the tour is an edge from last to a free node, a path through all the free nodes and an edge back to node 0.
+       with the penalties each edge costs the penalties of it's nodes more, which adds the penalties of last and node 0 once
+       and those of the free nodes twice to the rest of the tour */
+    _free.clear();
+    double penalties = _penalties[last] + _penalties[0];
+    double in = DistanceMatrix::infinity();
+    double out = DistanceMatrix::infinity();
+    for (unsigned v = 0; v < _numberOfNodes; ++v)
+    {
+        if (_visited[v])
+            continue;
+        _free.push_back(v);
+        penalties += 2 * _penalties[v];
+        in = min(in, distance(last, v) + _penalties[last] + _penalties[v]);
+        out = min(out, distance(v, 0) + _penalties[v] + _penalties[0]);
+    }
+
+    /* the rest of the tour leaves last and each free node once and enters each free node and node 0 once. the cheapest way
+       out of each of them is a bound, the ways in that are left after subtracting those add to it (row and column reduction) */
+    double directed = 0;
+    if (!_symmetric)
+    {
+        const unsigned size = _free.size() + 1;
+        _cheapestOut.resize(size);
+        for (unsigned i = 0; i < size; ++i)
+        {
+            unsigned source = i == _free.size() ? last : _free[i];
+            double cheapest = distance(source, 0);
+            for (unsigned j = 0; j < _free.size(); ++j)
+                cheapest = min(cheapest, double(distance(source, _free[j])));
+            _cheapestOut[i] = cheapest;
+            directed += cheapest;
+        }
+        for (unsigned j = 0; j < size && directed != DistanceMatrix::infinity(); ++j)
+        {
+            unsigned target = j == _free.size() ? 0 : _free[j];
+            double cheapest = DistanceMatrix::infinity();
+            for (unsigned i = 0; i < size; ++i)
+            {
+                unsigned source = i == _free.size() ? last : _free[i];
+                if (source != target)
+                    cheapest = min(cheapest, distance(source, target) - _cheapestOut[i]);
+            }
+            directed += cheapest;
+        }
+    }
+
+    // the path through the free nodes is a spanning tree of them, Prim's algorithm gives the minimal one
+    double tree = 0;
+    _treeDistances.assign(_free.size(), DistanceMatrix::infinity());
+    unsigned node = _free.back();
+    _free.pop_back();
+    _treeDistances.pop_back();
+    while (!_free.empty())
+    {
+        unsigned nearest = 0;
+        for (unsigned i = 0; i < _free.size(); ++i)
+        {
+            _treeDistances[i] = min(_treeDistances[i], penalisedDistance(node, _free[i]));
+            if (_treeDistances[i] < _treeDistances[nearest])
+                nearest = i;
+        }
+        tree += _treeDistances[nearest];
+        node = _free[nearest];
+        _free[nearest] = _free.back();
+        _free.pop_back();
+        _treeDistances[nearest] = _treeDistances.back();
+        _treeDistances.pop_back();
+    }
+    return max(in + tree + out - penalties, directed);
+}
@@ -0,0 +1,103 @@
+/*
+ Author: Balazs Nemeth
+ Description: TSPSolver finds a shortest tour through all the nodes of a DistanceMatrix (the matrix doesn't have to be
+              symmetric, an infinite distance is a missing edge), it's the engine of TSPVisitor. The distances are copied
+              once into a flat matrix of floats. There are two exact methods:
+              - DYNAMICPROGRAMMING (Held-Karp): the shortest path from node 0 through each set of nodes ending in each node,
+                O(2^n * n^2) time and 2^(n-1) * (n-1) floats of memory, so only for small graphs.
+              - BRANCHANDBOUND: a depth first search over the tours that start in node 0, starting with the nearest
+                neighbour tour improved with 2-opt as upper bound. Each next node gets a lower bound for the tours that go
+                there, the nodes are tried from the lowest bound and cut when it isn't better than the best tour. The bound
+                for the rest of the tour is a minimal spanning tree of the free nodes plus the cheapest edges that connect
+                it to the end of the path and back to node 0, the tree uses the cheapest direction of each edge and the
+                node penalties of the Held-Karp 1-tree bound, which are computed once with subgradient optimization. If
+                the distances aren't symmetric, the row and column reduction of the free part of the matrix is used when
+                it's higher. This is exponential in the worst case: euclidean instances of about 50 nodes take
+                milliseconds to seconds, asymmetric ones get slow from about 30 nodes.
+              AUTOMATIC uses dynamic programming up to MAXIMUMDYNAMICPROGRAMMINGNODES nodes and branch and bound otherwise.
+              Branch and bound stops when it's time limit is used up, the best tour found so far is kept (isOptimal() tells
+              whether it's the shortest). The flat matrix takes n^2 floats, so the solver only takes up to MAXIMUMNODES
+              nodes, TSPHeuristic is for larger graphs.
+     */
+
+#ifndef TSPSOLVER_H
+#define TSPSOLVER_H
+
+#include <vector>
+#include <QElapsedTimer>
+
+#include "graph/distancematrix.h"
+
+using namespace std;
+
+class TSPSolver
+{
+public:
+    enum Method { AUTOMATIC, DYNAMICPROGRAMMING, BRANCHANDBOUND };
+    // the dynamic programming takes 2^(n-1) * (n-1) floats, 40MB for 20 nodes
+    static const unsigned MAXIMUMDYNAMICPROGRAMMINGNODES = 20;
+    // the matrix of 1000 nodes takes 4MB, branch and bound doesn't get near the shortest tour of a larger graph anyway
+    static const unsigned MAXIMUMNODES = 1000;
+    // the default time limit of branch and bound in milliseconds
+    static const unsigned DEFAULTTIMELIMIT = 10000;
+
+    // the matrix can't have more than MAXIMUMNODES nodes
+    TSPSolver(const DistanceMatrix& distances);
+    /* returns true if there is a tour (there is no tour if the missing edges don't allow a Hamiltonian cycle, or if branch
+       and bound didn't find one within the time limit). the time limit is in milliseconds, 0 is no limit */
+    bool solve(Method method = AUTOMATIC, double milliseconds = DEFAULTTIMELIMIT);
+    // false if branch and bound was stopped by the time limit, the tour is the best one found until then
+    bool isOptimal() const {return _optimal;}
+    // the nodes of the shortest tour in order starting with node 0, the first node isn't repeated at the end
+    const vector<unsigned>& getTour() const {return _tour;}
+    // the length of the shortest tour, infinity if there is none
+    double getCost() const {return _cost;}
+
+private:
+    float distance(unsigned source, unsigned target) const {return _distances[size_t(source) * _numberOfNodes + target];}
+    // the cheapest direction of an edge with the penalties of both nodes added
+    double penalisedDistance(unsigned node1, unsigned node2) const
+    {
+        return min(distance(node1, node2), distance(node2, node1)) + _penalties[node1] + _penalties[node2];
+    }
+
+    // true if the time limit is used up, the search stops then and the tour isn't optimal anymore
+    bool timeUsedUp();
+
+    bool solveDynamicProgramming();
+    bool solveBranchAndBound();
+    // sets the tour to the nearest neighbour tour from node 0 if it doesn't get stuck
+    void nearestNeighbourTour();
+    // makes the tour shorter with 2-opt moves until there is none left, a short first tour cuts more paths
+    void improveTour();
+    // subgradient optimization of the penalties of the 1-tree bound
+    void computePenalties();
+    // the cost of the minimal 1-tree with the penalised distances, the degrees of the nodes in the tree are returned
+    double oneTree(vector<unsigned>& degrees);
+    // extends the path that ends in last and costs cost with each free node, the best tour is kept
+    void branch(unsigned last, double cost);
+    // a lower bound for the cost of the rest of the tour from last through the free nodes back to node 0
+    double completionBound(unsigned last);
+
+    unsigned _numberOfNodes;
+    // the distances row by row
+    vector<float> _distances;
+    // true if the distance from i to j is always the distance from j to i
+    bool _symmetric;
+    vector<unsigned> _tour;
+    double _cost;
+    bool _optimal;
+    QElapsedTimer _timer;
+    double _timeLimit;
+
+    // the state of the branch and bound
+    vector<double> _penalties;
+    vector<unsigned> _path;
+    vector<bool> _visited;
+    // the free nodes, the distances to the spanning tree and the row minima of completionBound()
+    vector<unsigned> _free;
+    vector<double> _treeDistances;
+    vector<double> _cheapestOut;
+};
+
+#endif // TSPSOLVER_H
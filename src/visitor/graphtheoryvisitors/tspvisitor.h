@@ -1,6 +1,13 @@
 /*
   Author: Jeroen Vaelen
   Description: Visitor that finds the shortest possible route in a graph that visits every node exactly once (Traveling Salesman Problem)
+  The costs of the edges are read from their labels once into a DistanceMatrix by GraphDistances (the cheapest edge if there
+  are more between two nodes, the distances the graph was read with if it has no edges) and the route is computed by a
+  TSPSolver: Held-Karp dynamic programming for small graphs, branch and bound for larger ones (see setMethod()). Branch
+  and bound stops at the time limit with the best route so far, a graph with more than TSPSolver::MAXIMUMNODES nodes is
+  refused (TSPHeuristicVisitor is for those). The
+  animation then walks along the route: each iterationStep() colors the next node and edge orange, the last step colors
+  the whole route green.
   */
 
 #ifndef TSPVISITOR_H
@@ -10,6 +17,8 @@
 #include <vector>
 #include <list>
 #include "graph/graphComp/rgb.h"
+#include "graph/graph.h"
+#include "tspsolver.h"
 
 class Node;
 class Edge;
@@ -17,48 +26,31 @@ class Edge;
 class TSPVisitor : public AlgorithmVisitor
 {
 public:
-    TSPVisitor();
+    TSPVisitor(TSPSolver::Method method = TSPSolver::AUTOMATIC, unsigned timeLimit = TSPSolver::DEFAULTTIMELIMIT);
     ~TSPVisitor();
     void visit(Graph& graph);
-    // do one iteration of the algorithm -- check if one path is hamiltonian
+    // do one iteration of the algorithm -- color the next node of the route
     void iterationStep(Graph& graph);
     string getName() const { return "Traveling Salesman Problem"; }
+    AlgorithmVisitor* clone() const {return new TSPVisitor(_method, _timeLimit);}
     bool isFinished() const;
+    // the method of the solver, the next graph that is visited uses it
+    void setMethod(TSPSolver::Method method) {_method = method;}
+    // the time limit of branch and bound in milliseconds (0 is no limit), the next graph that is visited uses it
+    void setTimeLimit(unsigned timeLimit) {_timeLimit = timeLimit;}
 
 private:
-    // check whether there is an edge between source and target, edge is set to this edge if there is one, else NULL
+    // check whether there is an edge between source and target, edge is set to the cheapest one if there is one, else NULL
     // the reason we do not use Graph::edgeExists() is because the label does not matter now
     bool isEdge( Node* source, Node* target, Edge** edge);
-    // edges that have been colored in the proces of computing a cycle
-    vector<Edge*> _coloredEdges;
-    // bool to indicate that a cycle has been found
-    bool _done;
-    // init function
+    // init function, computes the route and throws InvalidGraph if the graph is too large, isn't weighted or there is no route
     void initialise(Graph& graph);
-    // current permutation, to make sure we don't get out of bounds
-    vector<Node*> _permutation;
-    // calculates next permutation and returns true if it's a hamiltonian cycle
-    bool permutateAndValidate();
-    // vector that holds the indices of the current permutation's nodes in the graph.nodes vector
-    vector<int> _positions;
-    // vector that holds the original node's colors, used if we reset the colors
-    vector<RGB> _nodeColors;
-    // vector that holds the original edge's colors, used if we reset the colors
-    vector<RGB> _edgeColors;
-    // checks if the permutation has doubles
-    bool doubles(vector<int>& perm);
-    // bool that checks if any drawing action has been done, if not we iterate again so it does not look like the application might be freezing
-    bool _drew;
-
-    // vector that holds the currently shortest route
-    vector<Edge*> _route;
-    // the sum of the route's  costs
-    int _lowestCost;
-    // checks if the graph is weighted
-    bool isWeighted(Graph &graph);
-    // returns the cost of a couple of edges
-    int cost(vector<Edge*> route) const;
-
-
+    // the method that is used to compute the route
+    TSPSolver::Method _method;
+    unsigned _timeLimit;
+    // the nodes of the route in order, the first node isn't repeated at the end
+    vector<Node*> _route;
+    // the node of the route that the next iteration colors
+    unsigned _next;
 };
 #endif // TSPVISITOR_H
@@ -24,6 +24,8 @@ public:
 
     virtual void visit(Graph& graph) = 0;
     virtual string getName() const = 0;
+    // returns a new visitor of the same type, used when the visitor has to run on several graphs at the same time (see GraphBatchReader)
+    virtual PropertyVisitor* clone() const = 0;
 
     // used by graph tool kit to delete a graph that is deleted by the user
     void removeFromOpenGraphs(Graph * graph);
@@ -16,6 +16,7 @@ public:
 
     void visit(Graph& graph);
     string getName() const { return "Complete"; }
+    PropertyVisitor* clone() const {return new CompleteVisitor();}
 
 private:
     bool *_table;
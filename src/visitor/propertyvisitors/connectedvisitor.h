@@ -20,6 +20,7 @@ public:
 
     void visit(Graph& graph);
     string getName() const { return "Connected"; }
+    PropertyVisitor* clone() const {return new ConnectedVisitor();}
 
 private:
     // returns all node's that form a path with n
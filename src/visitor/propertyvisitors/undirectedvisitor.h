@@ -15,6 +15,7 @@ public:
 
     void visit(Graph& graph);
     string getName() const { return "Undirected"; }
+    PropertyVisitor* clone() const {return new UndirectedVisitor();}
 
 };
 
@@ -15,6 +15,7 @@ public:
 
     void visit(Graph& graph);
     string getName() const { return "Weighted"; }
+    PropertyVisitor* clone() const {return new WeightedVisitor();}
 };
 
 #endif // WEIGHTEDVISITOR_H
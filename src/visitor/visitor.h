@@ -11,6 +11,7 @@
 class MatrixGraph;
 class ListGraph;
 class HybridGraph;
+class CSRGraph;
 class Graph;
 
 using namespace std;
@@ -20,10 +21,15 @@ class Visitor
 public:
     // default constructor suffices
     Visitor();
+    // virtual because the visitors are deleted through pointers to their base classes (see VisitorBatchHandler)
+    virtual ~Visitor() {}
 
-    // the three possible graphstructures that can be visited by a visitor
+    // all the graphstructures that can be visited by a visitor
     virtual void visit(Graph& graph) = 0;
     virtual string getName() const = 0;
+    /* true if a hybrid graph should be frozen before the visitor runs (see HybridGraph::accept), the visitor can't change
+       the structure of the graph then and should do enough work to pay for the copy */
+    virtual bool freezesGraph() const {return false;}
 };
 
 #endif // VISITOR_H
@@ -0,0 +1,45 @@
+#include "visitorbatchhandler.h"
+
+PropertyBatchHandler::PropertyBatchHandler(const PropertyVisitor& visitor) : _visitor(visitor.clone())
+{
+    for (unsigned i = 0; i < 3; ++i)
+        _numberOfGraphs[i] = 0;
+}
+
+void PropertyBatchHandler::handleGraph(Graph& graph, unsigned long /* index */)
+{
+    _visitor->setFocusGraph(&graph);
+    _visitor->visitFocusGraph();
+    ++_numberOfGraphs[_visitor->getPropertyResult() - PropertyVisitor::UNDEFINED];
+    // the graph is reused for the next line, the visitor can't keep the result
+    _visitor->removeFromOpenGraphs(&graph);
+}
+
+void PropertyBatchHandler::merge(const GraphBatchHandler& other)
+{
+    const PropertyBatchHandler& handler = static_cast<const PropertyBatchHandler&>(other);
+    for (unsigned i = 0; i < 3; ++i)
+        _numberOfGraphs[i] += handler._numberOfGraphs[i];
+}
+
+unsigned long PropertyBatchHandler::getNumberOfGraphs(PropertyVisitor::propertyResult result) const
+{
+    return _numberOfGraphs[result - PropertyVisitor::UNDEFINED];
+}
+
+AlgorithmBatchHandler::AlgorithmBatchHandler(const AlgorithmVisitor& visitor) : _visitor(visitor.clone()), _numberOfGraphs(0)
+{
+
+}
+
+void AlgorithmBatchHandler::handleGraph(Graph& graph, unsigned long /* index */)
+{
+    _visitor->setFinished(false);
+    _visitor->visit(graph);
+    ++_numberOfGraphs;
+}
+
+void AlgorithmBatchHandler::merge(const GraphBatchHandler& other)
+{
+    _numberOfGraphs += static_cast<const AlgorithmBatchHandler&>(other)._numberOfGraphs;
+}
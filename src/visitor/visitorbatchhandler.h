@@ -0,0 +1,53 @@
+/*
+ Author: Balazs Nemeth
+ Description: GraphBatchHandlers that run a visitor on each graph of a batch file (see GraphBatchReader). Each worker
+              thread gets a clone of the handler and so a clone of the visitor, the results are merged after the file
+              has been read.
+     */
+
+#ifndef VISITORBATCHHANDLER_H
+#define VISITORBATCHHANDLER_H
+
+#include "fileIO/graphbatchreader.h"
+#include "propertyvisitor.h"
+#include "algorithmvisitor.h"
+
+// counts the graphs for which the property is true, false or undefined
+class PropertyBatchHandler : public GraphBatchHandler
+{
+public:
+    // the visitor is cloned, so it can be a prototype
+    PropertyBatchHandler(const PropertyVisitor& visitor);
+    ~PropertyBatchHandler() {delete _visitor;}
+    GraphBatchHandler* clone() const {return new PropertyBatchHandler(*_visitor);}
+    void handleGraph(Graph& graph, unsigned long index);
+    void merge(const GraphBatchHandler& other);
+    unsigned long getNumberOfGraphs(PropertyVisitor::propertyResult result) const;
+private:
+    PropertyBatchHandler(const PropertyBatchHandler&);
+    PropertyBatchHandler& operator=(const PropertyBatchHandler&);
+
+    PropertyVisitor* _visitor;
+    // the number of graphs for each result, indexed by result - UNDEFINED
+    unsigned long _numberOfGraphs[3];
+};
+
+// runs the algorithm on each graph, the graphs aren't kept so this is only useful for algorithms that report their result
+class AlgorithmBatchHandler : public GraphBatchHandler
+{
+public:
+    AlgorithmBatchHandler(const AlgorithmVisitor& visitor);
+    ~AlgorithmBatchHandler() {delete _visitor;}
+    GraphBatchHandler* clone() const {return new AlgorithmBatchHandler(*_visitor);}
+    void handleGraph(Graph& graph, unsigned long index);
+    void merge(const GraphBatchHandler& other);
+    unsigned long getNumberOfGraphs() const {return _numberOfGraphs;}
+private:
+    AlgorithmBatchHandler(const AlgorithmBatchHandler&);
+    AlgorithmBatchHandler& operator=(const AlgorithmBatchHandler&);
+
+    AlgorithmVisitor* _visitor;
+    unsigned long _numberOfGraphs;
+};
+
+#endif // VISITORBATCHHANDLER_H